@@ -37,6 +37,7 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Support/Allocator.h"
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -148,6 +149,16 @@ class ASTContext : public RefCountedBase<ASTContext> {
                          std::pair<uint64_t, unsigned> > TypeInfoMap;
   mutable TypeInfoMap MemoizedTypeInfo;
 
+  /// \brief A cache of the canonical profiles of instantiation-dependent
+  /// expressions.
+  ///
+  /// These expressions are uniqued as part of dependent types and template
+  /// arguments, and are profiled again each time a FoldingSet lookup probes a
+  /// bucket that contains them. This is managed by Stmt::Profile.
+  mutable llvm::DenseMap<const Stmt *, llvm::FoldingSetNodeIDRef>
+    DependentExprProfiles;
+  friend class Stmt;
+
   /// \brief A cache mapping from CXXRecordDecls to key functions.
   llvm::DenseMap<const CXXRecordDecl*, LazyDeclPtr> KeyFunctions;
   
@@ -171,6 +182,18 @@ class ASTContext : public RefCountedBase<ASTContext> {
   llvm::DenseMap<const MaterializeTemporaryExpr*, APValue>
     MaterializedTemporaryValues;
 
+public:
+  /// \brief Identifies a call to a constexpr function by its callee and the
+  /// bits of its (integer) argument values.
+  typedef std::pair<const FunctionDecl *, SmallVector<uint64_t, 4> >
+    ConstexprCallKey;
+
+private:
+  /// \brief Results of constexpr function calls which were found to be core
+  /// constant expressions, shared between evaluations when
+  /// -fconstexpr-cache-size is non-zero.
+  std::map<ConstexprCallKey, APValue> ConstexprCallResults;
+
   /// \brief Representation of a "canonical" template template parameter that
   /// is used in canonical template names.
   class CanonicalTemplateTemplateParm : public llvm::FoldingSetNode {
@@ -452,12 +475,27 @@ public:
   ///
   /// 'NodeT' can be one of Decl, Stmt, Type, TypeLoc,
   /// NestedNameSpecifier or NestedNameSpecifierLoc.
+  ///
+  /// The returned array refers into the parent map, which is never modified
+  /// once built, and so remains valid for the lifetime of the ASTContext.
   template <typename NodeT>
-  ParentVector getParents(const NodeT &Node) {
+  ArrayRef<ast_type_traits::DynTypedNode> getParents(const NodeT &Node) {
     return getParents(ast_type_traits::DynTypedNode::create(Node));
   }
 
-  ParentVector getParents(const ast_type_traits::DynTypedNode &Node);
+  ArrayRef<ast_type_traits::DynTypedNode>
+  getParents(const ast_type_traits::DynTypedNode &Node);
+
+  /// \brief Compute ahead of time the state which is otherwise built lazily
+  /// on first use: the parent map, the layouts of all complete records and
+  /// the raw comments of an external AST source.
+  ///
+  /// Once this has been called on a fully-built AST, getParents,
+  /// getASTRecordLayout and getRawCommentForDeclNoCache no longer modify
+  /// the ASTContext, and so may be called from several threads at once.
+  /// Other queries, including name lookup into DeclContexts backed by an
+  /// external source, are still not safe for concurrent use.
+  void prepareForConcurrentReads();
 
   const clang::PrintingPolicy &getPrintingPolicy() const {
     return PrintingPolicy;
@@ -2200,6 +2238,15 @@ public:
   APValue *getMaterializedTemporaryValue(const MaterializeTemporaryExpr *E,
                                          bool MayCreate);
 
+  /// \brief Get the cached result of a constexpr function call, or null if
+  /// the call has not been cached.
+  const APValue *getConstexprCallResult(const ConstexprCallKey &Key);
+
+  /// \brief Cache the result of a constexpr function call, unless the cache
+  /// is disabled or already holds -fconstexpr-cache-size entries.
+  void setConstexprCallResult(const ConstexprCallKey &Key,
+                              const APValue &Result);
+
   //===--------------------------------------------------------------------===//
   //                    Statistics
   //===--------------------------------------------------------------------===//
@@ -2245,6 +2292,12 @@ public:
   /// \brief The number of implicitly-declared destructors for which 
   /// declarations were built.
   static unsigned NumImplicitDestructorsDeclared;
+
+  /// \brief The number of constexpr calls found in the call result cache.
+  unsigned NumConstexprCallCacheHits;
+
+  /// \brief The number of cacheable constexpr calls which were evaluated.
+  unsigned NumConstexprCallCacheMisses;
   
 private:
   ASTContext(const ASTContext &) LLVM_DELETED_FUNCTION;
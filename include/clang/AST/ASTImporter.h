@@ -38,6 +38,7 @@ namespace clang {
   class ASTImporter {
   public:
     typedef llvm::DenseSet<std::pair<Decl *, Decl *> > NonEquivalentDeclSet;
+    typedef llvm::DenseSet<std::pair<Decl *, Decl *> > EquivalentDeclSet;
     
   private:
     /// \brief The contexts we're importing to and from.
@@ -75,6 +76,10 @@ namespace clang {
     /// \brief Declaration (from, to) pairs that are known not to be equivalent
     /// (which we have already complained about).
     NonEquivalentDeclSet NonEquivalentDecls;
+
+    /// \brief Canonical declaration (from, to) pairs that are known to be
+    /// structurally equivalent, so that they need not be compared again.
+    EquivalentDeclSet EquivalentDecls;
     
   public:
     /// \brief Create a new AST importer.
@@ -259,6 +264,10 @@ namespace clang {
     /// \brief Return the set of declarations that we know are not equivalent.
     NonEquivalentDeclSet &getNonEquivalentDecls() { return NonEquivalentDecls; }
 
+    /// \brief Return the set of declarations that we know are structurally
+    /// equivalent.
+    EquivalentDeclSet &getEquivalentDecls() { return EquivalentDecls; }
+
     /// \brief Called for ObjCInterfaceDecl, ObjCProtocolDecl, and TagDecl.
     /// Mark the Decl as complete, filling it in as much as possible.
     ///
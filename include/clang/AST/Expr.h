@@ -893,8 +893,10 @@ class DeclRefExpr : public Expr {
   /// \brief The declaration that we are referencing.
   ValueDecl *D;
 
+#ifndef CLANG_DECLREFEXPR_LOC_IN_STMT_BITS
   /// \brief The location of the declaration name itself.
   SourceLocation Loc;
+#endif
 
   /// \brief Provides source/type location info for the declaration name
   /// embedded in D.
@@ -952,7 +954,8 @@ public:
               ExprValueKind VK, SourceLocation L,
               const DeclarationNameLoc &LocInfo = DeclarationNameLoc())
     : Expr(DeclRefExprClass, T, VK, OK_Ordinary, false, false, false, false),
-      D(D), Loc(L), DNLoc(LocInfo) {
+      D(D), DNLoc(LocInfo) {
+    setLocation(L);
     DeclRefExprBits.HasQualifier = 0;
     DeclRefExprBits.HasTemplateKWAndArgsInfo = 0;
     DeclRefExprBits.HasFoundDecl = 0;
@@ -987,11 +990,20 @@ public:
   void setDecl(ValueDecl *NewD) { D = NewD; }
 
   DeclarationNameInfo getNameInfo() const {
-    return DeclarationNameInfo(getDecl()->getDeclName(), Loc, DNLoc);
+    return DeclarationNameInfo(getDecl()->getDeclName(), getLocation(), DNLoc);
   }
 
+#ifdef CLANG_DECLREFEXPR_LOC_IN_STMT_BITS
+  SourceLocation getLocation() const {
+    return SourceLocation::getFromRawEncoding(DeclRefExprBits.Loc);
+  }
+  void setLocation(SourceLocation L) {
+    DeclRefExprBits.Loc = L.getRawEncoding();
+  }
+#else
   SourceLocation getLocation() const { return Loc; }
   void setLocation(SourceLocation L) { Loc = L; }
+#endif
   SourceLocation getLocStart() const LLVM_READONLY;
   SourceLocation getLocEnd() const LLVM_READONLY;
 
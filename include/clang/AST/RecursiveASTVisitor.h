@@ -130,6 +130,12 @@ namespace clang {
 /// to return true, in which case all known implicit and explicit
 /// instantiations will be visited at the same time as the pattern
 /// from which they were produced.
+///
+/// Traversal is strictly serial. Although top-level declarations can often
+/// be visited independently, they may not be traversed from several threads
+/// at once: iterating a DeclContext can load declarations from an external
+/// AST source, and many ASTContext queries a visitor typically makes (record
+/// layouts, parent maps, comments) build and cache their results lazily.
 template <typename Derived> class RecursiveASTVisitor {
 public:
   /// \brief Return a reference to the derived class.
@@ -26,6 +26,13 @@
 #include "llvm/Support/ErrorHandling.h"
 #include <string>
 
+// On 64-bit hosts, Stmt's bit-field union is padded to a pointer, leaving a
+// spare word after the bit-fields. DeclRefExpr keeps its name location there;
+// on other hosts it needs a member of its own.
+#if defined(__LP64__) || defined(_WIN64)
+#define CLANG_DECLREFEXPR_LOC_IN_STMT_BITS 1
+#endif
+
 namespace llvm {
   class FoldingSetNodeID;
 }
@@ -213,6 +220,11 @@ protected:
     unsigned HasFoundDecl : 1;
     unsigned HadMultipleCandidates : 1;
     unsigned RefersToEnclosingLocal : 1;
+
+#ifdef CLANG_DECLREFEXPR_LOC_IN_STMT_BITS
+    /// \brief The raw encoding of the location of the declaration name.
+    unsigned Loc;
+#endif
   };
 
   class CastExprBitfields {
@@ -287,7 +299,8 @@ protected:
   };
 
   union {
-    // FIXME: this is wasteful on 64-bit platforms.
+    // FIXME: this is wasteful on 64-bit platforms. Only DeclRefExpr makes use
+    // of the second word, see CLANG_DECLREFEXPR_LOC_IN_STMT_BITS.
     void *Aligner;
 
     StmtBitfields StmtBits;
@@ -1504,13 +1504,19 @@ inline internal::Matcher<Stmt> sizeOfExpr(
 /// \endcode
 AST_MATCHER_P(NamedDecl, hasName, std::string, Name) {
   assert(!Name.empty());
+  const StringRef Pattern = Name;
+  // An unqualified name can only match the last component of the qualified
+  // name, which for identifiers is the identifier itself. Checking that first
+  // avoids printing the qualified name of every candidate.
+  if (Node.getIdentifier() && Pattern.find(':') == StringRef::npos)
+    return Node.getName() == Pattern;
   const std::string FullNameString = "::" + Node.getQualifiedNameAsString();
   const StringRef FullName = FullNameString;
-  const StringRef Pattern = Name;
   if (Pattern.startswith("::")) {
     return FullName == Pattern;
   } else {
-    return FullName.endswith(("::" + Pattern).str());
+    return FullName.endswith(Pattern) &&
+           FullName.drop_back(Pattern.size()).endswith("::");
   }
 }
 
@@ -135,6 +135,12 @@ public:
   ///   occurred.
   ///   In that case, \c Error will contain a description of the error.
   ///   The caller takes ownership of the DynTypedMatcher object returned.
+  ///
+  /// The returned matcher is the same kind of object the static matcher
+  /// functions build; the \c VariantMatcher values are only used while
+  /// parsing. Callers that run the same query repeatedly should parse it once
+  /// and keep the result, e.g. to pass it to
+  /// \c MatchFinder::addDynamicMatcher for every translation unit.
   static llvm::Optional<DynTypedMatcher>
   parseMatcherExpression(StringRef MatcherCode, Diagnostics *Error);
 
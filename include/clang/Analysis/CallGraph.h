@@ -31,6 +31,9 @@ class CallGraphNode;
 /// The call graph extends itself with the given declarations by implementing
 /// the recursive AST visitor, which constructs the graph by visiting the given
 /// declarations.
+///
+/// The graph implements GraphTraits, so bottom-up clients can walk its
+/// strongly connected components with llvm::scc_iterator.
 class CallGraph : public RecursiveASTVisitor<CallGraph> {
   friend class CallGraphNode;
 
@@ -75,6 +75,13 @@ public:
   /// \brief Mark the identifiers for all the builtins with their
   /// appropriate builtin ID # and mark any non-portable builtin identifiers as
   /// such.
+  ///
+  /// FIXME: This creates an IdentifierInfo for every supported builtin up
+  /// front.  Doing it lazily would need a hook in IdentifierTable::get for
+  /// newly created identifiers, and a way to cover identifiers that bypass
+  /// the table (PTH) or come pre-classified from an AST file or module.
+  /// Without a generated perfect hash of the builtin names, the name-to-ID
+  /// map such a hook needs costs about as much to build as the eager marking.
   void InitializeBuiltins(IdentifierTable &Table, const LangOptions& LangOpts);
 
   /// \brief Populate the vector with the names of all of the builtins.
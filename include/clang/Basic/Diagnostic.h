@@ -252,6 +252,17 @@ private:
   typedef std::vector<DiagStatePoint> DiagStatePointsTy;
   mutable DiagStatePointsTy DiagStatePoints;
 
+  /// \brief Locations in \c LastStateQueryFID at or after
+  /// \c LastStateQueryOffset are known to come after the last DiagStatePoint,
+  /// as long as there are still \c LastStateQueryNumPoints points.
+  ///
+  /// This lets GetDiagStatePointForLoc skip the isBeforeInTranslationUnit
+  /// check for the common case of many diagnostics queried in the same file
+  /// after the last diagnostic pragma.
+  mutable FileID LastStateQueryFID;
+  mutable unsigned LastStateQueryOffset;
+  mutable unsigned LastStateQueryNumPoints;
+
   /// \brief Keeps the DiagState that was active during each diagnostic 'push'
   /// so we can get back at it when we 'pop'.
   std::vector<DiagState *> DiagStateOnPushStack;
@@ -383,7 +394,10 @@ public:
     assert(SourceMgr && "SourceManager not set!");
     return *SourceMgr;
   }
-  void setSourceManager(SourceManager *SrcMgr) { SourceMgr = SrcMgr; }
+  void setSourceManager(SourceManager *SrcMgr) {
+    SourceMgr = SrcMgr;
+    LastStateQueryNumPoints = 0;
+  }
 
   //===--------------------------------------------------------------------===//
   //  DiagnosticsEngine characterization methods, used by a client to customize
@@ -124,6 +124,57 @@ public:
                        vfs::FileSystem &FS) override;
 };
 
+/// \brief A stat cache whose results can be saved to disk and loaded again by
+/// later invocations, so that the header search probing done by one compile
+/// can be reused by every other compile in the same build.
+///
+/// Unlike \c MemorizeStatCalls, this remembers lookups that failed as well as
+/// those that succeeded, since failed probes make up most of header search.
+/// A failed lookup is only remembered for the kind of entry (file or
+/// directory) that was asked for.  Only absolute paths are recorded, and only
+/// when the file system reports the entry under the same name.
+///
+/// A saved cache is tagged with an epoch token supplied by the client (for
+/// example a build ID); loading a cache that was saved with a different token
+/// produces an empty cache.  It is up to the client to change the token
+/// whenever files may have been modified, added or removed.
+class PersistentStatCache : public FileSystemStatCache {
+  struct CachedStat {
+    bool Exists;
+    bool MissingAsFile;
+    bool MissingAsDirectory;
+    FileData Data;
+    CachedStat()
+        : Exists(false), MissingAsFile(false), MissingAsDirectory(false) {}
+  };
+
+  std::string Epoch;
+  llvm::StringMap<CachedStat, llvm::BumpPtrAllocator> StatCalls;
+  bool Dirty;
+
+public:
+  explicit PersistentStatCache(StringRef Epoch) : Epoch(Epoch), Dirty(false) {}
+
+  /// \brief Load the cache saved at \p Path.  If the file is missing,
+  /// malformed, or was saved for a different \p Epoch, an empty cache is
+  /// returned.
+  static PersistentStatCache *load(StringRef Path, StringRef Epoch);
+
+  /// \brief Save the cache to \p Path.
+  ///
+  /// \returns \c true on error.
+  bool save(StringRef Path, std::string &ErrorStr) const;
+
+  /// \brief Whether lookups were added since the cache was loaded.
+  bool isDirty() const { return Dirty; }
+
+  unsigned size() const { return StatCalls.size(); }
+
+  LookupResult getStat(const char *Path, FileData &Data, bool isFile,
+                       std::unique_ptr<vfs::File> *F,
+                       vfs::FileSystem &FS) override;
+};
+
 } // end namespace clang
 
 #endif
@@ -604,6 +604,13 @@ class SourceManager : public RefCountedBase<SourceManager> {
   /// expansion.
   SmallVector<SrcMgr::SLocEntry, 0> LocalSLocEntryTable;
 
+  /// \brief The offsets of the entries in LocalSLocEntryTable.
+  ///
+  /// These are kept densely packed, apart from the much larger SLocEntries,
+  /// so that the binary search in getFileIDLocal touches as few cache lines
+  /// as possible.
+  SmallVector<unsigned, 0> LocalSLocEntryOffsets;
+
   /// \brief The table of SLocEntries that are loaded from other modules.
   ///
   /// Negative FileIDs are indexes into this table. To get from ID to an index,
@@ -18,8 +18,10 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/SourceMgr.h"
+#include <map>
 
 namespace llvm {
 class MemoryBuffer;
@@ -245,6 +247,66 @@ public:
   iterator overlays_end() { return FSList.rend(); }
 };
 
+/// \brief A file system that keeps the contents of the regular files read
+/// through it, keyed by each file's unique ID, modification time and size.
+///
+/// One instance may be shared by any number of FileManagers in a process (for
+/// example by every compiler instance in a tooling run), so that a header is
+/// read from \p ExternalFS at most once for as long as it does not change.
+/// A file that is modified gets a fresh entry, since its modification time or
+/// size no longer matches.  Volatile reads always bypass the cache.
+///
+/// Buffers handed out by this file system refer to the cached contents, so the
+/// file system must outlive them.
+class CachingFileSystem : public FileSystem {
+public:
+  struct ContentKey {
+    llvm::sys::fs::UniqueID UID;
+    uint64_t MTime;
+    uint64_t Size;
+
+    bool operator<(const ContentKey &RHS) const {
+      if (UID != RHS.UID)
+        return UID < RHS.UID;
+      if (MTime != RHS.MTime)
+        return MTime < RHS.MTime;
+      return Size < RHS.Size;
+    }
+  };
+
+private:
+  IntrusiveRefCntPtr<FileSystem> ExternalFS;
+
+  /// \brief Guards \c Contents, which may be shared across threads.
+  llvm::sys::Mutex ContentsLock;
+  std::map<ContentKey, llvm::MemoryBuffer *> Contents;
+
+  unsigned NumHits, NumMisses;
+
+public:
+  explicit CachingFileSystem(IntrusiveRefCntPtr<FileSystem> ExternalFS);
+  ~CachingFileSystem();
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+  std::error_code openFileForRead(const Twine &Path,
+                                  std::unique_ptr<File> &Result) override;
+  directory_iterator dir_begin(const Twine &Dir, std::error_code &EC) override;
+
+  /// \brief Returns the cached contents for the file described by \p Key,
+  /// reading them from \p F and caching them if this is the first request.
+  std::error_code getCachedContents(const ContentKey &Key, File &F,
+                                    const Twine &Name,
+                                    const llvm::MemoryBuffer *&Result);
+
+  /// \brief Drops every cached buffer.  No buffer returned by this file system
+  /// may be live when this is called.
+  void clearCache();
+
+  unsigned getNumCachedFiles();
+  unsigned getNumHits() const { return NumHits; }
+  unsigned getNumMisses() const { return NumMisses; }
+};
+
 /// \brief Get a globally unique ID for a virtual file or directory.
 llvm::sys::fs::UniqueID getNextVirtualUniqueID();
 
@@ -72,6 +72,38 @@ class Compilation {
   /// Whether we're compiling for diagnostic purposes.
   bool ForDiagnostics;
 
+  /// The maximum number of independent commands to run at once.
+  unsigned ParallelJobs;
+
+  /// Whether a lone -cc1 job may run inside the driver process.
+  bool ExecuteCC1InProcess;
+
+  /// Return true if \p C is the only -cc1 job and can be run in-process.
+  bool canExecuteInProcess(const Command &C) const;
+
+  /// Run the -cc1 job \p C through Driver::CC1Main.
+  ///
+  /// \return The result code of the job.
+  int ExecuteInProcess(const Command &C) const;
+
+  /// Print the command line of \p C if requested by -v or CC_PRINT_OPTIONS.
+  ///
+  /// \return Non-zero if the command line could not be logged.
+  int PrintCommand(const Command &C, const Command *&FailingCommand) const;
+
+  /// Report the result of running \p C.
+  ///
+  /// \return The result code of the subprocess.
+  int FinishCommand(const Command &C, int Res, const std::string &Error,
+                    bool ExecutionFailed,
+                    const Command *&FailingCommand) const;
+
+  /// Run the commands in \p Jobs, starting up to ParallelJobs of them at
+  /// once.  A command is not started until the commands producing its inputs
+  /// have finished, and results are reported in job order.
+  void ExecuteJobsInParallel(const JobList &Jobs,
+     SmallVectorImpl< std::pair<int, const Command *> > &FailingCommands) const;
+
 public:
   Compilation(const Driver &D, const ToolChain &DefaultToolChain,
               llvm::opt::InputArgList *Args,
@@ -179,6 +211,12 @@ public:
 
   /// Return true if we're compiling for diagnostics.
   bool isForDiagnostics() { return ForDiagnostics; }
+
+  /// Set the maximum number of independent commands to run at once.
+  void setParallelJobs(unsigned N) { ParallelJobs = N; }
+
+  /// Allow a lone -cc1 job to run inside the driver process.
+  void setExecuteCC1InProcess(bool V) { ExecuteCC1InProcess = V; }
 };
 
 } // end namespace driver
@@ -165,6 +165,11 @@ public:
   /// Use lazy precompiled headers for PCH support.
   unsigned CCCUsePCH : 1;
 
+  /// If set, used to run a -cc1 job inside the driver process. \p Argv holds
+  /// the executable followed by the job's arguments. It must return to the
+  /// driver on crashes and fatal errors, with a negative result for a crash.
+  int (*CC1Main)(ArrayRef<const char *> Argv);
+
 private:
   /// Certain options suppress the 'no input files' warning.
   bool SuppressMissingInputWarning : 1;
@@ -412,6 +412,15 @@ private:
 
   /// \brief Cache any "global" code-completion results, so that we can avoid
   /// recomputing them with each completion.
+  ///
+  /// The cache is rebuilt in full, during Reparse(), and only when the hash
+  /// of the top-level declarations differs from the one it was built for.
+  /// Editing an #include that doesn't change the visible declarations does
+  /// not invalidate it.
+  ///
+  /// FIXME: Rebuilding it off the main thread, while still serving the old
+  /// results, would need the cached strings to outlive the ASTContext they
+  /// were produced from.
   void CacheCodeCompletionResults();
   
   /// \brief Clear out and deallocate 
@@ -708,6 +717,11 @@ public:
   /// lifetime is expected to extend past that of the returned ASTUnit.
   ///
   /// \returns - The initialized ASTUnit or null if the AST failed to load.
+  ///
+  /// FIXME: The loaded unit has no preamble, completion cache or compiler
+  /// invocation, so it cannot be reparsed incrementally.  Restoring a warm
+  /// unit would need Save() to also record the invocation and the preamble
+  /// PCH (whose bounds and dependency stat()s must be revalidated on load).
   static ASTUnit *LoadFromASTFile(const std::string &Filename,
                               IntrusiveRefCntPtr<DiagnosticsEngine> Diags,
                                   const FileSystemOptions &FileSystemOpts,
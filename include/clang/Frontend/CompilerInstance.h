@@ -28,6 +28,7 @@
 namespace llvm {
 class raw_fd_ostream;
 class Timer;
+class TimerGroup;
 }
 
 namespace clang {
@@ -42,6 +43,7 @@ class FileEntry;
 class FileManager;
 class FrontendAction;
 class Module;
+class PersistentStatCache;
 class Preprocessor;
 class Sema;
 class SourceManager;
@@ -81,6 +83,9 @@ class CompilerInstance : public ModuleLoader {
   /// The file manager.
   IntrusiveRefCntPtr<FileManager> FileMgr;
 
+  /// The stat cache loaded from -stat-cache, if any; owned by \c FileMgr.
+  PersistentStatCache *PersistentStats;
+
   /// The source manager.
   IntrusiveRefCntPtr<SourceManager> SourceMgr;
 
@@ -99,9 +104,15 @@ class CompilerInstance : public ModuleLoader {
   /// \brief The semantic analysis object.
   std::unique_ptr<Sema> TheSema;
 
+  /// \brief The frontend timer group, reported as one table.
+  std::unique_ptr<llvm::TimerGroup> FrontendTimerGroup;
+
   /// \brief The frontend timer
   std::unique_ptr<llvm::Timer> FrontendTimer;
 
+  /// \brief The timer for reading precompiled headers and module files.
+  std::unique_ptr<llvm::Timer> ASTFileLoadTimer;
+
   /// \brief The ASTReader, if one exists.
   IntrusiveRefCntPtr<ASTReader> ModuleManager;
 
@@ -506,6 +517,10 @@ public:
     return *FrontendTimer;
   }
 
+  /// \brief Return the timer for reading AST files, or null if timers are
+  /// disabled.
+  llvm::Timer *getASTFileLoadTimer() const { return ASTFileLoadTimer.get(); }
+
   /// }
   /// @name Output Files
   /// {
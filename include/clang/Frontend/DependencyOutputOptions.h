@@ -44,6 +44,10 @@ public:
   /// \brief The file to write GraphViz-formatted header dependencies to.
   std::string DOTOutputFile;
 
+  /// \brief The file to write dependencies, with the hashes of their contents,
+  /// to.
+  std::string HashOutputFile;
+
   /// \brief The directory to copy module dependencies to when collecting them.
   std::string ModuleDependencyOutputDir;
 
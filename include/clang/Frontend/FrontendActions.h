@@ -231,6 +231,16 @@ protected:
   void ExecuteAction() override;
 };
 
+/// \brief Handle only the preprocessor directives of the input and the files
+/// it includes, skipping the text between them.
+///
+/// This is meant to be paired with a dependency file: the set of headers
+/// reached is the same as for a full preprocess, at a fraction of the cost.
+class DependencyScanAction : public PreprocessorFrontendAction {
+protected:
+  void ExecuteAction() override;
+};
+
 class PrintPreprocessedAction : public PreprocessorFrontendAction {
 protected:
   void ExecuteAction() override;
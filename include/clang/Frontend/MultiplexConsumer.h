@@ -26,6 +26,14 @@ class MultiplexASTMutationListener;
 class MultiplexASTDeserializationListener;
 
 // Has a list of ASTConsumers and calls each of them. Owns its children.
+//
+// The children are called in order, synchronously, on the thread that is
+// parsing. They can't be moved to a background thread: reading the AST is
+// not thread-safe (declarations, lookup tables and definitions are
+// deserialized lazily, and linkage and layout results are cached on first
+// use), and Sema keeps modifying a declaration after handing it to
+// HandleTopLevelDecl, for instance by adding redeclarations, implicit
+// members or instantiations at the end of the translation unit.
 class MultiplexConsumer : public SemaConsumer {
 public:
   // Takes ownership of the pointers in C.
@@ -20,6 +20,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Option/OptSpecifier.h"
+#include <memory>
 
 namespace llvm {
 class raw_fd_ostream;
@@ -102,6 +103,21 @@ private:
   std::vector<std::string> Dependencies;
 };
 
+/// Create a dependency collector that writes each dependency of the main file
+/// to \p OutputFile at the end of the main file, one per line, as
+///
+///   <hash> <kind> <filename>
+///
+/// where \c <kind> is \c input for files read by the preprocessor,
+/// \c module-input for the inputs of imported modules, and \c module-file for
+/// the module files themselves. \c <hash> is the MD5 hash of the file's
+/// contents if this compilation had them in memory, and \c - otherwise, so
+/// that build systems needn't read those files again to hash them.
+std::shared_ptr<DependencyCollector>
+createDependencyHashCollector(StringRef OutputFile, SourceManager &SM,
+                              DiagnosticsEngine &Diags,
+                              bool IncludeSystemHeaders);
+
 /// Builds a depdenency file when attached to a Preprocessor (for includes) and
 /// ASTReader (for module imports), and writes it out at the end of processing
 /// a source file.  Users should attach to the ast reader whenever a module is
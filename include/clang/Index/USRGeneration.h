@@ -12,6 +12,7 @@
 
 #include "clang/Basic/LLVM.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
 
 namespace clang {
 class Decl;
@@ -28,6 +29,13 @@ static inline StringRef getUSRSpacePrefix() {
 /// \returns true if the results should be ignored, false otherwise.
 bool generateUSRForDecl(const Decl *D, SmallVectorImpl<char> &Buf);
 
+/// \brief Generate a stable 64-bit hash of the USR for a Decl.
+///
+/// This is for clients that only store USRs as hashes; the USR is built in a
+/// stack buffer and never handed back as a string.
+/// \returns true if the results should be ignored, false otherwise.
+bool generateUSRHashForDecl(const Decl *D, uint64_t &Hash);
+
 /// \brief Generate a USR fragment for an Objective-C class.
 void generateUSRForObjCClass(StringRef Cls, raw_ostream &OS);
 
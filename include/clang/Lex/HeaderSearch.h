@@ -191,9 +191,10 @@ class HeaderSearch {
 
   /// Keeps track of each lookup performed by LookupFile.
   struct LookupFileCacheInfo {
-    /// Starting index in SearchDirs that the cached search was performed from.
-    /// If there is a hit and this value doesn't match the current query, the
-    /// cache has to be ignored.
+    /// Starting index in SearchDirs that the cached search was performed from,
+    /// plus one.  A query starting at an index in [StartIdx-1, HitIdx] can
+    /// reuse the result, since none of the directories it would probe before
+    /// HitIdx contained the file.  Otherwise the cache has to be ignored.
     unsigned StartIdx;
     /// The entry in SearchDirs that satisfied the query.
     unsigned HitIdx;
@@ -206,6 +207,8 @@ class HeaderSearch {
 
     void reset(unsigned StartIdx) {
       this->StartIdx = StartIdx;
+      // Until the search completes, only the starting point is known.
+      this->HitIdx = StartIdx - 1;
       this->MappedName = nullptr;
     }
   };
@@ -158,6 +158,11 @@ public:
   /// \brief Whether to validate system input files when a module is loaded.
   unsigned ModulesValidateSystemHeaders : 1;
 
+  /// \brief Whether to skip the bodies of top-level module declarations when
+  /// loading a module map, parsing each one only when the module or one of
+  /// its headers is first looked up.
+  unsigned ModulesLazyModuleMaps : 1;
+
 public:
   HeaderSearchOptions(StringRef _Sysroot = "/")
     : Sysroot(_Sysroot), DisableModuleHash(0), ModuleMaps(0),
@@ -168,7 +173,7 @@ public:
       UseStandardSystemIncludes(true), UseStandardCXXIncludes(true),
       UseLibcxx(false), Verbose(false),
       ModulesValidateOncePerBuildSession(false),
-      ModulesValidateSystemHeaders(false) {}
+      ModulesValidateSystemHeaders(false), ModulesLazyModuleMaps(false) {}
 
   /// AddPath - Add the \p Path path to the specified \p Group list.
   void AddPath(StringRef Path, frontend::IncludeDirGroup Group,
@@ -0,0 +1,80 @@
+//===--- IncludeGuardIndex.h - Include guards across compiles ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the IncludeGuardIndex interface.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_INCLUDEGUARDINDEX_H
+#define LLVM_CLANG_LEX_INCLUDEGUARDINDEX_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/StringMap.h"
+#include <ctime>
+#include <string>
+
+namespace clang {
+  class FileEntry;
+
+/// \brief An on-disk record of the include guards ("controlling macros")
+/// that the preprocessor has discovered in headers.
+///
+/// Normally the preprocessor only learns that a header is guarded by lexing
+/// it once.  With an index shared by every compile in a build, a header whose
+/// guard macro is already defined is skipped without being entered even the
+/// first time it is included in a translation unit.  Entries are keyed by the
+/// header's absolute path and are ignored if its size or modification time has
+/// changed since they were recorded.
+class IncludeGuardIndex {
+  struct Entry {
+    uint64_t Size;
+    time_t ModTime;
+    std::string Macro;
+
+    Entry() : Size(0), ModTime(0) {}
+  };
+
+  /// \brief The path the index is loaded from and saved to.
+  std::string IndexPath;
+
+  llvm::StringMap<Entry> Entries;
+
+  /// \brief Whether entries were added or changed since the index was loaded.
+  bool Dirty;
+
+  static void getKey(const FileEntry *File, SmallVectorImpl<char> &Key);
+
+public:
+  explicit IncludeGuardIndex(StringRef IndexPath)
+    : IndexPath(IndexPath), Dirty(false) {}
+
+  StringRef getIndexPath() const { return IndexPath; }
+
+  /// \brief Load the index from disk.  A missing or malformed index file
+  /// leaves the index empty.
+  void load();
+
+  /// \brief Save the index to disk if anything was added to it.
+  ///
+  /// \returns \c true on error, with a description in \p ErrorStr.
+  bool save(std::string &ErrorStr);
+
+  /// \brief Return the controlling macro recorded for \p File, or an empty
+  /// string if there is none or \p File has changed since it was recorded.
+  StringRef lookup(const FileEntry *File) const;
+
+  /// \brief Record that \p File is guarded by \p Macro.
+  void record(const FileEntry *File, StringRef Macro);
+
+  unsigned size() const { return Entries.size(); }
+};
+
+}  // end namespace clang
+
+#endif
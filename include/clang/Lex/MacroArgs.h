@@ -45,6 +45,15 @@ class MacroArgs {
   /// stream.
   std::vector<std::vector<Token> > PreExpArgTokens;
 
+  /// UnexpArgStarts - The index of the first unexpanded token of each
+  /// argument, so that getUnexpArgument does not need to rescan the token
+  /// list for every use of an argument.
+  std::vector<unsigned> UnexpArgStarts;
+
+  /// PreExpNeeded - Memoized results of ArgNeedsPreexpansion, indexed by
+  /// argument number.
+  std::vector<unsigned char> PreExpNeeded;
+
   /// StringifiedArgs - This contains arguments in 'stringified' form.  If the
   /// stringified form of an argument has not yet been computed, this is empty.
   std::vector<Token> StringifiedArgs;
@@ -72,6 +81,11 @@ public:
   /// by pre-expansion, return false.  Otherwise, conservatively return true.
   bool ArgNeedsPreexpansion(const Token *ArgTok, Preprocessor &PP) const;
 
+  /// ArgNeedsPreexpansion - Like the above, for the specified formal.  The
+  /// answer cannot change during a single expansion, so it is computed once
+  /// per argument however many times the argument is used.
+  bool ArgNeedsPreexpansion(unsigned Arg, Preprocessor &PP);
+
   /// getUnexpArgument - Return a pointer to the first token of the unexpanded
   /// token list for the specified formal.
   ///
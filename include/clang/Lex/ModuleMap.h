@@ -150,7 +150,41 @@ private:
   /// map.
   llvm::DenseMap<const FileEntry *, bool> ParsedModuleMap;
 
+  /// \brief A top-level module declaration whose body has been skipped, to be
+  /// parsed the first time the module or one of its headers is looked up.
+  struct DeferredModuleDecl {
+    /// \brief The module map file containing the declaration.
+    const FileEntry *ModuleMapFile;
+
+    /// \brief The directory the module's headers are relative to.
+    const DirectoryEntry *Directory;
+
+    /// \brief The file ID of the module map file.
+    FileID ID;
+
+    /// \brief The offset of the first token of the declaration.
+    unsigned Offset;
+
+    /// \brief Whether the module map is in a system header directory.
+    bool IsSystem;
+  };
+
+  /// \brief Deferred top-level module declarations, by module name.
+  llvm::StringMap<DeferredModuleDecl> DeferredModules;
+
+  /// \brief The names of deferred modules, keyed by the file name (the last
+  /// path component) of each header they declare.
+  llvm::StringMap<SmallVector<std::string, 1> > DeferredModulesByHeader;
+
   friend class ModuleMapParser;
+
+  /// \brief Parse the deferred declaration of the top-level module \p Name,
+  /// if there is one.
+  void parseDeferredModule(StringRef Name);
+
+  /// \brief Parse the deferred module declarations that might name \p File
+  /// as a header.
+  void parseDeferredModulesForHeader(const FileEntry *File);
   
   /// \brief Resolve the given export declaration into an actual export
   /// declaration.
@@ -414,6 +448,12 @@ public:
   ///
   /// \returns true if an error occurred, false otherwise.
   bool parseModuleMapFile(const FileEntry *File, bool IsSystem);
+
+  /// \brief Parse every module declaration whose body was skipped because
+  /// module maps are being loaded lazily.
+  ///
+  /// This must be called before walking the complete list of modules.
+  void parseAllDeferredModules();
     
   /// \brief Dump the contents of the module map, for debugging purposes.
   void dump();
@@ -50,6 +50,14 @@ class PTHManager : public IdentifierInfoLookup {
   ///  and token data in the PTH file.
   void* FileLookup;
 
+  /// FileDataCache - Memoizes the result of looking up a FileEntry in
+  ///  FileLookup, so that re-entering a file does not hash and compare its
+  ///  name again.  A null token pointer records that the file has no cached
+  ///  tokens.
+  llvm::DenseMap<const FileEntry*,
+                 std::pair<const unsigned char*, const unsigned char*> >
+    FileDataCache;
+
   /// IdDataTable - Array representing the mapping from persistent IDs to the
   ///  data offset within the PTH file containing the information to
   ///  reconsitute an IdentifierInfo.
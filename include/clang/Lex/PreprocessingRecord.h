@@ -334,6 +334,13 @@ namespace clang {
     /// \brief External source of preprocessed entities.
     ExternalPreprocessingRecordSource *ExternalSource;
 
+    /// \brief Whether macro expansions (and macro references in \#ifdef,
+    /// \#ifndef and defined()) are recorded.
+    ///
+    /// Clients that only need macro definitions and inclusion directives can
+    /// turn this off; expansions usually make up the bulk of the record.
+    bool RecordMacroExpansions;
+
     /// \brief Retrieve the preprocessed entity at the given ID.
     PreprocessedEntity *getPreprocessedEntity(PPEntityID PPID);
 
@@ -555,6 +562,14 @@ namespace clang {
     ExternalPreprocessingRecordSource *getExternalSource() const {
       return ExternalSource;
     }
+
+    /// \brief Set whether macro expansions are recorded.
+    void setRecordMacroExpansions(bool Record) {
+      RecordMacroExpansions = Record;
+    }
+
+    /// \brief Determine whether macro expansions are recorded.
+    bool isRecordingMacroExpansions() const { return RecordMacroExpansions; }
     
     /// \brief Retrieve the macro definition that corresponds to the given
     /// \c MacroInfo.
@@ -19,6 +19,7 @@
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/IdentifierTable.h"
 #include "clang/Basic/SourceLocation.h"
+#include "clang/Lex/IncludeGuardIndex.h"
 #include "clang/Lex/Lexer.h"
 #include "clang/Lex/MacroInfo.h"
 #include "clang/Lex/ModuleMap.h"
@@ -104,6 +105,10 @@ class Preprocessor : public RefCountedBase<Preprocessor> {
   /// a token cache rather than lexing the original source file.
   std::unique_ptr<PTHManager> PTH;
 
+  /// An optional index of the include guards seen by earlier compiles, used
+  /// to skip guarded headers without entering them.
+  std::unique_ptr<IncludeGuardIndex> GuardIndex;
+
   /// A BumpPtrAllocator object used to quickly allocate and release
   /// objects internal to the Preprocessor.
   llvm::BumpPtrAllocator BP;
@@ -379,6 +384,9 @@ class Preprocessor : public RefCountedBase<Preprocessor> {
   unsigned NumMacroExpanded, NumFnMacroExpanded, NumBuiltinMacroExpanded;
   unsigned NumFastMacroExpanded, NumTokenPaste, NumFastTokenPaste;
   unsigned NumSkipped;
+  unsigned NumTokenLexersAllocated, NumMacroArgsAllocated;
+  unsigned NumCachedTokensGrowths;
+  unsigned NumBacktracks, NumBacktrackedTokens;
 
   /// \brief The predefined macros that preprocessor should use from the
   /// command line etc.
@@ -486,6 +494,16 @@ public:
 
   PTHManager *getPTHManager() { return PTH.get(); }
 
+  /// \brief Use \p Index to look up the include guards of headers before
+  /// entering them, and record the include guards found in this translation
+  /// unit into it when the main file is finished.  Takes ownership of
+  /// \p Index.
+  void setIncludeGuardIndex(IncludeGuardIndex *Index) {
+    GuardIndex.reset(Index);
+  }
+
+  IncludeGuardIndex *getIncludeGuardIndex() { return GuardIndex.get(); }
+
   void setExternalSource(ExternalPreprocessorSource *Source) {
     ExternalSource = Source;
   }
@@ -823,6 +841,15 @@ public:
     while (Result.getKind() == tok::comment);
   }
 
+  /// \brief Lex the next token, skipping everything in source files that is
+  /// not part of a preprocessor directive.
+  ///
+  /// Text between directives is scanned by the raw lexer, so it is neither
+  /// looked up nor macro expanded.  Directives, including \#include and
+  /// conditionals, are handled as usual.  This is enough to discover the
+  /// headers a file depends on without fully preprocessing it.
+  void LexDirectivesOnly(Token &Result);
+
   /// \brief Parses a simple integer literal to get its numeric value.  Floating
   /// point literals and user defined literals are rejected.  Used primarily to
   /// handle pragmas that accept integer arguments.
@@ -1528,6 +1555,10 @@ private:
   void HandleImportDirective(SourceLocation HashLoc, Token &Tok);
   void HandleMicrosoftImportDirective(Token &Tok);
 
+  // Include guard index.
+  void applyIncludeGuardIndex(const FileEntry *File);
+  void updateIncludeGuardIndex();
+
   // Module inclusion testing.
   /// \brief Find the module for the source or header file that \p FilenameLoc
   /// points to.
@@ -223,6 +223,16 @@ class Parser : public CodeCompletionHandler {
   /// \brief Identifiers which have been declared within a tentative parse.
   SmallVector<IdentifierInfo *, 8> TentativelyDeclaredIdentifiers;
 
+  /// \brief Outcomes of isCXXFunctionDeclarator within the outermost active
+  /// tentative parse, keyed by the raw location of the '(' and the number of
+  /// tentatively-declared identifiers at that point.
+  ///
+  /// Nested tentative parses can ask about the same declarator more than
+  /// once; the answer cannot change until the outermost tentative parse is
+  /// finished, so the table is cleared whenever a new one starts.
+  llvm::SmallDenseMap<std::pair<unsigned, unsigned>, bool, 4>
+      TentativeFunctionDeclarators;
+
   IdentifierInfo *getSEHExceptKeyword();
 
   /// True if we are within an Objective-C container while parsing C-like decls.
@@ -663,6 +673,8 @@ private:
 
   public:
     explicit TentativeParsingAction(Parser& p) : P(p) {
+      if (!P.PP.isBacktrackEnabled())
+        P.TentativeFunctionDeclarators.clear();
       PrevTok = P.Tok;
       PrevTentativelyDeclaredIdentifierCount =
           P.TentativelyDeclaredIdentifiers.size();
@@ -1163,6 +1175,10 @@ private:
 
   static void LateTemplateParserCallback(void *P, LateParsedTemplate &LPT);
 
+  void ParseSkippedFunctionBody(LateParsedTemplate &LPT);
+
+  static void SkippedBodyParserCallback(void *P, LateParsedTemplate &LPT);
+
   Sema::ParsingClassState
   PushParsingClass(Decl *TagOrTemplate, bool TopLevelClass, bool IsInterface);
   void DeallocateParsedClasses(ParsingClass *Class);
@@ -1752,8 +1768,11 @@ private:
   /// \brief When in code-completion, skip parsing of the function/method body
   /// unless the body contains the code-completion point.
   ///
+  /// \param Toks If non-null, the skipped tokens, including the braces, are
+  /// stored here.
+  ///
   /// \returns true if the function body was skipped.
-  bool trySkippingFunctionBody();
+  bool trySkippingFunctionBody(CachedTokens *Toks = nullptr);
 
   bool ParseImplicitInt(DeclSpec &DS, CXXScopeSpec *SS,
                         const ParsedTemplateInfo &TemplateInfo,
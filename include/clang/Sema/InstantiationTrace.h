@@ -0,0 +1,79 @@
+//===--- InstantiationTrace.h - Template instantiation profiling -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the InstantiationTrace class, which records the time
+//  spent in each template instantiation and writes it out in the Chrome
+//  trace event format.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_SEMA_INSTANTIATIONTRACE_H
+#define LLVM_CLANG_SEMA_INSTANTIATIONTRACE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include <string>
+#include <vector>
+
+namespace clang {
+  class ASTContext;
+  class Decl;
+
+/// \brief Records nested instantiation events for one translation unit.
+///
+/// Every event covers one entry on Sema's active template instantiation
+/// stack, or one round of pending instantiations. Events nest the same way
+/// the instantiations do, so a trace viewer shows the instantiation stack
+/// directly. Each event also records the number of bytes of AST allocated
+/// while it was open, children included.
+class InstantiationTrace {
+public:
+  /// \brief Create a trace that is written to \p OS when it is destroyed.
+  /// The trace takes ownership of the stream.
+  InstantiationTrace(ASTContext &Context, raw_ostream *OS);
+  ~InstantiationTrace();
+
+  /// \brief Open an event named \p Name, describing \p Entity if non-null.
+  void begin(StringRef Name, const Decl *Entity);
+
+  /// \brief Close the innermost open event.
+  void end();
+
+  /// \brief Write every completed event to \p OS as a Chrome trace.
+  void write(raw_ostream &OS) const;
+
+private:
+  InstantiationTrace(const InstantiationTrace &) LLVM_DELETED_FUNCTION;
+  void operator=(const InstantiationTrace &) LLVM_DELETED_FUNCTION;
+
+  struct Event {
+    std::string Name;
+    std::string Detail;
+    double Start;
+    double Duration;
+    size_t StartBytes;
+    size_t Bytes;
+  };
+
+  double now() const;
+
+  ASTContext &Context;
+  raw_ostream *OS;
+  double TraceStart;
+
+  /// \brief Completed events, in the order they were closed.
+  std::vector<Event> Events;
+
+  /// \brief Events that have been opened but not yet closed.
+  SmallVector<Event, 16> Open;
+};
+
+}  // end namespace clang
+
+#endif
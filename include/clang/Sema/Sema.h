@@ -118,6 +118,7 @@ namespace clang {
   class InitializationKind;
   class InitializationSequence;
   class InitializedEntity;
+  class InstantiationTrace;
   class IntegerLiteral;
   class LabelStmt;
   class LambdaExpr;
@@ -485,6 +486,24 @@ public:
     OpaqueParser = P;
   }
 
+  /// \brief Whether the tokens of function bodies skipped by the parser are
+  /// kept, so that ParseSkippedFunctionBody can parse a body on demand.
+  bool RetainSkippedFunctionBodies;
+
+  /// \brief The tokens of skipped function bodies, keyed by the function
+  /// definition.  Entries that have already been parsed have a null \c D.
+  LateParsedTemplateMapT SkippedFunctionBodies;
+
+  /// \brief Callback to the parser to parse a skipped function body.  Only
+  /// set while the parser is alive.
+  LateTemplateParserCB *SkippedBodyParser;
+  void *OpaqueSkippedBodyParser;
+
+  void SetSkippedBodyParser(LateTemplateParserCB *CB, void *P) {
+    SkippedBodyParser = CB;
+    OpaqueSkippedBodyParser = P;
+  }
+
   class DelayedDiagnostics;
 
   class DelayedDiagnosticsState {
@@ -850,6 +869,21 @@ public:
   /// \brief The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// \brief Key for StandardConversionCache: the canonical source and target
+  /// types, and the glvalue/overload-resolution/C-style flags.
+  typedef std::pair<std::pair<void *, void *>, unsigned> StandardConversionKey;
+
+  /// \brief Standard conversion sequences between builtin arithmetic types.
+  ///
+  /// These depend only on the types and flags in the key, never on the
+  /// expression or on class completeness, so entries are never invalidated.
+  /// The sequences are allocated in BumpAlloc.
+  llvm::DenseMap<StandardConversionKey, StandardConversionSequence *>
+    StandardConversionCache;
+
+  /// \brief Lookups in StandardConversionCache, for -print-stats.
+  unsigned NumStandardConversionCacheHits, NumStandardConversionCacheMisses;
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
@@ -1686,6 +1720,20 @@ public:
   Decl *ActOnFinishFunctionBody(Decl *Decl, Stmt *Body);
   Decl *ActOnFinishFunctionBody(Decl *Decl, Stmt *Body, bool IsInstantiation);
   Decl *ActOnSkippedFunctionBody(Decl *Decl);
+
+  /// \brief Remember the tokens of a function body that the parser skipped,
+  /// if RetainSkippedFunctionBodies is set.
+  void MarkAsSkippedFunctionBody(Decl *D, CachedTokens &Toks);
+
+  /// \brief Parse the body of \p FD, or of its definition, if it was skipped
+  /// and its tokens were retained.
+  ///
+  /// This can be called while the translation unit is still being parsed,
+  /// e.g. from ASTConsumer::HandleTopLevelDecl, to analyze the bodies that a
+  /// client needs without parsing all of them.
+  ///
+  /// \returns true if the function now has a body.
+  bool ParseSkippedFunctionBody(FunctionDecl *FD);
   void ActOnFinishInlineMethodDef(CXXMethodDecl *D);
 
   /// ActOnFinishDelayedAttribute - Invoked when we have finished parsing an
@@ -4882,6 +4930,17 @@ public:
   /// by code generation).
   llvm::DenseMap<CXXRecordDecl *, bool> VTablesUsed;
 
+  /// \brief Whether DefineUsedVTables should skip marking the virtual members
+  /// of each required vtable as referenced. This is only valid when no code
+  /// is generated, and suppresses diagnostics from the virtual members that
+  /// would otherwise have been defined or instantiated.
+  bool SkipVTableDefinitions;
+
+  /// \brief Vtables that DefineUsedVTables defined, that it skipped because
+  /// they live in another translation unit, and that it skipped because of
+  /// SkipVTableDefinitions, for -print-stats.
+  unsigned NumVTablesDefined, NumVTablesExternal, NumVTablesSkipped;
+
   /// \brief Load any externally-stored vtable uses.
   void LoadExternalVTableUses();
 
@@ -6228,6 +6287,10 @@ public:
   SmallVector<ActiveTemplateInstantiation, 16>
     ActiveTemplateInstantiations;
 
+  /// \brief If non-null, records the time spent in each entry of
+  /// ActiveTemplateInstantiations and in PerformPendingInstantiations.
+  std::unique_ptr<InstantiationTrace> InstTrace;
+
   /// \brief Extra modules inspected when performing a lookup during a template
   /// instantiation. Computed lazily.
   SmallVector<Module*, 16> ActiveTemplateInstantiationLookupModules;
@@ -8319,6 +8382,7 @@ public:
 private:
   bool SemaBuiltinPrefetch(CallExpr *TheCall);
   bool SemaBuiltinAssume(CallExpr *TheCall);
+  bool SemaBuiltinAssumeAligned(CallExpr *TheCall);
   bool SemaBuiltinLongjmp(CallExpr *TheCall);
   ExprResult SemaBuiltinAtomicOverloaded(ExprResult TheCallResult);
   ExprResult SemaAtomicOpsOverloaded(ExprResult TheCallResult,
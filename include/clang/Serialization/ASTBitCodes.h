@@ -35,7 +35,7 @@ namespace clang {
     /// Version 4 of AST files also requires that the version control branch and
     /// revision match exactly, since there is no backward compatibility of
     /// AST files at this time.
-    const unsigned VERSION_MAJOR = 5;
+    const unsigned VERSION_MAJOR = 6;
 
     /// \brief AST file minor version number supported by this version of
     /// Clang.
@@ -562,7 +562,8 @@ namespace clang {
       /// overridden buffer.
       SM_SLOC_BUFFER_BLOB = 3,
       /// \brief Describes a source location entry (SLocEntry) for a
-      /// macro expansion.
+      /// macro expansion.  Its locations are stored with
+      /// encodeSLocEntryLocation and encodeSLocEntryEnd.
       SM_SLOC_EXPANSION_ENTRY = 4
     };
 
@@ -847,6 +847,13 @@ private:
   /// in the chain.
   unsigned TotalNumStatements;
 
+  /// \brief The number of function and method bodies attached lazily to
+  /// declarations read from the chain.
+  unsigned NumLazyBodies;
+
+  /// \brief The number of lazily-attached bodies which were then loaded.
+  unsigned NumLazyBodiesLoaded;
+
   /// \brief The number of macros de-serialized from the chain.
   unsigned NumMacrosRead;
 
@@ -881,6 +888,14 @@ private:
   /// pool within a specific module and found something.
   unsigned NumMethodPoolTableHits;
 
+  /// \brief The number of times we have looked up a name in the lookup table
+  /// of a declaration context within a specific module.
+  unsigned NumNameLookupTableLookups;
+
+  /// \brief The number of times we have looked up a name in the lookup table
+  /// of a declaration context within a specific module and found something.
+  unsigned NumNameLookupTableHits;
+
   /// \brief The total number of method pool entries in the selector table.
   unsigned TotalNumMethodPoolEntries;
 
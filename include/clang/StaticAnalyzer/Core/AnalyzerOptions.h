@@ -117,6 +117,26 @@ enum IPAKind {
   IPAK_DynamicDispatchBifurcate = 5
 };
 
+/// \brief Describes the order in which the analyzer explores the paths of a
+/// function.
+enum ExplorationStrategyKind {
+  ESK_NotSet = 0,
+
+  /// Depth-first search of the exploded graph.
+  ESK_DFS = 1,
+
+  /// Breadth-first search of the exploded graph.
+  ESK_BFS = 2,
+
+  /// Breadth-first search over basic blocks, processing the contents of each
+  /// block depth-first.
+  ESK_BFSBlockDFSContents = 3,
+
+  /// Depth-first search that prefers paths entering basic blocks which have
+  /// not been reached before in the same stack frame.
+  ESK_UnexploredFirst = 4
+};
+
 class AnalyzerOptions : public RefCountedBase<AnalyzerOptions> {
 public:
   typedef llvm::StringMap<std::string> ConfigTable;
@@ -187,6 +207,9 @@ private:
   /// Controls the mode of inter-procedural analysis.
   IPAKind IPAMode;
 
+  /// Controls the order in which paths are explored.
+  ExplorationStrategyKind ExplorationStrategy;
+
   /// Controls which C++ member functions will be considered for inlining.
   CXXInlineableMemberKind CXXMemberInliningMode;
   
@@ -266,6 +289,13 @@ public:
   /// \brief Returns the inter-procedural analysis mode.
   IPAKind getIPAMode();
 
+  /// \brief Returns the order in which the analyzer explores paths.
+  ///
+  /// This is controlled by the 'exploration-strategy' config option, which
+  /// accepts the values "dfs" (the default), "bfs", "bfs-block-dfs-contents"
+  /// and "unexplored-first". Unknown values select "dfs".
+  ExplorationStrategyKind getExplorationStrategy();
+
   /// Returns the option controlling which C++ member functions will be
   /// considered for inlining.
   ///
@@ -436,6 +466,7 @@ public:
     InliningMode(NoRedundancy),
     UserMode(UMK_NotSet),
     IPAMode(IPAK_NotSet),
+    ExplorationStrategy(ESK_NotSet),
     CXXMemberInliningMode() {}
 
 };
@@ -28,6 +28,13 @@ namespace ento {
 typedef std::deque<Decl*> SetOfDecls;
 typedef llvm::DenseSet<const Decl*> SetOfConstDecls;
 
+/// Per-function bookkeeping used by the inlining heuristics.
+///
+/// FIXME: These are not summaries of a function's effects: each call site is
+/// still analyzed by inlining the callee. Applying reusable effect summaries
+/// at call sites would need a representation of constraints and invalidated
+/// regions that is independent of the caller's ProgramState, which the
+/// analyzer does not have.
 class FunctionSummariesTy {
   class FunctionSummary {
   public:
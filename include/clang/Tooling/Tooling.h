@@ -279,6 +279,11 @@ class ClangTool {
 
   /// Runs an action over all files specified in the command line.
   ///
+  /// The files are processed one after another: every invocation shares the
+  /// tool's FileManager and runs in the compile command's directory, which
+  /// is entered with chdir(). To use several cores, run separate tool
+  /// processes over disjoint sets of source paths.
+  ///
   /// \param Action Tool action.
   int run(ToolAction *Action);
 
@@ -383,6 +383,11 @@ bool arcmt::applyTransformations(CompilerInvocation &origCI,
                          StringRef(), false, StringRef());
 }
 
+// FIXME: Each invocation migrates a single TU and merges its header edits
+// into the remapping in \p outputDir, so a project migration re-parses and
+// re-transforms shared headers once per TU, strictly in sequence.  Running TUs
+// concurrently would need a FileRemapper that can merge remappings from
+// several processes and detect conflicting edits to the same header.
 bool arcmt::migrateWithTemporaryFiles(CompilerInvocation &origCI,
                                       const FrontendInputFile &Input,
                                       DiagnosticConsumer *DiagClient,
@@ -196,7 +196,7 @@ void APValue::DestroyDataAndMakeUninit() {
   else if (Kind == ComplexInt)
     ((ComplexAPSInt*)(char*)Data.buffer)->~ComplexAPSInt();
   else if (Kind == ComplexFloat)
-    ((ComplexAPFloat*)(char*)Data.buffer)->~ComplexAPFloat();
+    delete *(ComplexAPFloat**)(char*)Data.buffer;
   else if (Kind == LValue)
     ((LV*)(char*)Data.buffer)->~LV();
   else if (Kind == Array)
@@ -221,17 +221,12 @@ bool APValue::needsCleanup() const {
   case Union:
   case Array:
   case Vector:
+  case ComplexFloat:
     return true;
   case Int:
     return getInt().needsCleanup();
   case Float:
     return getFloat().needsCleanup();
-  case ComplexFloat:
-    assert(getComplexFloatImag().needsCleanup() ==
-               getComplexFloatReal().needsCleanup() &&
-           "In _Complex float types, real and imaginary values always have the "
-           "same size.");
-    return getComplexFloatReal().needsCleanup();
   case ComplexInt:
     assert(getComplexIntImag().needsCleanup() ==
                getComplexIntReal().needsCleanup() &&
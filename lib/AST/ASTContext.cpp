@@ -749,6 +749,7 @@ ASTContext::ASTContext(LangOptions& LOpts, SourceManager &SM,
     ExternalSource(nullptr), Listener(nullptr),
     Comments(SM), CommentsLoaded(false),
     CommentCommandTraits(BumpAlloc, LOpts.CommentOpts),
+    NumConstexprCallCacheHits(0), NumConstexprCallCacheMisses(0),
     LastSDM(nullptr, 0)
 {
   TUDecl = TranslationUnitDecl::Create(*this);
@@ -823,24 +824,51 @@ void ASTContext::PrintStats() const {
     0 // Extra
   };
 
+  // Bytes allocated after the node itself, for the type classes which have
+  // trailing storage.
+  uint64_t trailingBytes[llvm::array_lengthof(counts)] = {};
+
   for (unsigned i = 0, e = Types.size(); i != e; ++i) {
     Type *T = Types[i];
     counts[(unsigned)T->getTypeClass()]++;
+    if (const FunctionProtoType *FPT = dyn_cast<FunctionProtoType>(T))
+      trailingBytes[(unsigned)T->getTypeClass()] +=
+          (FPT->getNumParams() + FPT->getNumExceptions()) * sizeof(QualType);
+    else if (const TemplateSpecializationType *TST =
+                 dyn_cast<TemplateSpecializationType>(T))
+      trailingBytes[(unsigned)T->getTypeClass()] +=
+          TST->getNumArgs() * sizeof(TemplateArgument);
   }
 
   unsigned Idx = 0;
-  unsigned TotalBytes = 0;
+  uint64_t TotalBytes = 0;
 #define TYPE(Name, Parent)                                              \
   if (counts[Idx])                                                      \
     llvm::errs() << "    " << counts[Idx] << " " << #Name               \
-                 << " types\n";                                         \
-  TotalBytes += counts[Idx] * sizeof(Name##Type);                       \
+                 << " types, "                                          \
+                 << counts[Idx] * sizeof(Name##Type) + trailingBytes[Idx] \
+                 << " bytes\n";                                         \
+  TotalBytes += counts[Idx] * sizeof(Name##Type) + trailingBytes[Idx];  \
   ++Idx;
 #define ABSTRACT_TYPE(Name, Parent)
 #include "clang/AST/TypeNodes.def"
 
   llvm::errs() << "Total bytes = " << TotalBytes << "\n";
 
+  // The uniquing tables visited most often when building types.
+  llvm::errs() << "  Uniqued types: "
+               << PointerTypes.size() << " pointer, "
+               << LValueReferenceTypes.size() << " lvalue reference, "
+               << RValueReferenceTypes.size() << " rvalue reference, "
+               << ConstantArrayTypes.size() << " constant array, "
+               << FunctionProtoTypes.size() << " function prototype, "
+               << TemplateTypeParmTypes.size() << " template parameter, "
+               << SubstTemplateTypeParmTypes.size() << " substituted parameter, "
+               << TemplateSpecializationTypes.size()
+               << " template specialization, "
+               << ElaboratedTypes.size() << " elaborated, "
+               << DependentNameTypes.size() << " dependent name\n";
+
   // Implicit special member functions.
   llvm::errs() << NumImplicitDefaultConstructorsDeclared << "/"
                << NumImplicitDefaultConstructors
@@ -863,6 +891,12 @@ void ASTContext::PrintStats() const {
                << NumImplicitDestructors
                << " implicit destructors created\n";
 
+  if (getLangOpts().ConstexprCacheSize)
+    llvm::errs() << NumConstexprCallCacheHits << "/"
+                 << (NumConstexprCallCacheHits + NumConstexprCallCacheMisses)
+                 << " constexpr calls found in the result cache ("
+                 << ConstexprCallResults.size() << " cached)\n";
+
   if (ExternalSource) {
     llvm::errs() << "\n";
     ExternalSource->PrintStats();
@@ -8020,6 +8054,7 @@ size_t ASTContext::getSideTableAllocatedMemory() const {
          llvm::capacity_in_bytes(InstantiatedFromUnnamedFieldDecl) +
          llvm::capacity_in_bytes(OverriddenMethods) +
          llvm::capacity_in_bytes(Types) +
+         llvm::capacity_in_bytes(DependentExprProfiles) +
          llvm::capacity_in_bytes(VariableArrayTypes) +
          llvm::capacity_in_bytes(ClassScopeSpecializationPattern);
 }
@@ -8115,6 +8150,26 @@ ASTContext::getMaterializedTemporaryValue(const MaterializeTemporaryExpr *E,
   return I == MaterializedTemporaryValues.end() ? nullptr : &I->second;
 }
 
+const APValue *ASTContext::getConstexprCallResult(const ConstexprCallKey &Key) {
+  if (!LangOpts.ConstexprCacheSize)
+    return nullptr;
+
+  std::map<ConstexprCallKey, APValue>::const_iterator I =
+      ConstexprCallResults.find(Key);
+  if (I == ConstexprCallResults.end()) {
+    ++NumConstexprCallCacheMisses;
+    return nullptr;
+  }
+  ++NumConstexprCallCacheHits;
+  return &I->second;
+}
+
+void ASTContext::setConstexprCallResult(const ConstexprCallKey &Key,
+                                        const APValue &Result) {
+  if (ConstexprCallResults.size() < LangOpts.ConstexprCacheSize)
+    ConstexprCallResults.insert(std::make_pair(Key, Result));
+}
+
 bool ASTContext::AtomicUsesUnsupportedLibcall(const AtomicExpr *E) const {
   const llvm::Triple &T = getTargetInfo().getTriple();
   if (!T.isOSDarwin())
@@ -8236,7 +8291,7 @@ namespace {
 
 } // end namespace
 
-ASTContext::ParentVector
+ArrayRef<ast_type_traits::DynTypedNode>
 ASTContext::getParents(const ast_type_traits::DynTypedNode &Node) {
   assert(Node.getMemoizationData() &&
          "Invariant broken: only nodes that support memoization may be "
@@ -8249,13 +8304,47 @@ ASTContext::getParents(const ast_type_traits::DynTypedNode &Node) {
   }
   ParentMap::const_iterator I = AllParents->find(Node.getMemoizationData());
   if (I == AllParents->end()) {
-    return ParentVector();
+    return None;
   }
   if (I->second.is<ast_type_traits::DynTypedNode *>()) {
-    return ParentVector(1, *I->second.get<ast_type_traits::DynTypedNode *>());
+    return *I->second.get<ast_type_traits::DynTypedNode *>();
   }
-  const auto &Parents = *I->second.get<ParentVector *>();
-  return ParentVector(Parents.begin(), Parents.end());
+  return *I->second.get<ParentVector *>();
+}
+
+namespace {
+  /// \brief Computes the layout of every complete, non-dependent record in
+  /// the translation unit.
+  class RecordLayoutPrecomputer
+      : public RecursiveASTVisitor<RecordLayoutPrecomputer> {
+    const ASTContext &Ctx;
+
+  public:
+    explicit RecordLayoutPrecomputer(const ASTContext &Ctx) : Ctx(Ctx) {}
+
+    bool shouldVisitTemplateInstantiations() const { return true; }
+    bool shouldVisitImplicitCode() const { return true; }
+
+    bool VisitRecordDecl(RecordDecl *RD) {
+      if (RD->isCompleteDefinition() && !RD->isInvalidDecl() &&
+          !RD->isDependentContext())
+        Ctx.getASTRecordLayout(RD);
+      return true;
+    }
+  };
+}
+
+void ASTContext::prepareForConcurrentReads() {
+  if (!CommentsLoaded && ExternalSource) {
+    ExternalSource->ReadComments();
+    CommentsLoaded = true;
+  }
+
+  if (!AllParents)
+    AllParents.reset(
+        ParentMapASTVisitor::buildMap(*getTranslationUnitDecl()));
+
+  RecordLayoutPrecomputer(*this).TraverseDecl(getTranslationUnitDecl());
 }
 
 bool
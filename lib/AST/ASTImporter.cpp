@@ -205,6 +205,17 @@ namespace {
     /// \brief Declaration (from, to) pairs that are known not to be equivalent
     /// (which we have already complained about).
     llvm::DenseSet<std::pair<Decl *, Decl *> > &NonEquivalentDecls;
+
+    /// \brief Declaration (from, to) pairs that are known to be equivalent,
+    /// if the caller keeps track of them.
+    llvm::DenseSet<std::pair<Decl *, Decl *> > *EquivalentDecls;
+
+    /// \brief Whether every tentative equivalence checked so far compared
+    /// complete definitions, so that a successful check can be remembered in
+    /// \c EquivalentDecls.  A tag without a definition is assumed to be
+    /// equivalent to anything, which may stop being true once the tag is
+    /// defined.
+    bool CanRememberEquivalences;
     
     /// \brief Whether we're being strict about the spelling of types when 
     /// unifying two types.
@@ -219,8 +230,11 @@ namespace {
     StructuralEquivalenceContext(ASTContext &C1, ASTContext &C2,
                llvm::DenseSet<std::pair<Decl *, Decl *> > &NonEquivalentDecls,
                                  bool StrictTypeSpelling = false,
-                                 bool Complain = true)
+                                 bool Complain = true,
+               llvm::DenseSet<std::pair<Decl *, Decl *> > *EquivalentDecls
+                                   = nullptr)
       : C1(C1), C2(C2), NonEquivalentDecls(NonEquivalentDecls),
+        EquivalentDecls(EquivalentDecls), CanRememberEquivalences(true),
         StrictTypeSpelling(StrictTypeSpelling), Complain(Complain),
         LastDiagFromC2(false) {}
 
@@ -1276,6 +1290,12 @@ static bool IsStructurallyEquivalent(StructuralEquivalenceContext &Context,
   if (Context.NonEquivalentDecls.count(std::make_pair(D1->getCanonicalDecl(),
                                                       D2->getCanonicalDecl())))
     return false;
+
+  // Check whether an earlier comparison found them to be equivalent.
+  if (Context.EquivalentDecls &&
+      Context.EquivalentDecls->count(std::make_pair(D1->getCanonicalDecl(),
+                                                    D2->getCanonicalDecl())))
+    return true;
   
   // Determine whether we've already produced a tentative equivalence for D1.
   Decl *&EquivToD1 = Context.TentativeEquivalences[D1->getCanonicalDecl()];
@@ -1312,6 +1332,15 @@ bool StructuralEquivalenceContext::Finish() {
     
     Decl *D2 = TentativeEquivalences[D1];
     assert(D2 && "Unrecorded tentative equivalence?");
+
+    if (TagDecl *Tag1 = dyn_cast<TagDecl>(D1)) {
+      if (TagDecl *Tag2 = dyn_cast<TagDecl>(D2)) {
+        TagDecl *Def1 = Tag1->getDefinition();
+        TagDecl *Def2 = Tag2->getDefinition();
+        if (!Def1 || !Def2 || Def1->isBeingDefined() || Def2->isBeingDefined())
+          CanRememberEquivalences = false;
+      }
+    }
     
     bool Equivalent = true;
     
@@ -1411,6 +1440,15 @@ bool StructuralEquivalenceContext::Finish() {
     }
     // FIXME: Check other declaration kinds!
   }
+
+  // All of the tentative equivalences held up.
+  if (EquivalentDecls && CanRememberEquivalences) {
+    for (llvm::DenseMap<Decl *, Decl *>::iterator
+             I = TentativeEquivalences.begin(),
+             E = TentativeEquivalences.end();
+         I != E; ++I)
+      EquivalentDecls->insert(*I);
+  }
   
   return false;
 }
@@ -2172,7 +2210,8 @@ bool ASTNodeImporter::IsStructuralMatch(RecordDecl *FromRecord,
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    ToRecord->getASTContext(),
                                    Importer.getNonEquivalentDecls(),
-                                   false, Complain);
+                                   false, Complain,
+                                   &Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(FromRecord, ToRecord);
 }
 
@@ -2180,14 +2219,17 @@ bool ASTNodeImporter::IsStructuralMatch(VarDecl *FromVar, VarDecl *ToVar,
                                         bool Complain) {
   StructuralEquivalenceContext Ctx(
       Importer.getFromContext(), Importer.getToContext(),
-      Importer.getNonEquivalentDecls(), false, Complain);
+      Importer.getNonEquivalentDecls(), false, Complain,
+      &Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(FromVar, ToVar);
 }
 
 bool ASTNodeImporter::IsStructuralMatch(EnumDecl *FromEnum, EnumDecl *ToEnum) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   false, true,
+                                   &Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(FromEnum, ToEnum);
 }
 
@@ -2206,7 +2248,9 @@ bool ASTNodeImporter::IsStructuralMatch(ClassTemplateDecl *From,
                                         ClassTemplateDecl *To) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   false, true,
+                                   &Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(From, To);  
 }
 
@@ -2214,7 +2258,9 @@ bool ASTNodeImporter::IsStructuralMatch(VarTemplateDecl *From,
                                         VarTemplateDecl *To) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   false, true,
+                                   &Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(From, To);
 }
 
@@ -5105,6 +5151,6 @@ bool ASTImporter::IsStructurallyEquivalent(QualType From, QualType To,
     return true;
       
   StructuralEquivalenceContext Ctx(FromContext, ToContext, NonEquivalentDecls,
-                                   false, Complain);
+                                   false, Complain, &EquivalentDecls);
   return Ctx.IsStructurallyEquivalent(From, To);
 }
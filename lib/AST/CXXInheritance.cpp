@@ -73,7 +73,27 @@ void CXXBasePaths::swap(CXXBasePaths &Other) {
   std::swap(DetectedVirtual, Other.DetectedVirtual);
 }
 
+/// \brief Determine whether \p Base (which must be canonical) is a virtual
+/// base class of \p Record, using the flattened list of virtual bases that
+/// is computed once when the bases are set, rather than walking the
+/// inheritance graph.
+static bool isVirtualBaseOf(const CXXRecordDecl *Record,
+                            const CXXRecordDecl *Base) {
+  for (const auto &VBase : Record->vbases()) {
+    const CXXRecordDecl *VBaseDecl = VBase.getType()->getAsCXXRecordDecl();
+    if (VBaseDecl && VBaseDecl->getCanonicalDecl() == Base)
+      return true;
+  }
+  return false;
+}
+
 bool CXXRecordDecl::isDerivedFrom(const CXXRecordDecl *Base) const {
+  // Any virtual base is also a base; in deep hierarchies that share their
+  // interfaces virtually this avoids the full walk below.
+  if (getNumVBases() && getCanonicalDecl() != Base->getCanonicalDecl() &&
+      isVirtualBaseOf(this, Base->getCanonicalDecl()))
+    return true;
+
   CXXBasePaths Paths(/*FindAmbiguities=*/false, /*RecordPaths=*/false,
                      /*DetectVirtual=*/false);
   return isDerivedFrom(Base, Paths);
@@ -94,18 +114,13 @@ bool CXXRecordDecl::isVirtuallyDerivedFrom(const CXXRecordDecl *Base) const {
   if (!getNumVBases())
     return false;
 
-  CXXBasePaths Paths(/*FindAmbiguities=*/false, /*RecordPaths=*/false,
-                     /*DetectVirtual=*/false);
-
   if (getCanonicalDecl() == Base->getCanonicalDecl())
     return false;
-  
-  Paths.setOrigin(const_cast<CXXRecordDecl*>(this));
 
-  const void *BasePtr = static_cast<const void*>(Base->getCanonicalDecl());
-  return lookupInBases(&FindVirtualBaseClass,
-                       const_cast<void *>(BasePtr),
-                       Paths);
+  // The virtual bases of this class, direct or indirect, have already been
+  // collected (with dependent bases skipped, as lookupInBases does), so
+  // there's no need to search the inheritance graph.
+  return isVirtualBaseOf(this, Base->getCanonicalDecl());
 }
 
 static bool BaseIsNot(const CXXRecordDecl *Base, void *OpaqueTarget) {
@@ -29,11 +29,18 @@
 #include "clang/Basic/Module.h"
 #include "clang/Basic/Specifiers.h"
 #include "clang/Basic/TargetInfo.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/ErrorHandling.h"
 #include <algorithm>
 
 using namespace clang;
 
+#define DEBUG_TYPE "decl-linkage"
+
+STATISTIC(NumLVComputations, "Number of linkage and visibility computations");
+STATISTIC(NumCachedLinkageHits,
+          "Number of linkage-only queries answered from the cached linkage");
+
 Decl *clang::getPrimaryMergedDecl(Decl *D) {
   return D->getASTContext().getPrimaryMergedDecl(D);
 }
@@ -192,6 +199,11 @@ static Visibility getVisibilityFromAttr(const T *attr) {
 /// Return the explicit visibility of the given declaration.
 static Optional<Visibility> getVisibilityOf(const NamedDecl *D,
                                     NamedDecl::ExplicitVisibilityKind kind) {
+  // Explicit visibility only ever comes from attributes, and most
+  // declarations have none; don't go looking for the target below.
+  if (!D->hasAttrs())
+    return None;
+
   // If we're ultimately computing the visibility of a type, look for
   // a 'type_visibility' attribute before looking for 'visibility'.
   if (kind == NamedDecl::VisibilityForType) {
@@ -1284,9 +1296,12 @@ class LinkageComputer {
 public:
   static LinkageInfo getLVForDecl(const NamedDecl *D,
                                   LVComputationKind computation) {
-    if (computation == LVForLinkageOnly && D->hasCachedLinkage())
+    if (computation == LVForLinkageOnly && D->hasCachedLinkage()) {
+      ++NumCachedLinkageHits;
       return LinkageInfo(D->getCachedLinkage(), DefaultVisibility, false);
+    }
 
+    ++NumLVComputations;
     LinkageInfo LV = computeLVForDecl(D, computation);
     if (D->hasCachedLinkage())
       assert(D->getCachedLinkage() == LV.getLinkage());
@@ -36,6 +36,7 @@
 #include "clang/AST/APValue.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTDiagnostic.h"
+#include "clang/AST/Attr.h"
 #include "clang/AST/CharUnits.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/RecordLayout.h"
@@ -442,6 +443,13 @@ namespace {
     /// evaluation frame.
     llvm::SmallVector<Cleanup, 16> CleanupStack;
 
+    /// The results of earlier calls to constexpr functions which take and
+    /// return only integers, keyed by the callee and the argument values.
+    /// Such calls cannot depend on anything but their arguments, so repeated
+    /// calls (for instance, from naive recursion) need not be re-evaluated.
+    typedef ASTContext::ConstexprCallKey CallResultKey;
+    std::map<CallResultKey, APValue> CallResults;
+
     /// EvaluatingDecl - This is the declaration whose initializer is being
     /// evaluated, if any.
     APValue::LValueBase EvaluatingDecl;
@@ -454,6 +462,11 @@ namespace {
     /// notes attached to it will also be stored, otherwise they will not be.
     bool HasActiveDiagnostic;
 
+    /// NumDiagnosedSteps - The number of times the evaluation has hit
+    /// something that is not a core constant expression, including those for
+    /// which no note was stored because an earlier one was kept instead.
+    unsigned NumDiagnosedSteps;
+
     enum EvaluationMode {
       /// Evaluate as a constant expression. Stop if we find that the expression
       /// is not a constant expression.
@@ -514,7 +527,7 @@ namespace {
         BottomFrame(*this, SourceLocation(), nullptr, nullptr, nullptr),
         EvaluatingDecl((const ValueDecl *)nullptr),
         EvaluatingDeclValue(nullptr), HasActiveDiagnostic(false),
-        EvalMode(Mode) {}
+        NumDiagnosedSteps(0), EvalMode(Mode) {}
 
     void setEvaluatingDecl(APValue::LValueBase Base, APValue &Value) {
       EvaluatingDecl = Base;
@@ -575,6 +588,7 @@ namespace {
     OptionalDiagnostic Diag(SourceLocation Loc, diag::kind DiagId
                               = diag::note_invalid_subexpr_in_const_expr,
                             unsigned ExtraNotes = 0) {
+      ++NumDiagnosedSteps;
       if (EvalStatus.Diag) {
         // If we have a prior diagnostic, it will be noting that the expression
         // isn't a constant expression. This diagnostic is more important,
@@ -624,6 +638,7 @@ namespace {
                             unsigned ExtraNotes = 0) {
       if (EvalStatus.Diag)
         return Diag(E->getExprLoc(), DiagId, ExtraNotes);
+      ++NumDiagnosedSteps;
       HasActiveDiagnostic = false;
       return OptionalDiagnostic();
     }
@@ -640,6 +655,7 @@ namespace {
       // Don't override a previous diagnostic. Don't bother collecting
       // diagnostics if we're evaluating for overflow.
       if (!EvalStatus.Diag || !EvalStatus.Diag->empty()) {
+        ++NumDiagnosedSteps;
         HasActiveDiagnostic = false;
         return OptionalDiagnostic();
       }
@@ -3605,6 +3621,32 @@ static bool EvaluateArgs(ArrayRef<const Expr*> Args, ArgVector &ArgValues,
   return Success;
 }
 
+/// Build the key under which the result of calling \p Callee with the given
+/// arguments is memoized. Returns false if the call is not a candidate for
+/// memoization: only non-member calls whose arguments and result are all
+/// integers are, since those are the only ones we can be sure do not observe
+/// or modify state outside the call.
+static bool getCallResultKey(const FunctionDecl *Callee, const LValue *This,
+                             ArrayRef<APValue> ArgValues, EvalInfo &Info,
+                             EvalInfo::CallResultKey &Key) {
+  if (This || Info.checkingPotentialConstantExpression() ||
+      Info.checkingForOverflow() ||
+      !Callee->getReturnType()->isIntegralOrEnumerationType())
+    return false;
+
+  Key.first = Callee;
+  for (unsigned I = 0, N = ArgValues.size(); I != N; ++I) {
+    if (!ArgValues[I].isInt())
+      return false;
+    const APSInt &Value = ArgValues[I].getInt();
+    Key.second.push_back((uint64_t)Value.getBitWidth() << 1 |
+                         Value.isUnsigned());
+    Key.second.append(Value.getRawData(),
+                      Value.getRawData() + Value.getNumWords());
+  }
+  return true;
+}
+
 /// Evaluate a function call.
 static bool HandleFunctionCall(SourceLocation CallLoc,
                                const FunctionDecl *Callee, const LValue *This,
@@ -3617,6 +3659,23 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
   if (!Info.CheckCallLimit(CallLoc))
     return false;
 
+  EvalInfo::CallResultKey Key;
+  bool Memoize = getCallResultKey(Callee, This, ArgValues, Info, Key);
+  if (Memoize) {
+    std::map<EvalInfo::CallResultKey, APValue>::iterator Known =
+        Info.CallResults.find(Key);
+    if (Known != Info.CallResults.end()) {
+      Result = Known->second;
+      return true;
+    }
+    if (const APValue *Cached = Info.Ctx.getConstexprCallResult(Key)) {
+      Result = *Cached;
+      return true;
+    }
+  }
+  unsigned NumDiags = Info.EvalStatus.Diag ? Info.EvalStatus.Diag->size() : 0;
+  unsigned NumDiagnosedSteps = Info.NumDiagnosedSteps;
+
   CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
 
   // For a trivial copy or move assignment, perform an APValue copy. This is
@@ -3645,7 +3704,23 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
       return true;
     Info.Diag(Callee->getLocEnd(), diag::note_constexpr_no_return);
   }
-  return ESR == ESR_Returned;
+  if (ESR != ESR_Returned)
+    return false;
+
+  // Only remember results which were computed cleanly; a call that produced
+  // notes or side-effects must be re-evaluated so that they are seen again.
+  if (Memoize && Result.isInt() && !Info.EvalStatus.HasSideEffects &&
+      (!Info.EvalStatus.Diag || Info.EvalStatus.Diag->size() == NumDiags)) {
+    Info.CallResults[Key] = Result;
+
+    // If nothing in the call itself was diagnosed, it was a core constant
+    // expression, and its value is the same in any later evaluation, whatever
+    // the evaluation mode.  Problems found elsewhere in this evaluation don't
+    // matter.
+    if (Info.NumDiagnosedSteps == NumDiagnosedSteps)
+      Info.Ctx.setConstexprCallResult(Key, Result);
+  }
+  return true;
 }
 
 /// Evaluate a constructor call.
@@ -5969,7 +6044,63 @@ QualType IntExprEvaluator::GetObjectType(APValue::LValueBase B) {
   return QualType();
 }
 
+/// If \p Call is a call to a function with the alloc_size attribute whose
+/// size arguments are constant, compute the size of the object it allocates.
+static bool getAllocSizeOfCall(const ASTContext &Ctx, const CallExpr *Call,
+                               CharUnits &Size) {
+  const FunctionDecl *Callee = Call->getDirectCallee();
+  if (!Callee || isa<CXXOperatorCallExpr>(Call))
+    return false;
+  const AllocSizeAttr *AllocSize = Callee->getAttr<AllocSizeAttr>();
+  if (!AllocSize)
+    return false;
+
+  auto EvaluateSizeArg = [&](unsigned ParamIdx, llvm::APInt &Result) {
+    if (ParamIdx == 0 || ParamIdx > Call->getNumArgs())
+      return false;
+    APSInt Value;
+    if (!Call->getArg(ParamIdx - 1)->EvaluateAsInt(Value, Ctx) ||
+        (Value.isSigned() && Value.isNegative()))
+      return false;
+    Result = Value.zextOrTrunc(64);
+    return true;
+  };
+
+  llvm::APInt Bytes, NumElems(64, 1);
+  if (!EvaluateSizeArg(AllocSize->getElemSizeParam(), Bytes))
+    return false;
+  if (AllocSize->getNumElemsParam() &&
+      !EvaluateSizeArg(AllocSize->getNumElemsParam(), NumElems))
+    return false;
+
+  bool Overflow;
+  Bytes = Bytes.umul_ov(NumElems, Overflow);
+  if (Overflow || Bytes.isNegative())
+    return false;
+  Size = CharUnits::fromQuantity(Bytes.getZExtValue());
+  return true;
+}
+
 bool IntExprEvaluator::TryEvaluateBuiltinObjectSize(const CallExpr *E) {
+  // A const local pointer initialized by a call to an allocation function
+  // annotated with alloc_size points to the start of an object of the size
+  // given by the call's arguments. A call used directly as the operand is not
+  // handled here: it has side-effects, and so gets the same unknown size as
+  // any other operand with side-effects.
+  CharUnits AllocSize;
+  if (const DeclRefExpr *DRE =
+          dyn_cast<DeclRefExpr>(E->getArg(0)->IgnoreParenCasts())) {
+    const VarDecl *VD = dyn_cast<VarDecl>(DRE->getDecl());
+    if (VD && !isa<ParmVarDecl>(VD) && VD->hasLocalStorage() &&
+        VD->getType().isConstQualified() &&
+        !VD->getType().isVolatileQualified() &&
+        VD->getType()->isPointerType() && VD->getInit())
+      if (const CallExpr *Alloc =
+              dyn_cast<CallExpr>(VD->getInit()->IgnoreParenCasts()))
+        if (getAllocSizeOfCall(Info.Ctx, Alloc, AllocSize))
+          return Success(AllocSize, E);
+  }
+
   LValue Base;
 
   {
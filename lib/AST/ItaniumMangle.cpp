@@ -247,6 +247,12 @@ class CXXNameMangler {
 
   } FunctionTypeDepth;
 
+  /// The substitution candidates seen so far in this name.
+  ///
+  /// The encoding of every component depends on which candidates precede it
+  /// in the same name, so a mangled prefix cannot be cached and reused for
+  /// another name; only whole names are cached, by the clients of
+  /// MangleContext (see CodeGenModule::getMangledName).
   llvm::DenseMap<uintptr_t, unsigned> Substitutions;
 
   ASTContext &getASTContext() const { return Context.getASTContext(); }
@@ -215,6 +215,12 @@ void RawCommentList::addComment(const RawComment &RC,
   if (RC.isInvalid())
     return;
 
+  // Ordinary comments are not interesting for us.  They are never added to
+  // the list, so they can't break its ordering either: bail out before
+  // comparing source locations, since they are the vast majority of comments.
+  if (RC.isOrdinary())
+    return;
+
   // Check if the comments are not in source order.
   while (!Comments.empty() &&
          !SourceMgr.isBeforeInTranslationUnit(Comments.back()->getLocStart(),
@@ -224,10 +230,6 @@ void RawCommentList::addComment(const RawComment &RC,
     Comments.pop_back();
   }
 
-  // Ordinary comments are not interesting for us.
-  if (RC.isOrdinary())
-    return;
-
   // If this is the first Doxygen comment, save it (because there isn't
   // anything to merge it with).
   if (Comments.empty()) {
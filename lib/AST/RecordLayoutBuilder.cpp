@@ -2783,6 +2783,11 @@ ASTContext::getASTRecordLayout(const RecordDecl *D) const {
   const ASTRecordLayout *Entry = ASTRecordLayouts[D];
   if (Entry) return *Entry;
 
+  // FIXME: Records loaded from a PCH or module are laid out again in every
+  // translation unit that uses them. The AST file could carry the layouts
+  // computed when it was built (they depend only on the target, which is
+  // already validated on load) and hand them back through
+  // ExternalASTSource::layoutRecordType, as LLDB does for its own ASTs.
   const ASTRecordLayout *NewEntry = nullptr;
 
   if (isMsLayout(D) && !D->getASTContext().getExternalSource()) {
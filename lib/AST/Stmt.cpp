@@ -27,6 +27,11 @@
 #include "llvm/Support/raw_ostream.h"
 using namespace clang;
 
+// The bit-fields, including the name location DeclRefExpr may keep there,
+// must not make every statement bigger than a pointer.
+static_assert(sizeof(Stmt) == sizeof(void *),
+              "Stmt bit-fields do not fit in a pointer");
+
 static struct StmtClassNameTable {
   const char *Name;
   unsigned Counter;
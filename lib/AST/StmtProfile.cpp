@@ -1412,8 +1412,34 @@ void StmtProfiler::VisitTemplateArgument(const TemplateArgument &Arg) {
   }
 }
 
+static void addProfile(llvm::FoldingSetNodeID &ID,
+                       llvm::FoldingSetNodeIDRef Profile) {
+  for (unsigned I = 0, N = Profile.getSize(); I != N; ++I)
+    ID.AddInteger(Profile.getData()[I]);
+}
+
 void Stmt::Profile(llvm::FoldingSetNodeID &ID, const ASTContext &Context,
                    bool Canonical) const {
-  StmtProfiler Profiler(ID, Context, Canonical);
+  // Instantiation-dependent expressions get profiled over and over again as
+  // the FoldingSets of dependent types and template arguments are probed,
+  // and their canonical profile can't change, so remember it.
+  const Expr *E = dyn_cast<Expr>(this);
+  if (!Canonical || !E || !E->isInstantiationDependent()) {
+    StmtProfiler Profiler(ID, Context, Canonical);
+    Profiler.Visit(this);
+    return;
+  }
+
+  auto Known = Context.DependentExprProfiles.find(this);
+  if (Known != Context.DependentExprProfiles.end()) {
+    addProfile(ID, Known->second);
+    return;
+  }
+
+  llvm::FoldingSetNodeID ExprID;
+  StmtProfiler Profiler(ExprID, Context, Canonical);
   Profiler.Visit(this);
+  llvm::FoldingSetNodeIDRef Profile = ExprID.Intern(Context.getAllocator());
+  Context.DependentExprProfiles[this] = Profile;
+  addProfile(ID, Profile);
 }
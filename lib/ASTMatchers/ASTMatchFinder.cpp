@@ -20,9 +20,18 @@
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/RecursiveASTVisitor.h"
+#include "llvm/ADT/Statistic.h"
 #include <deque>
 #include <set>
 
+#define DEBUG_TYPE "ast-matchers"
+
+STATISTIC(NumMemoizationHits, "Number of traversal matches found in the cache");
+STATISTIC(NumMemoizationMisses,
+          "Number of traversal matches not found in the cache");
+STATISTIC(NumMemoizationFlushes,
+          "Number of times the match result cache was cleared");
+
 namespace clang {
 namespace ast_matchers {
 namespace internal {
@@ -295,7 +304,26 @@ public:
   MatchASTVisitor(
       std::vector<std::pair<internal::DynTypedMatcher, MatchCallback *> > *
           MatcherCallbackPairs)
-      : MatcherCallbackPairs(MatcherCallbackPairs), ActiveASTContext(nullptr) {}
+      : MatcherCallbackPairs(MatcherCallbackPairs), ActiveASTContext(nullptr) {
+    for (std::vector<std::pair<internal::DynTypedMatcher,
+                               MatchCallback *> >::const_iterator
+             I = MatcherCallbackPairs->begin(),
+             E = MatcherCallbackPairs->end();
+         I != E; ++I) {
+      if (I->first.canConvertTo<Decl>())
+        MatchersByKind[MK_Decl].push_back(&*I);
+      else if (I->first.canConvertTo<Stmt>())
+        MatchersByKind[MK_Stmt].push_back(&*I);
+      else if (I->first.canConvertTo<QualType>())
+        MatchersByKind[MK_QualType].push_back(&*I);
+      else if (I->first.canConvertTo<TypeLoc>())
+        MatchersByKind[MK_TypeLoc].push_back(&*I);
+      else if (I->first.canConvertTo<NestedNameSpecifier>())
+        MatchersByKind[MK_NestedNameSpecifier].push_back(&*I);
+      else if (I->first.canConvertTo<NestedNameSpecifierLoc>())
+        MatchersByKind[MK_NestedNameSpecifierLoc].push_back(&*I);
+    }
+  }
 
   void onStartOfTranslationUnit() {
     for (std::vector<std::pair<internal::DynTypedMatcher,
@@ -384,9 +412,11 @@ public:
 
     MemoizationMap::iterator I = ResultCache.find(Key);
     if (I != ResultCache.end()) {
+      ++NumMemoizationHits;
       *Builder = I->second.Nodes;
       return I->second.ResultOfMatch;
     }
+    ++NumMemoizationMisses;
 
     MemoizedMatchResult Result;
     Result.Nodes = *Builder;
@@ -417,8 +447,10 @@ public:
                       BoundNodesTreeBuilder *Builder,
                       TraversalKind Traversal,
                       BindKind Bind) override {
-    if (ResultCache.size() > MaxMemoizationEntries)
+    if (ResultCache.size() > MaxMemoizationEntries) {
+      ++NumMemoizationFlushes;
       ResultCache.clear();
+    }
     return memoizedMatchesRecursively(Node, Matcher, Builder, 1, Traversal,
                                       Bind);
   }
@@ -427,8 +459,10 @@ public:
                            const DynTypedMatcher &Matcher,
                            BoundNodesTreeBuilder *Builder,
                            BindKind Bind) override {
-    if (ResultCache.size() > MaxMemoizationEntries)
+    if (ResultCache.size() > MaxMemoizationEntries) {
+      ++NumMemoizationFlushes;
       ResultCache.clear();
+    }
     return memoizedMatchesRecursively(Node, Matcher, Builder, INT_MAX,
                                       TK_AsIs, Bind);
   }
@@ -439,8 +473,10 @@ public:
                          AncestorMatchMode MatchMode) override {
     // Reset the cache outside of the recursive call to make sure we
     // don't invalidate any iterators.
-    if (ResultCache.size() > MaxMemoizationEntries)
+    if (ResultCache.size() > MaxMemoizationEntries) {
+      ++NumMemoizationFlushes;
       ResultCache.clear();
+    }
     return memoizedMatchesAncestorOfRecursively(Node, Matcher, Builder,
                                                 MatchMode);
   }
@@ -453,16 +489,23 @@ public:
              I = MatcherCallbackPairs->begin(),
              E = MatcherCallbackPairs->end();
          I != E; ++I) {
-      BoundNodesTreeBuilder Builder;
-      if (I->first.matches(Node, this, &Builder)) {
-        MatchVisitor Visitor(ActiveASTContext, I->second);
-        Builder.visitMatches(&Visitor);
-      }
+      matchWithCallback(I->first, I->second, Node);
     }
   }
 
+  // Only tries the matchers registered for the kind of \p Node, as the
+  // others can never match it.
   template <typename T> void match(const T &Node) {
-    match(ast_type_traits::DynTypedNode::create(Node));
+    const std::vector<const MatcherCallbackPair *> &Matchers =
+        MatchersByKind[getMatcherKind(Node)];
+    ast_type_traits::DynTypedNode DynNode =
+        ast_type_traits::DynTypedNode::create(Node);
+    for (std::vector<const MatcherCallbackPair *>::const_iterator
+             I = Matchers.begin(),
+             E = Matchers.end();
+         I != E; ++I) {
+      matchWithCallback((*I)->first, (*I)->second, DynNode);
+    }
   }
 
   // Implements ASTMatchFinder::getASTContext.
@@ -475,6 +518,42 @@ public:
   bool shouldUseDataRecursionFor(clang::Stmt *S) const { return false; }
 
 private:
+  typedef std::pair<internal::DynTypedMatcher, MatchCallback *>
+      MatcherCallbackPair;
+
+  // The kinds of nodes the visitor passes to match().
+  enum MatcherKind {
+    MK_Decl,
+    MK_Stmt,
+    MK_QualType,
+    MK_TypeLoc,
+    MK_NestedNameSpecifier,
+    MK_NestedNameSpecifierLoc,
+    MK_NumKinds
+  };
+
+  static MatcherKind getMatcherKind(const Decl &) { return MK_Decl; }
+  static MatcherKind getMatcherKind(const Stmt &) { return MK_Stmt; }
+  static MatcherKind getMatcherKind(const QualType &) { return MK_QualType; }
+  static MatcherKind getMatcherKind(const TypeLoc &) { return MK_TypeLoc; }
+  static MatcherKind getMatcherKind(const NestedNameSpecifier &) {
+    return MK_NestedNameSpecifier;
+  }
+  static MatcherKind getMatcherKind(const NestedNameSpecifierLoc &) {
+    return MK_NestedNameSpecifierLoc;
+  }
+
+  // Runs \p Matcher on \p Node and calls \p Callback for every match.
+  void matchWithCallback(const internal::DynTypedMatcher &Matcher,
+                         MatchCallback *Callback,
+                         const ast_type_traits::DynTypedNode &Node) {
+    BoundNodesTreeBuilder Builder;
+    if (Matcher.matches(Node, this, &Builder)) {
+      MatchVisitor Visitor(ActiveASTContext, Callback);
+      Builder.visitMatches(&Visitor);
+    }
+  }
+
   // Returns whether an ancestor of \p Node matches \p Matcher.
   //
   // The order of matching ((which can lead to different nodes being bound in
@@ -497,7 +576,8 @@ private:
     assert(Node.getMemoizationData() &&
            "Invariant broken: only nodes that support memoization may be "
            "used in the parent map.");
-    ASTContext::ParentVector Parents = ActiveASTContext->getParents(Node);
+    ArrayRef<ast_type_traits::DynTypedNode> Parents =
+        ActiveASTContext->getParents(Node);
     if (Parents.empty()) {
       assert(false && "Found node that is not in the parent map.");
       return false;
@@ -511,9 +591,11 @@ private:
     // calls to match might invalidate the result cache iterators.
     MemoizationMap::iterator I = ResultCache.find(Key);
     if (I != ResultCache.end()) {
+      ++NumMemoizationHits;
       *Builder = I->second.Nodes;
       return I->second.ResultOfMatch;
     }
+    ++NumMemoizationMisses;
     MemoizedMatchResult Result;
     Result.ResultOfMatch = false;
     Result.Nodes = *Builder;
@@ -543,10 +625,10 @@ private:
           break;
         }
         if (MatchMode != ASTMatchFinder::AMM_ParentOnly) {
-          ASTContext::ParentVector Ancestors =
+          ArrayRef<ast_type_traits::DynTypedNode> Ancestors =
               ActiveASTContext->getParents(Queue.front());
-          for (ASTContext::ParentVector::const_iterator I = Ancestors.begin(),
-                                                        E = Ancestors.end();
+          for (ArrayRef<ast_type_traits::DynTypedNode>::iterator
+                   I = Ancestors.begin(), E = Ancestors.end();
                I != E; ++I) {
             // Make sure we do not visit the same node twice.
             // Otherwise, we'll visit the common ancestors as often as there
@@ -604,6 +686,9 @@ private:
 
   std::vector<std::pair<internal::DynTypedMatcher, MatchCallback *> > *const
   MatcherCallbackPairs;
+  // The entries of MatcherCallbackPairs, grouped by the kind of node they can
+  // match, in registration order.
+  std::vector<const MatcherCallbackPair *> MatchersByKind[MK_NumKinds];
   ASTContext *ActiveASTContext;
 
   // Maps a canonical type to its TypedefDecls.
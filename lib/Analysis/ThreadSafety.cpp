@@ -592,14 +592,16 @@ public:
       unsigned ni = NodeVec[i].arity();
       unsigned nj = Other.NodeVec[j].arity();
       unsigned n = (ni < nj) ? ni : nj;
-      bool Result = true;
       unsigned ci = i+1;  // first child of i
       unsigned cj = j+1;  // first child of j
       for (unsigned k = 0; k < n;
            ++k, ci=getNextSibling(ci), cj = Other.getNextSibling(cj)) {
-        Result = Result && matches(Other, ci, cj);
+        // Stop at the first mismatch; finding the next sibling walks the
+        // whole subtree.
+        if (!matches(Other, ci, cj))
+          return false;
       }
-      return Result;
+      return true;
     }
     return false;
   }
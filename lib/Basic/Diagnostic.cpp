@@ -118,6 +118,7 @@ void DiagnosticsEngine::Reset() {
   // through command-line.
   DiagStates.push_back(DiagState());
   DiagStatePoints.push_back(DiagStatePoint(&DiagStates.back(), FullSourceLoc()));
+  LastStateQueryNumPoints = 0;
 }
 
 void DiagnosticsEngine::SetDelayedDiagnostic(unsigned DiagID, StringRef Arg1,
@@ -152,10 +153,25 @@ DiagnosticsEngine::GetDiagStatePointForLoc(SourceLocation L) const {
 
   DiagStatePointsTy::iterator Pos = DiagStatePoints.end();
   FullSourceLoc LastStateChangePos = DiagStatePoints.back().Loc;
-  if (LastStateChangePos.isValid() &&
-      Loc.isBeforeInTranslationUnitThan(LastStateChangePos))
-    Pos = std::upper_bound(DiagStatePoints.begin(), DiagStatePoints.end(),
-                           DiagStatePoint(nullptr, Loc));
+  if (LastStateChangePos.isValid()) {
+    // Offsets within a FileID are ordered the same way as the translation
+    // unit, so anything at or after a location already known to follow the
+    // last state change also follows it.
+    std::pair<FileID, unsigned> Decomposed = Loc.getDecomposedLoc();
+    if (LastStateQueryNumPoints == DiagStatePoints.size() &&
+        Decomposed.first == LastStateQueryFID &&
+        Decomposed.second >= LastStateQueryOffset)
+      return Pos - 1;
+
+    if (Loc.isBeforeInTranslationUnitThan(LastStateChangePos))
+      Pos = std::upper_bound(DiagStatePoints.begin(), DiagStatePoints.end(),
+                             DiagStatePoint(nullptr, Loc));
+    else {
+      LastStateQueryFID = Decomposed.first;
+      LastStateQueryOffset = Decomposed.second;
+      LastStateQueryNumPoints = DiagStatePoints.size();
+    }
+  }
   --Pos;
   return Pos;
 }
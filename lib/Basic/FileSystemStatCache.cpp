@@ -13,7 +13,11 @@
 
 #include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/VirtualFileSystem.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 
 // FIXME: This is terrible, we need this for ::close.
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
@@ -136,3 +140,168 @@ MemorizeStatCalls::getStat(const char *Path, FileData &Data, bool isFile,
 
   return Result;
 }
+
+/// The first line of a saved stat cache, followed by a space and the epoch.
+static const char PersistentStatCacheMagic[] = "CLANG-STAT-CACHE-2";
+
+PersistentStatCache *PersistentStatCache::load(StringRef Path,
+                                               StringRef Epoch) {
+  PersistentStatCache *Cache = new PersistentStatCache(Epoch);
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> FileOrErr =
+      llvm::MemoryBuffer::getFile(Path);
+  if (!FileOrErr)
+    return Cache;
+
+  // The file contains one entry per line.  Existing paths are written as
+  //   + <device> <inode> <size> <mtime> <isdir> <ispipe> <isvfsmapped> <path>
+  // paths that are not files as
+  //   f <path>
+  // and paths that are not directories as
+  //   d <path>
+  SmallVector<StringRef, 64> Lines;
+  FileOrErr.get()->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  if (Lines.empty() ||
+      Lines[0] != (Twine(PersistentStatCacheMagic) + " " + Epoch).str())
+    return Cache;
+
+  for (unsigned I = 1, E = Lines.size(); I != E; ++I) {
+    StringRef Line = Lines[I];
+    if (Line.size() < 3 || Line[1] != ' ' ||
+        (Line[0] != '+' && Line[0] != 'f' && Line[0] != 'd')) {
+      // The file is corrupt; don't trust any of it.
+      Cache->StatCalls.clear();
+      return Cache;
+    }
+    char Kind = Line[0];
+    Line = Line.substr(2);
+
+    if (Kind == 'f' || Kind == 'd') {
+      CachedStat &Entry = Cache->StatCalls[Line];
+      if (Kind == 'f')
+        Entry.MissingAsFile = true;
+      else
+        Entry.MissingAsDirectory = true;
+      continue;
+    }
+
+    uint64_t Fields[7];
+    for (unsigned Field = 0; Field != 7; ++Field) {
+      std::pair<StringRef, StringRef> Split = Line.split(' ');
+      if (Split.first.getAsInteger(10, Fields[Field]) || Split.second.empty()) {
+        Cache->StatCalls.clear();
+        return Cache;
+      }
+      Line = Split.second;
+    }
+    CachedStat &Entry = Cache->StatCalls[Line];
+    Entry.Exists = true;
+    Entry.Data.Name = Line;
+    Entry.Data.UniqueID = llvm::sys::fs::UniqueID(Fields[0], Fields[1]);
+    Entry.Data.Size = Fields[2];
+    Entry.Data.ModTime = Fields[3];
+    Entry.Data.IsDirectory = Fields[4];
+    Entry.Data.IsNamedPipe = Fields[5];
+    Entry.Data.IsVFSMapped = Fields[6];
+  }
+  return Cache;
+}
+
+bool PersistentStatCache::save(StringRef Path, std::string &ErrorStr) const {
+  // Write to a uniquely named file first and rename it into place, so that
+  // concurrent writers don't clobber each other and concurrent readers never
+  // see a partial file.
+  SmallString<128> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          Twine(Path) + "-%%%%%%%%", FD, TempPath)) {
+    ErrorStr = EC.message();
+    return true;
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << PersistentStatCacheMagic << ' ' << Epoch << '\n';
+    for (llvm::StringMap<CachedStat, llvm::BumpPtrAllocator>::const_iterator
+             I = StatCalls.begin(), E = StatCalls.end();
+         I != E; ++I) {
+      const CachedStat &Entry = I->getValue();
+      if (!Entry.Exists) {
+        if (Entry.MissingAsFile)
+          OS << "f " << I->getKey() << '\n';
+        if (Entry.MissingAsDirectory)
+          OS << "d " << I->getKey() << '\n';
+        continue;
+      }
+      const FileData &Data = Entry.Data;
+      OS << "+ " << Data.UniqueID.getDevice() << ' ' << Data.UniqueID.getFile()
+         << ' ' << Data.Size << ' ' << (uint64_t)Data.ModTime << ' '
+         << Data.IsDirectory << ' ' << Data.IsNamedPipe << ' '
+         << Data.IsVFSMapped << ' ' << I->getKey() << '\n';
+    }
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      ErrorStr = "could not write stat cache";
+      llvm::sys::fs::remove(TempPath.str());
+      return true;
+    }
+  }
+
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath.str(), Path)) {
+    ErrorStr = EC.message();
+    llvm::sys::fs::remove(TempPath.str());
+    return true;
+  }
+  return false;
+}
+
+PersistentStatCache::LookupResult
+PersistentStatCache::getStat(const char *Path, FileData &Data, bool isFile,
+                             std::unique_ptr<vfs::File> *F,
+                             vfs::FileSystem &FS) {
+  if (!llvm::sys::path::is_absolute(Path))
+    return statChained(Path, Data, isFile, F, FS);
+
+  // Paths containing newlines cannot be saved.
+  StringRef PathStr(Path);
+  if (PathStr.find_first_of("\r\n") != StringRef::npos)
+    return statChained(Path, Data, isFile, F, FS);
+
+  llvm::StringMap<CachedStat, llvm::BumpPtrAllocator>::iterator Known =
+      StatCalls.find(PathStr);
+  if (Known != StatCalls.end()) {
+    const CachedStat &Entry = Known->getValue();
+    if (Entry.Exists) {
+      Data = Entry.Data;
+      return CacheExists;
+    }
+    if (isFile ? Entry.MissingAsFile : Entry.MissingAsDirectory)
+      return CacheMissing;
+  }
+
+  // A lookup for a file fails when the path names a directory, and vice
+  // versa, so a failure only says that there is no entry of the kind that was
+  // asked for.
+  LookupResult Result = statChained(Path, Data, isFile, F, FS);
+  if (Result == CacheMissing) {
+    CachedStat &Entry = StatCalls[PathStr];
+    if (isFile)
+      Entry.MissingAsFile = true;
+    else
+      Entry.MissingAsDirectory = true;
+    Dirty = true;
+    return Result;
+  }
+
+  // Entries that the file system reports under another name (such as those
+  // remapped by a VFS overlay) can't be reproduced from the saved path alone.
+  if (Data.Name != PathStr)
+    return Result;
+
+  CachedStat &Entry = StatCalls[PathStr];
+  Entry.Exists = true;
+  Entry.MissingAsFile = Entry.MissingAsDirectory = false;
+  Entry.Data = Data;
+  Dirty = true;
+  return Result;
+}
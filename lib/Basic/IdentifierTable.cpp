@@ -112,6 +112,50 @@ namespace {
   };
 }
 
+namespace {
+/// KeywordMasks - The keyword flags enabled by a set of language options,
+/// computed once so that classifying each keyword is a few mask tests rather
+/// than a walk over the language options.
+///
+/// The groups mirror the order in which the flags are checked: a flag that
+/// makes a keyword standard in an earlier group wins over one that makes it
+/// an extension, which in turn wins over a later group.
+struct KeywordMasks {
+  unsigned EnabledEarly;   // Standard keyword, checked first.
+  unsigned Extension;      // Keyword as a language extension.
+  unsigned EnabledLate;    // Standard keyword, checked last.
+  bool FutureCXX11;        // C++11 keywords are compat warnings otherwise.
+  bool ExcludeNoMS;        // Drop KEYNOMS keywords.
+
+  explicit KeywordMasks(const LangOptions &LangOpts) {
+    EnabledEarly = 0;
+    if (LangOpts.CPlusPlus) EnabledEarly |= KEYCXX;
+    if (LangOpts.CPlusPlus11) EnabledEarly |= KEYCXX11;
+    if (LangOpts.C99) EnabledEarly |= KEYC99;
+
+    Extension = 0;
+    if (LangOpts.GNUKeywords) Extension |= KEYGNU;
+    if (LangOpts.MicrosoftExt) Extension |= KEYMS;
+    if (LangOpts.Borland) Extension |= KEYBORLAND;
+
+    EnabledLate = 0;
+    if (LangOpts.Bool) EnabledLate |= BOOLSUPPORT;
+    if (LangOpts.Half) EnabledLate |= HALFSUPPORT;
+    if (LangOpts.WChar) EnabledLate |= WCHARSUPPORT;
+    if (LangOpts.AltiVec) EnabledLate |= KEYALTIVEC;
+    if (LangOpts.OpenCL) EnabledLate |= KEYOPENCL;
+    if (!LangOpts.CPlusPlus) EnabledLate |= KEYNOCXX;
+    if (LangOpts.C11) EnabledLate |= KEYC11;
+    // We treat bridge casts as objective-C keywords so we can warn on them
+    // in non-arc mode.
+    if (LangOpts.ObjC2) EnabledLate |= KEYARC;
+
+    FutureCXX11 = LangOpts.CPlusPlus;
+    ExcludeNoMS = LangOpts.MSVCCompat;
+  }
+};
+}
+
 /// AddKeyword - This method is used to associate a token ID with specific
 /// identifiers because they are language keywords.  This causes the lexer to
 /// automatically map matching identifiers to specialized token codes.
@@ -122,29 +166,16 @@ namespace {
 /// language, and set to 0 if disabled in the specified language.
 static void AddKeyword(StringRef Keyword,
                        tok::TokenKind TokenCode, unsigned Flags,
-                       const LangOptions &LangOpts, IdentifierTable &Table) {
+                       const KeywordMasks &Masks, IdentifierTable &Table) {
   unsigned AddResult = 0;
   if (Flags == KEYALL) AddResult = 2;
-  else if (LangOpts.CPlusPlus && (Flags & KEYCXX)) AddResult = 2;
-  else if (LangOpts.CPlusPlus11 && (Flags & KEYCXX11)) AddResult = 2;
-  else if (LangOpts.C99 && (Flags & KEYC99)) AddResult = 2;
-  else if (LangOpts.GNUKeywords && (Flags & KEYGNU)) AddResult = 1;
-  else if (LangOpts.MicrosoftExt && (Flags & KEYMS)) AddResult = 1;
-  else if (LangOpts.Borland && (Flags & KEYBORLAND)) AddResult = 1;
-  else if (LangOpts.Bool && (Flags & BOOLSUPPORT)) AddResult = 2;
-  else if (LangOpts.Half && (Flags & HALFSUPPORT)) AddResult = 2;
-  else if (LangOpts.WChar && (Flags & WCHARSUPPORT)) AddResult = 2;
-  else if (LangOpts.AltiVec && (Flags & KEYALTIVEC)) AddResult = 2;
-  else if (LangOpts.OpenCL && (Flags & KEYOPENCL)) AddResult = 2;
-  else if (!LangOpts.CPlusPlus && (Flags & KEYNOCXX)) AddResult = 2;
-  else if (LangOpts.C11 && (Flags & KEYC11)) AddResult = 2;
-  // We treat bridge casts as objective-C keywords so we can warn on them
-  // in non-arc mode.
-  else if (LangOpts.ObjC2 && (Flags & KEYARC)) AddResult = 2;
-  else if (LangOpts.CPlusPlus && (Flags & KEYCXX11)) AddResult = 3;
+  else if (Flags & Masks.EnabledEarly) AddResult = 2;
+  else if (Flags & Masks.Extension) AddResult = 1;
+  else if (Flags & Masks.EnabledLate) AddResult = 2;
+  else if (Masks.FutureCXX11 && (Flags & KEYCXX11)) AddResult = 3;
 
   // Don't add this keyword under MSVCCompat.
-  if (LangOpts.MSVCCompat && (Flags & KEYNOMS))
+  if (Masks.ExcludeNoMS && (Flags & KEYNOMS))
      return;
   // Don't add this keyword if disabled in this language.
   if (AddResult == 0) return;
@@ -175,13 +206,15 @@ static void AddObjCKeyword(StringRef Name,
 /// AddKeywords - Add all keywords to the symbol table.
 ///
 void IdentifierTable::AddKeywords(const LangOptions &LangOpts) {
+  KeywordMasks Masks(LangOpts);
+
   // Add keywords and tokens for the current language.
 #define KEYWORD(NAME, FLAGS) \
   AddKeyword(StringRef(#NAME), tok::kw_ ## NAME,  \
-             FLAGS, LangOpts, *this);
+             FLAGS, Masks, *this);
 #define ALIAS(NAME, TOK, FLAGS) \
   AddKeyword(StringRef(NAME), tok::kw_ ## TOK,  \
-             FLAGS, LangOpts, *this);
+             FLAGS, Masks, *this);
 #define CXX_KEYWORD_OPERATOR(NAME, ALIAS) \
   if (LangOpts.CXXOperatorNames)          \
     AddCXXOperatorKeyword(StringRef(#NAME), tok::ALIAS, *this);
@@ -196,7 +229,7 @@ void IdentifierTable::AddKeywords(const LangOptions &LangOpts) {
 
   if (LangOpts.ParseUnknownAnytype)
     AddKeyword("__unknown_anytype", tok::kw___unknown_anytype, KEYALL,
-               LangOpts, *this);
+               Masks, *this);
 }
 
 tok::PPKeywordKind IdentifierInfo::getPPKeywordID() const {
@@ -408,6 +408,7 @@ SourceManager::~SourceManager() {
 void SourceManager::clearIDTables() {
   MainFileID = FileID();
   LocalSLocEntryTable.clear();
+  LocalSLocEntryOffsets.clear();
   LoadedSLocEntryTable.clear();
   SLocEntryLoaded.clear();
   LastLineNoFileIDQuery = FileID();
@@ -584,6 +585,7 @@ FileID SourceManager::createFileID(const ContentCache *File,
   LocalSLocEntryTable.push_back(SLocEntry::get(NextLocalOffset,
                                                FileInfo::get(IncludePos, File,
                                                              FileCharacter)));
+  LocalSLocEntryOffsets.push_back(NextLocalOffset);
   unsigned FileSize = File->getSize();
   assert(NextLocalOffset + FileSize + 1 > NextLocalOffset &&
          NextLocalOffset + FileSize + 1 <= CurrentLoadedOffset &&
@@ -634,6 +636,7 @@ SourceManager::createExpansionLocImpl(const ExpansionInfo &Info,
     return SourceLocation::getMacroLoc(LoadedOffset);
   }
   LocalSLocEntryTable.push_back(SLocEntry::get(NextLocalOffset, Info));
+  LocalSLocEntryOffsets.push_back(NextLocalOffset);
   assert(NextLocalOffset + TokLength + 1 > NextLocalOffset &&
          NextLocalOffset + TokLength + 1 <= CurrentLoadedOffset &&
          "Ran out of source locations!");
@@ -776,44 +779,32 @@ FileID SourceManager::getFileIDLocal(unsigned SLocOffset) const {
   // Convert "I" back into an index.  We know that it is an entry whose index is
   // larger than the offset we are looking for.
   unsigned GreaterIndex = I - LocalSLocEntryTable.begin();
-  // LessIndex - This is the lower bound of the range that we're searching.
-  // We know that the offset corresponding to the FileID is is less than
-  // SLocOffset.
-  unsigned LessIndex = 0;
+
+  // Local entries are contiguous, so the entry containing SLocOffset is the
+  // last one below GreaterIndex that starts at or before it.  Entry 0 starts
+  // at offset 0, so there always is one.  Search the packed offset table
+  // rather than the SLocEntries themselves; the loop body is written so that
+  // it can be compiled to a conditional move instead of a branch.
+  const unsigned *Offsets = LocalSLocEntryOffsets.data();
+  const unsigned *Base = Offsets;
+  unsigned Len = GreaterIndex;
   NumProbes = 0;
-  while (1) {
-    bool Invalid = false;
-    unsigned MiddleIndex = (GreaterIndex-LessIndex)/2+LessIndex;
-    unsigned MidOffset = getLocalSLocEntry(MiddleIndex, &Invalid).getOffset();
-    if (Invalid)
-      return FileID::get(0);
-    
+  while (Len > 1) {
+    unsigned Half = Len / 2;
+    Base = Base[Half] <= SLocOffset ? Base + Half : Base;
+    Len -= Half;
     ++NumProbes;
+  }
 
-    // If the offset of the midpoint is too large, chop the high side of the
-    // range to the midpoint.
-    if (MidOffset > SLocOffset) {
-      GreaterIndex = MiddleIndex;
-      continue;
-    }
-
-    // If the middle index contains the value, succeed and return.
-    // FIXME: This could be made faster by using a function that's aware of
-    // being in the local area.
-    if (isOffsetInFileID(FileID::get(MiddleIndex), SLocOffset)) {
-      FileID Res = FileID::get(MiddleIndex);
-
-      // If this isn't a macro expansion, remember it.  We have good locality
-      // across FileID lookups.
-      if (!LocalSLocEntryTable[MiddleIndex].isExpansion())
-        LastFileIDLookup = Res;
-      NumBinaryProbes += NumProbes;
-      return Res;
-    }
+  unsigned Index = Base - Offsets;
+  FileID Res = FileID::get(Index);
 
-    // Otherwise, move the low-side up to the middle index.
-    LessIndex = MiddleIndex;
-  }
+  // If this isn't a macro expansion, remember it.  We have good locality
+  // across FileID lookups.
+  if (!LocalSLocEntryTable[Index].isExpansion())
+    LastFileIDLookup = Res;
+  NumBinaryProbes += NumProbes;
+  return Res;
 }
 
 /// \brief Return the FileID for a SourceLocation with a high offset.
@@ -1225,6 +1216,23 @@ static void ComputeLineNumbers(DiagnosticsEngine &Diag, ContentCache *FI,
     __m128i CRs = _mm_set1_epi8('\r');
     __m128i LFs = _mm_set1_epi8('\n');
 
+    // Most files only use '\n' line endings.  As long as a chunk (and the byte
+    // after it, which could pair with a trailing '\n') contains no '\r', every
+    // '\n' in it starts a new line, so record them all without rescanning.
+    while (NextBuf+16 <= End && NextBuf[16] != '\r') {
+      const __m128i Chunk = _mm_loadu_si128((const __m128i*)NextBuf);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, CRs)) != 0)
+        break;
+
+      unsigned Mask = _mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, LFs));
+      unsigned ChunkOffs = Offs + (NextBuf - Buf);
+      while (Mask != 0) {
+        LineOffsets.push_back(ChunkOffs + llvm::countTrailingZeros(Mask) + 1);
+        Mask &= Mask - 1;
+      }
+      NextBuf += 16;
+    }
+
     // First fix up the alignment to 16 bytes.
     while (((uintptr_t)NextBuf & 0xF) != 0) {
       if (*NextBuf == '\n' || *NextBuf == '\r' || *NextBuf == '\0')
@@ -2156,6 +2164,7 @@ SourceManager::MemoryBufferSizes SourceManager::getMemoryBufferSizes() const {
 size_t SourceManager::getDataStructureSizes() const {
   size_t size = llvm::capacity_in_bytes(MemBufferInfos)
     + llvm::capacity_in_bytes(LocalSLocEntryTable)
+    + llvm::capacity_in_bytes(LocalSLocEntryOffsets)
     + llvm::capacity_in_bytes(LoadedSLocEntryTable)
     + llvm::capacity_in_bytes(SLocEntryLoaded)
     + llvm::capacity_in_bytes(FileInfos);
@@ -14,9 +14,11 @@
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/MutexGuard.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/YAMLParser.h"
 #include <atomic>
@@ -332,6 +334,126 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
       std::make_shared<OverlayFSDirIterImpl>(Dir, *this, EC));
 }
 
+//===-----------------------------------------------------------------------===/
+// CachingFileSystem implementation
+//===-----------------------------------------------------------------------===/
+
+namespace {
+/// \brief A file opened through a \c CachingFileSystem.  Its status comes
+/// from the underlying file, but its contents come from the shared cache.
+class CachingFile : public File {
+  CachingFileSystem &FS;
+  std::unique_ptr<File> ExternalFile;
+
+public:
+  CachingFile(CachingFileSystem &FS, std::unique_ptr<File> ExternalFile)
+      : FS(FS), ExternalFile(std::move(ExternalFile)) {}
+
+  ErrorOr<Status> status() override { return ExternalFile->status(); }
+  std::error_code getBuffer(const Twine &Name,
+                            std::unique_ptr<MemoryBuffer> &Result,
+                            int64_t FileSize = -1,
+                            bool RequiresNullTerminator = true,
+                            bool IsVolatile = false) override;
+  std::error_code close() override { return ExternalFile->close(); }
+  void setName(StringRef Name) override { ExternalFile->setName(Name); }
+};
+} // end anonymous namespace
+
+std::error_code CachingFile::getBuffer(const Twine &Name,
+                                       std::unique_ptr<MemoryBuffer> &Result,
+                                       int64_t FileSize,
+                                       bool RequiresNullTerminator,
+                                       bool IsVolatile) {
+  ErrorOr<Status> S = ExternalFile->status();
+  if (IsVolatile || !S || !S->isRegularFile())
+    return ExternalFile->getBuffer(Name, Result, FileSize,
+                                   RequiresNullTerminator, IsVolatile);
+
+  CachingFileSystem::ContentKey Key = {
+    S->getUniqueID(), S->getLastModificationTime().toEpochTime(), S->getSize()
+  };
+  const MemoryBuffer *Contents;
+  if (std::error_code EC = FS.getCachedContents(Key, *ExternalFile, Name,
+                                                Contents))
+    return EC;
+
+  // Hand out a reference to the cached contents rather than a copy.
+  Result.reset(MemoryBuffer::getMemBuffer(Contents->getBuffer(), Name.str(),
+                                          RequiresNullTerminator));
+  return std::error_code();
+}
+
+CachingFileSystem::CachingFileSystem(IntrusiveRefCntPtr<FileSystem> ExternalFS)
+    : ExternalFS(ExternalFS), NumHits(0), NumMisses(0) {}
+
+CachingFileSystem::~CachingFileSystem() { clearCache(); }
+
+ErrorOr<Status> CachingFileSystem::status(const Twine &Path) {
+  return ExternalFS->status(Path);
+}
+
+std::error_code
+CachingFileSystem::openFileForRead(const Twine &Path,
+                                   std::unique_ptr<File> &Result) {
+  std::unique_ptr<File> ExternalFile;
+  if (std::error_code EC = ExternalFS->openFileForRead(Path, ExternalFile))
+    return EC;
+  Result.reset(new CachingFile(*this, std::move(ExternalFile)));
+  return std::error_code();
+}
+
+directory_iterator CachingFileSystem::dir_begin(const Twine &Dir,
+                                                std::error_code &EC) {
+  return ExternalFS->dir_begin(Dir, EC);
+}
+
+std::error_code
+CachingFileSystem::getCachedContents(const ContentKey &Key, File &F,
+                                     const Twine &Name,
+                                     const MemoryBuffer *&Result) {
+  {
+    llvm::MutexGuard Guard(ContentsLock);
+    std::map<ContentKey, MemoryBuffer *>::iterator Known = Contents.find(Key);
+    if (Known != Contents.end()) {
+      ++NumHits;
+      Result = Known->second;
+      return std::error_code();
+    }
+  }
+
+  // Read the file without holding the lock, so that concurrent readers of
+  // other files are not serialized behind this one.
+  std::unique_ptr<MemoryBuffer> Buffer;
+  if (std::error_code EC = F.getBuffer(Name, Buffer, Key.Size,
+                                       /*RequiresNullTerminator=*/true))
+    return EC;
+
+  llvm::MutexGuard Guard(ContentsLock);
+  ++NumMisses;
+  std::pair<std::map<ContentKey, MemoryBuffer *>::iterator, bool> Inserted =
+      Contents.insert(std::make_pair(Key, Buffer.get()));
+  // If another thread raced us to read this file, keep its copy.
+  if (Inserted.second)
+    Buffer.release();
+  Result = Inserted.first->second;
+  return std::error_code();
+}
+
+void CachingFileSystem::clearCache() {
+  llvm::MutexGuard Guard(ContentsLock);
+  for (std::map<ContentKey, MemoryBuffer *>::iterator I = Contents.begin(),
+                                                      E = Contents.end();
+       I != E; ++I)
+    delete I->second;
+  Contents.clear();
+}
+
+unsigned CachingFileSystem::getNumCachedFiles() {
+  llvm::MutexGuard Guard(ContentsLock);
+  return Contents.size();
+}
+
 //===-----------------------------------------------------------------------===/
 // VFSFromYAML implementation
 //===-----------------------------------------------------------------------===/
@@ -373,15 +495,48 @@ class DirectoryEntry : public Entry {
   std::vector<Entry *> Contents;
   Status S;
 
+  /// \brief Contents keyed by name (lowercased if the overlay is
+  /// case-insensitive), built on the first lookup into this directory.
+  /// Several entries may share a name; they are kept in \c Contents order.
+  llvm::StringMap<SmallVector<Entry *, 1> > ContentsByName;
+  bool ContentsIndexed;
+
 public:
   virtual ~DirectoryEntry();
   DirectoryEntry(StringRef Name, std::vector<Entry *> Contents, Status S)
       : Entry(EK_Directory, Name), Contents(std::move(Contents)),
-        S(std::move(S)) {}
+        S(std::move(S)), ContentsIndexed(false) {}
   Status getStatus() { return S; }
   typedef std::vector<Entry *>::iterator iterator;
   iterator contents_begin() { return Contents.begin(); }
   iterator contents_end() { return Contents.end(); }
+
+  /// \brief Return the entries in this directory named \p Name, in the
+  /// order they were listed in the overlay.
+  ArrayRef<Entry *> lookupContents(StringRef Name, bool CaseSensitive) {
+    if (!ContentsIndexed) {
+      for (iterator I = contents_begin(), E = contents_end(); I != E; ++I) {
+        StringRef Key = (*I)->getName();
+        std::string Lower;
+        if (!CaseSensitive) {
+          Lower = Key.lower();
+          Key = Lower;
+        }
+        ContentsByName[Key].push_back(*I);
+      }
+      ContentsIndexed = true;
+    }
+    std::string Lower;
+    if (!CaseSensitive) {
+      Lower = Name.lower();
+      Name = Lower;
+    }
+    llvm::StringMap<SmallVector<Entry *, 1> >::iterator I =
+        ContentsByName.find(Name);
+    if (I == ContentsByName.end())
+      return ArrayRef<Entry *>();
+    return I->getValue();
+  }
   static bool classof(const Entry *E) { return E->getKind() == EK_Directory; }
 };
 
@@ -935,6 +1090,20 @@ ErrorOr<Entry *> VFSFromYAML::lookupPath(sys::path::const_iterator Start,
   if (!DE)
     return make_error_code(llvm::errc::not_a_directory);
 
+  // Use the name index rather than trying every entry in turn; '.' is left
+  // to the recursive call to skip.
+  if (!Start->equals(".")) {
+    ArrayRef<Entry *> Candidates = DE->lookupContents(*Start, CaseSensitive);
+    for (ArrayRef<Entry *>::iterator I = Candidates.begin(),
+                                     E = Candidates.end();
+         I != E; ++I) {
+      ErrorOr<Entry *> Result = lookupPath(Start, End, *I);
+      if (Result || Result.getError() != llvm::errc::no_such_file_or_directory)
+        return Result;
+    }
+    return make_error_code(llvm::errc::no_such_file_or_directory);
+  }
+
   for (DirectoryEntry::iterator I = DE->contents_begin(),
                                 E = DE->contents_end();
        I != E; ++I) {
@@ -564,6 +564,13 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action, raw_ostream *OS) {
 
   // Run passes. For now we do all passes at once, but eventually we
   // would like to have the option of streaming code generation.
+  //
+  // FIXME: Code generation runs on one thread for the whole module. Splitting
+  // the optimized module into partitions and running codegen for each on its
+  // own thread needs a module splitter that keeps comdats and internal
+  // symbols together, one LLVMContext and TargetMachine per thread, and a way
+  // to merge the resulting objects into the single output file. None of that
+  // exists in LLVM yet.
 
   if (PerFunctionPasses) {
     PrettyStackTraceString CrashInfo("Per-function optimization");
@@ -16,6 +16,7 @@
 #include "CodeGenModule.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/CodeGen/CGFunctionInfo.h"
+#include "clang/Frontend/FrontendDiagnostic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Intrinsics.h"
@@ -482,11 +483,32 @@ RValue CodeGenFunction::EmitAtomicExpr(AtomicExpr *E, llvm::Value *Dest) {
   CharUnits sizeChars = getContext().getTypeSizeInChars(AtomicTy);
   uint64_t Size = sizeChars.getQuantity();
   CharUnits alignChars = getContext().getTypeAlignInChars(AtomicTy);
+
+  // A type can be under-aligned for its size even though the object being
+  // operated on is suitably aligned, e.g. a 16-byte struct of two pointers
+  // declared with __attribute__((aligned(16))). Use the declared alignment
+  // of the object when we can see it. An alignment attribute on a reference
+  // applies to the reference, not to the object it binds to.
+  if (alignChars < sizeChars) {
+    const Expr *PtrE = E->getPtr()->IgnoreParenCasts();
+    if (const auto *UO = dyn_cast<UnaryOperator>(PtrE))
+      if (UO->getOpcode() == UO_AddrOf)
+        if (const auto *DRE =
+                dyn_cast<DeclRefExpr>(UO->getSubExpr()->IgnoreParens()))
+          if (const auto *VD = dyn_cast<VarDecl>(DRE->getDecl()))
+            if (!VD->getType()->isReferenceType() &&
+                getContext().getDeclAlign(VD) >= sizeChars)
+              alignChars = sizeChars;
+  }
+
   unsigned Align = alignChars.getQuantity();
   unsigned MaxInlineWidthInBits =
     getTarget().getMaxAtomicInlineWidth();
   bool UseLibcall = (Size != Align ||
                      getContext().toBits(sizeChars) > MaxInlineWidthInBits);
+  if (UseLibcall)
+    CGM.getDiags().Report(E->getLocStart(), diag::warn_atomic_op_libcall)
+        << (int)Size;
 
   llvm::Value *IsWeak = nullptr, *OrderFail = nullptr, *Val1 = nullptr,
               *Val2 = nullptr;
@@ -388,6 +388,16 @@ RValue CodeGenFunction::EmitBuiltinExpr(const FunctionDecl *FD,
                                         "expval");
     return RValue::get(Result);
   }
+  case Builtin::BI__builtin_assume_aligned: {
+    Value *PtrValue = EmitScalarExpr(E->getArg(0));
+    // The offset is evaluated for its side effects only.
+    if (E->getNumArgs() > 2)
+      EmitScalarExpr(E->getArg(2));
+
+    // FIXME: Emit an alignment assumption on PtrValue (taking the offset into
+    // account) once LLVM can represent assumptions in the IR.
+    return RValue::get(PtrValue);
+  }
   case Builtin::BI__builtin_bswap16:
   case Builtin::BI__builtin_bswap32:
   case Builtin::BI__builtin_bswap64: {
@@ -93,6 +93,13 @@ void CGNVCUDARuntime::EmitDeviceStubBody(CodeGenFunction &CGF,
   llvm::BasicBlock *EndBlock = CGF.createBasicBlock("setup.end");
 
   // Emit the calls to cudaSetupArgument
+  // FIXME: A launch through cudaLaunchKernel, passing an array of pointers to
+  // the arguments, would replace these per-argument calls with a single one.
+  // It takes the launch configuration as arguments, though, while the
+  // <<<...>>> syntax hands it to the runtime separately via cudaConfigureCall
+  // before the stub runs; switching requires routing the configuration into
+  // the stub. Registering kernels in a module constructor likewise needs the
+  // device binary to be embedded in the host object.
   llvm::Constant *cudaSetupArgFn = getSetupArgumentFn();
   for (unsigned I = 0, E = Args.size(); I != E; ++I) {
     llvm::Value *Args[3];
@@ -19,6 +19,17 @@ using namespace CodeGen;
 
 CGCXXABI::~CGCXXABI() { }
 
+llvm::Value *CGCXXABI::EmitVTableSlotLoad(CodeGenFunction &CGF,
+                                          llvm::Value *VFuncPtr) {
+  llvm::LoadInst *VFunc = CGF.Builder.CreateLoad(VFuncPtr);
+  // The kernel linker can patch vtables of an -fapple-kext build at runtime.
+  if (CGM.getCodeGenOpts().OptimizationLevel > 0 &&
+      !CGM.getLangOpts().AppleKext)
+    VFunc->setMetadata(CGM.getModule().getMDKindID("invariant.load"),
+                       llvm::MDNode::get(CGM.getLLVMContext(), None));
+  return VFunc;
+}
+
 void CGCXXABI::ErrorUnsupportedABI(CodeGenFunction &CGF, StringRef S) {
   DiagnosticsEngine &Diags = CGF.CGM.getDiags();
   unsigned DiagID = Diags.getCustomDiagID(DiagnosticsEngine::Error,
@@ -71,6 +71,15 @@ protected:
   /// for 'this' emitted by buildThisParam.
   void EmitThisParam(CodeGenFunction &CGF);
 
+  /// Load a virtual function pointer from the vtable slot \p VFuncPtr.
+  /// Vtables are never written once built, so when optimizing the load is
+  /// marked invariant. This only lets calls that use the same loaded vtable
+  /// pointer share the slot load: the load of the vtable pointer itself is
+  /// not invariant, since it changes during construction and destruction,
+  /// so each virtual call in a loop still reloads both.
+  llvm::Value *EmitVTableSlotLoad(CodeGenFunction &CGF,
+                                  llvm::Value *VFuncPtr);
+
   ASTContext &getContext() const { return CGM.getContext(); }
 
   virtual bool requiresArrayCookie(const CXXDeleteExpr *E, QualType eltType);
@@ -1217,10 +1217,24 @@ void CodeGenModule::ConstructAttributeList(const CGFunctionInfo &FI,
                                     llvm::AttributeSet::ReturnIndex,
                                     RetAttrs));
 
+  // Find the parameter declarations of the callee, to mark noescape pointers
+  // nocapture both on declarations and at call sites. The arguments of an
+  // instance method start with 'this'; constructors and destructors may also
+  // have ABI-specific implicit arguments, so leave those alone.
+  const FunctionDecl *ParamsFn = dyn_cast_or_null<FunctionDecl>(TargetDecl);
+  unsigned FirstParamArg = 0;
+  if (ParamsFn && (isa<CXXConstructorDecl>(ParamsFn) ||
+                   isa<CXXDestructorDecl>(ParamsFn)))
+    ParamsFn = nullptr;
+  else if (const auto *MD = dyn_cast_or_null<CXXMethodDecl>(ParamsFn))
+    FirstParamArg = MD->isInstance() ? 1 : 0;
+  unsigned NextArg = 0;
+
   for (const auto &I : FI.arguments()) {
     QualType ParamType = I.type;
     const ABIArgInfo &AI = I.info;
     llvm::AttrBuilder Attrs;
+    unsigned ArgNo = NextArg++;
 
     // Skip over the sret parameter when it comes second.  We already handled it
     // above.
@@ -1308,6 +1322,14 @@ void CodeGenModule::ConstructAttributeList(const CGFunctionInfo &FI,
         Attrs.addAttribute(llvm::Attribute::NonNull);
     }
 
+    // The callee promises not to let a noescape pointer outlive the call.
+    if (ParamsFn && ArgNo >= FirstParamArg &&
+        ArgNo - FirstParamArg < ParamsFn->getNumParams() &&
+        ParamsFn->getParamDecl(ArgNo - FirstParamArg)
+            ->hasAttr<NoEscapeAttr>() &&
+        (ParamType->isPointerType() || ParamType->isBlockPointerType()))
+      Attrs.addAttribute(llvm::Attribute::NoCapture);
+
     if (Attrs.hasAttributes())
       PAL.push_back(llvm::AttributeSet::get(getLLVMContext(), Index, Attrs));
     ++Index;
@@ -2991,9 +3013,13 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
   llvm::AttributeSet Attrs = llvm::AttributeSet::get(getLLVMContext(),
                                                      AttributeList);
 
+  // A call to a function defined in this TU whose body can't throw doesn't
+  // need a landing pad either.
   llvm::BasicBlock *InvokeDest = nullptr;
+  const auto *CalleeFD = dyn_cast_or_null<FunctionDecl>(TargetDecl);
   if (!Attrs.hasAttribute(llvm::AttributeSet::FunctionIndex,
-                          llvm::Attribute::NoUnwind))
+                          llvm::Attribute::NoUnwind) &&
+      !(CalleeFD && CGM.cannotThrow(CalleeFD)))
     InvokeDest = getInvokeDest();
 
   llvm::CallSite CS;
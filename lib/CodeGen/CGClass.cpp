@@ -2071,6 +2071,10 @@ CodeGenFunction::CanDevirtualizeMemberFunctionCall(const Expr *Base,
   if (const CallExpr *CE = dyn_cast<CallExpr>(Base))
     return CE->getCallReturnType()->isRecordType();
 
+  // FIXME: Whole-program devirtualization (a single linked implementation of
+  // an interface) can't be decided here; it needs per-class type identifiers
+  // on the vtables emitted by CodeGenVTables and on virtual call sites, plus
+  // an LTO pass that consumes them, and LLVM has no such metadata yet.
   // We can't devirtualize the call.
   return false;
 }
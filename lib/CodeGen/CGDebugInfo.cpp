@@ -1453,12 +1453,14 @@ void CGDebugInfo::completeType(const RecordDecl *RD) {
     completeRequiredType(RD);
 }
 
+static bool isDefinitionEmittedElsewhere(const CXXRecordDecl *CXXDecl);
+
 void CGDebugInfo::completeRequiredType(const RecordDecl *RD) {
   if (DebugKind <= CodeGenOptions::DebugLineTablesOnly)
     return;
 
   if (const CXXRecordDecl *CXXDecl = dyn_cast<CXXRecordDecl>(RD))
-    if (CXXDecl->isDynamicClass())
+    if (isDefinitionEmittedElsewhere(CXXDecl))
       return;
 
   QualType Ty = CGM.getContext().getRecordType(RD);
@@ -1492,6 +1494,23 @@ static bool hasExplicitMemberDefinition(CXXRecordDecl::method_iterator I,
   return false;
 }
 
+/// Return true if the full debug info for this class is known to be emitted
+/// by another translation unit: the one with its vtable, or the one with the
+/// explicit instantiation definition for its out-of-line members.
+static bool isDefinitionEmittedElsewhere(const CXXRecordDecl *CXXDecl) {
+  if (CXXDecl->hasDefinition() && CXXDecl->isDynamicClass())
+    return true;
+
+  TemplateSpecializationKind Spec = TSK_Undeclared;
+  if (const ClassTemplateSpecializationDecl *SD =
+          dyn_cast<ClassTemplateSpecializationDecl>(CXXDecl))
+    Spec = SD->getSpecializationKind();
+
+  return Spec == TSK_ExplicitInstantiationDeclaration &&
+         hasExplicitMemberDefinition(CXXDecl->method_begin(),
+                                     CXXDecl->method_end());
+}
+
 static bool shouldOmitDefinition(CodeGenOptions::DebugInfoKind DebugKind,
                                  const RecordDecl *RD,
                                  const LangOptions &LangOpts) {
@@ -1509,20 +1528,7 @@ static bool shouldOmitDefinition(CodeGenOptions::DebugInfoKind DebugKind,
   if (!CXXDecl)
     return false;
 
-  if (CXXDecl->hasDefinition() && CXXDecl->isDynamicClass())
-    return true;
-
-  TemplateSpecializationKind Spec = TSK_Undeclared;
-  if (const ClassTemplateSpecializationDecl *SD =
-          dyn_cast<ClassTemplateSpecializationDecl>(RD))
-    Spec = SD->getSpecializationKind();
-
-  if (Spec == TSK_ExplicitInstantiationDeclaration &&
-      hasExplicitMemberDefinition(CXXDecl->method_begin(),
-                                  CXXDecl->method_end()))
-    return true;
-
-  return false;
+  return isDefinitionEmittedElsewhere(CXXDecl);
 }
 
 /// CreateType - get structure or union type.
@@ -24,6 +24,7 @@
 #include "clang/AST/Attr.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/LLVMContext.h"
@@ -33,6 +34,10 @@
 using namespace clang;
 using namespace CodeGen;
 
+#define DEBUG_TYPE "codegen-expr"
+
+STATISTIC(NumSanitizerChecks, "Number of sanitizer checks emitted");
+
 //===--------------------------------------------------------------------===//
 //                        Miscellaneous Helper Methods
 //===--------------------------------------------------------------------===//
@@ -353,6 +358,17 @@ LValue CodeGenFunction::EmitMaterializeTemporaryExpr(
 
   // Create and initialize the reference temporary.
   llvm::Value *Object = createReferenceTemporary(*this, M, E);
+
+  // A full-expression temporary is dead once its full-expression ends, so let
+  // stack coloring reuse its slot. This cleanup is pushed before the
+  // temporary's destructor and therefore runs after it.
+  if (M->getStorageDuration() == SD_FullExpression) {
+    uint64_t Size = CGM.getDataLayout().getTypeAllocSize(
+        cast<llvm::AllocaInst>(Object)->getAllocatedType());
+    if (llvm::Value *SizeV = EmitLifetimeStart(Size, Object))
+      pushFullExprCleanup<CallLifetimeEnd>(NormalCleanup, Object, SizeV);
+  }
+
   if (auto *Var = dyn_cast<llvm::GlobalVariable>(Object)) {
     // If the temporary is a global and has a constant initializer, we may
     // have already initialized it.
@@ -463,7 +479,12 @@ void CodeGenFunction::EmitTypeCheck(TypeCheckKind TCK, SourceLocation Loc,
   llvm::Value *Cond = nullptr;
   llvm::BasicBlock *Done = nullptr;
 
-  if (SanOpts->Null || TCK == TCK_DowncastPointer) {
+  // 'this' has already been null-checked at the member call site, or is the
+  // object currently under construction or destruction; checking it again on
+  // every member access only bloats the function.
+  bool SkipNullCheck = Address == CXXThisValue;
+
+  if ((SanOpts->Null && !SkipNullCheck) || TCK == TCK_DowncastPointer) {
     // The glvalue must not be an empty glvalue.
     Cond = Builder.CreateICmpNE(
         Address, llvm::Constant::getNullValue(Address->getType()));
@@ -1166,8 +1187,15 @@ llvm::Value *CodeGenFunction::EmitToMemory(llvm::Value *Value, QualType Ty) {
   if (hasBooleanRepresentation(Ty)) {
     // This should really always be an i1, but sometimes it's already
     // an i8, and it's awkward to track those cases down.
-    if (Value->getType()->isIntegerTy(1))
-      return Builder.CreateZExt(Value, ConvertTypeForMem(Ty), "frombool");
+    if (Value->getType()->isIntegerTy(1)) {
+      llvm::Type *MemTy = ConvertTypeForMem(Ty);
+      // A bool that was just loaded from memory is truncated and then
+      // extended again to store it.  Store the loaded value directly.
+      if (llvm::TruncInst *TI = dyn_cast<llvm::TruncInst>(Value))
+        if (TI->getOperand(0)->getType() == MemTy)
+          return TI->getOperand(0);
+      return Builder.CreateZExt(Value, MemTy, "frombool");
+    }
     assert(Value->getType()->isIntegerTy(getContext().getTypeSize(Ty)) &&
            "wrong value rep of bool");
   }
@@ -2198,6 +2226,7 @@ void CodeGenFunction::EmitCheck(llvm::Value *Checked, StringRef CheckName,
                                 CheckRecoverableKind RecoverKind) {
   assert(SanOpts != &SanitizerOptions::Disabled);
   assert(IsSanitizerScope);
+  ++NumSanitizerChecks;
 
   if (CGM.getCodeGenOpts().SanitizeUndefinedTrapOnError) {
     assert (RecoverKind != CRK_AlwaysRecoverable &&
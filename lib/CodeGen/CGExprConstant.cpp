@@ -548,6 +548,37 @@ llvm::Constant *ConstStructBuilder::BuildStruct(CodeGenModule &CGM,
   return Builder.Finalize(ValTy);
 }
 
+/// Return true if an array of \p ElemTy can be emitted as a
+/// ConstantDataArray of integers.
+static bool isDataArrayIntegerType(llvm::Type *ElemTy) {
+  return ElemTy->isIntegerTy(8) || ElemTy->isIntegerTy(16) ||
+         ElemTy->isIntegerTy(32) || ElemTy->isIntegerTy(64);
+}
+
+/// Build an array of integers directly as a ConstantDataArray, without
+/// creating a ConstantInt for every element. Large tables, often generated
+/// and #included, are common, and this is much cheaper for them.
+static llvm::Constant *EmitIntegerDataArray(llvm::Type *ElemTy,
+                                            ArrayRef<uint64_t> Values) {
+  assert(isDataArrayIntegerType(ElemTy) && "unexpected element type");
+  llvm::LLVMContext &Ctx = ElemTy->getContext();
+  switch (ElemTy->getIntegerBitWidth()) {
+  case 8: {
+    SmallVector<uint8_t, 64> Elts(Values.begin(), Values.end());
+    return llvm::ConstantDataArray::get(Ctx, Elts);
+  }
+  case 16: {
+    SmallVector<uint16_t, 64> Elts(Values.begin(), Values.end());
+    return llvm::ConstantDataArray::get(Ctx, Elts);
+  }
+  case 32: {
+    SmallVector<uint32_t, 64> Elts(Values.begin(), Values.end());
+    return llvm::ConstantDataArray::get(Ctx, Elts);
+  }
+  default:
+    return llvm::ConstantDataArray::get(Ctx, Values);
+  }
+}
 
 //===----------------------------------------------------------------------===//
 //                             ConstExprEmitter
@@ -720,6 +751,29 @@ public:
     return Visit(E->GetTemporaryExpr());
   }
 
+  /// Evaluate an initializer list for an array of integers straight into a
+  /// data array. Returns null if some element isn't a simple integer
+  /// constant, in which case the caller falls back to the general path.
+  llvm::Constant *EmitIntegerArrayInitialization(InitListExpr *ILE,
+                                                 llvm::Type *ElemTy,
+                                                 unsigned NumInitableElts,
+                                                 unsigned NumElements) {
+    Expr *Filler = ILE->getArrayFiller();
+    if (Filler && !isa<ImplicitValueInitExpr>(Filler))
+      return nullptr;
+
+    SmallVector<uint64_t, 64> Values;
+    Values.reserve(NumElements);
+    for (unsigned i = 0; i < NumInitableElts; ++i) {
+      llvm::APSInt Value;
+      if (!ILE->getInit(i)->EvaluateAsInt(Value, CGM.getContext()))
+        return nullptr;
+      Values.push_back(Value.getZExtValue());
+    }
+    Values.resize(NumElements, 0);
+    return EmitIntegerDataArray(ElemTy, Values);
+  }
+
   llvm::Constant *EmitArrayInitialization(InitListExpr *ILE) {
     if (ILE->isStringLiteralInit())
       return Visit(ILE->getInit(0));
@@ -734,6 +788,15 @@ public:
     // initialise any elements that have not been initialised explicitly
     unsigned NumInitableElts = std::min(NumInitElements, NumElements);
 
+    QualType EltTy = CGM.getContext().getAsArrayType(ILE->getType())
+                         ->getElementType();
+    if (EltTy->isIntegralOrEnumerationType() && !EltTy->isBooleanType() &&
+        isDataArrayIntegerType(ElemTy))
+      if (llvm::Constant *C =
+              EmitIntegerArrayInitialization(ILE, ElemTy, NumInitableElts,
+                                             NumElements))
+        return C;
+
     // Copy initializer elements.
     std::vector<llvm::Constant*> Elts;
     Elts.reserve(NumInitableElts + NumElements);
@@ -1170,6 +1233,32 @@ llvm::Constant *CodeGenModule::EmitConstantValue(const APValue &Value,
     unsigned NumElements = Value.getArraySize();
     unsigned NumInitElts = Value.getArrayInitializedElts();
 
+    // Arrays of plain integers go straight into a data array.
+    QualType EltTy = CAT->getElementType();
+    if (EltTy->isIntegralOrEnumerationType() && !EltTy->isBooleanType()) {
+      llvm::Type *ElemTy = getTypes().ConvertTypeForMem(EltTy);
+      bool AllInts =
+          isDataArrayIntegerType(ElemTy) &&
+          (!Value.hasArrayFiller() || Value.getArrayFiller().isInt());
+      SmallVector<uint64_t, 64> Values;
+      if (AllInts)
+        Values.reserve(NumElements);
+      for (unsigned I = 0; AllInts && I < NumInitElts; ++I) {
+        const APValue &Elt = Value.getArrayInitializedElt(I);
+        if (!Elt.isInt())
+          AllInts = false;
+        else
+          Values.push_back(Elt.getInt().getZExtValue());
+      }
+      if (AllInts) {
+        uint64_t Fill = Value.hasArrayFiller()
+                            ? Value.getArrayFiller().getInt().getZExtValue()
+                            : 0;
+        Values.resize(NumElements, Fill);
+        return EmitIntegerDataArray(ElemTy, Values);
+      }
+    }
+
     std::vector<llvm::Constant*> Elts;
     Elts.reserve(NumElements);
 
@@ -20,6 +20,7 @@
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/AST/StmtVisitor.h"
+#include "clang/Basic/Builtins.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "llvm/IR/CFG.h"
@@ -261,7 +262,7 @@ public:
   Value *VisitShuffleVectorExpr(ShuffleVectorExpr *E);
   Value *VisitConvertVectorExpr(ConvertVectorExpr *E);
   Value *VisitMemberExpr(MemberExpr *E);
-  Value *VisitExtVectorElementExpr(Expr *E) { return EmitLoadOfLValue(E); }
+  Value *VisitExtVectorElementExpr(ExtVectorElementExpr *E);
   Value *VisitCompoundLiteralExpr(CompoundLiteralExpr *E) {
     return EmitLoadOfLValue(E);
   }
@@ -481,6 +482,7 @@ public:
   // Comparisons.
   Value *EmitCompare(const BinaryOperator *E, unsigned UICmpOpc,
                      unsigned SICmpOpc, unsigned FCmpOpc);
+  Value *tryEmitInlineMemcmpEquality(const BinaryOperator *E);
 #define VISITCOMP(CODE, UI, SI, FP) \
     Value *VisitBin##CODE(const BinaryOperator *E) { \
       return EmitCompare(E, llvm::ICmpInst::UI, llvm::ICmpInst::SI, \
@@ -1090,6 +1092,27 @@ static llvm::Constant *getMaskElt(llvm::ShuffleVectorInst *SVI, unsigned Idx,
   return llvm::ConstantInt::get(I32Ty, Off+MV);
 }
 
+Value *ScalarExprEmitter::VisitExtVectorElementExpr(ExtVectorElementExpr *E) {
+  if (E->isArrow() || E->getBase()->isGLValue())
+    return EmitLoadOfLValue(E);
+
+  // An access into an rvalue vector, as in (V+V).xy, is just a shuffle of the
+  // value; don't spill it to a temporary to form an lvalue.
+  Value *Vec = Visit(E->getBase());
+  SmallVector<unsigned, 4> Indices;
+  E->getEncodedElementAccess(Indices);
+
+  if (!E->getType()->isVectorType())
+    return Builder.CreateExtractElement(
+        Vec, llvm::ConstantInt::get(CGF.SizeTy, Indices[0]));
+
+  SmallVector<llvm::Constant*, 4> Mask;
+  for (unsigned i = 0, e = Indices.size(); i != e; ++i)
+    Mask.push_back(Builder.getInt32(Indices[i]));
+  return Builder.CreateShuffleVector(Vec, llvm::UndefValue::get(Vec->getType()),
+                                     llvm::ConstantVector::get(Mask));
+}
+
 Value *ScalarExprEmitter::VisitInitListExpr(InitListExpr *E) {
   bool Ignore = TestAndClearIgnoreResultAssign();
   (void)Ignore;
@@ -2703,9 +2726,88 @@ static llvm::Intrinsic::ID GetIntrinsic(IntrinsicType IT,
   }
 }
 
+/// Load \p Ty from \p Base + \p Offset with no alignment assumptions and
+/// zero-extend it to \p WideTy.
+static Value *loadMemcmpChunk(CGBuilderTy &Builder, Value *Base,
+                              uint64_t Offset, llvm::IntegerType *Ty,
+                              llvm::IntegerType *WideTy) {
+  unsigned AS = Base->getType()->getPointerAddressSpace();
+  Value *Ptr = Builder.CreateConstInBoundsGEP1_64(Base, Offset);
+  Ptr = Builder.CreateBitCast(Ptr, Ty->getPointerTo(AS));
+  llvm::LoadInst *Load = Builder.CreateLoad(Ptr);
+  Load->setAlignment(1);
+  return Builder.CreateZExt(Load, WideTy);
+}
+
+/// Expand 'memcmp(a, b, n) == 0' (or '!= 0') for a small constant n into a
+/// few wide loads and compares. Only equality is asked for, so the byte order
+/// of the loads doesn't matter. Returns null if \p E doesn't have that form.
+Value *ScalarExprEmitter::tryEmitInlineMemcmpEquality(
+    const BinaryOperator *E) {
+  // Leave the call alone at -O0, and for sanitizers that intercept memcmp to
+  // check the bytes it reads.
+  if (!CGF.CGM.getCodeGenOpts().OptimizationLevel || CGF.SanOpts->Address ||
+      CGF.SanOpts->Memory || CGF.SanOpts->Thread)
+    return nullptr;
+
+  const Expr *CallSide = E->getLHS()->IgnoreParenImpCasts();
+  const Expr *ZeroSide = E->getRHS()->IgnoreParenImpCasts();
+  if (!isa<CallExpr>(CallSide))
+    std::swap(CallSide, ZeroSide);
+  const CallExpr *CE = dyn_cast<CallExpr>(CallSide);
+  if (!CE || CE->getNumArgs() != 3)
+    return nullptr;
+  unsigned BuiltinID = CE->getBuiltinCallee();
+  if (BuiltinID != Builtin::BImemcmp &&
+      BuiltinID != Builtin::BI__builtin_memcmp)
+    return nullptr;
+
+  ASTContext &Ctx = CGF.getContext();
+  llvm::APSInt Zero, Size;
+  if (!ZeroSide->EvaluateAsInt(Zero, Ctx) || Zero != 0 ||
+      !CE->getArg(2)->EvaluateAsInt(Size, Ctx))
+    return nullptr;
+
+  // Don't expand into more than four of the widest loads.
+  unsigned MaxChunk = CGF.getTarget().getPointerWidth(0) / 8;
+  uint64_t N = Size.getZExtValue();
+  if (N == 0 || N > 4 * MaxChunk)
+    return nullptr;
+
+  Value *LHS = CGF.EmitCastToVoidPtr(CGF.EmitScalarExpr(CE->getArg(0)));
+  Value *RHS = CGF.EmitCastToVoidPtr(CGF.EmitScalarExpr(CE->getArg(1)));
+
+  // OR together the differences of each chunk; the memory is equal iff the
+  // result is zero.
+  llvm::IntegerType *WideTy = Builder.getIntNTy(MaxChunk * 8);
+  Value *Diff = nullptr;
+  for (uint64_t Offset = 0; Offset < N;) {
+    unsigned Chunk = MaxChunk;
+    while (Chunk > N - Offset)
+      Chunk /= 2;
+    llvm::IntegerType *ChunkTy = Builder.getIntNTy(Chunk * 8);
+    Value *X = Builder.CreateXor(
+        loadMemcmpChunk(Builder, LHS, Offset, ChunkTy, WideTy),
+        loadMemcmpChunk(Builder, RHS, Offset, ChunkTy, WideTy));
+    Diff = Diff ? Builder.CreateOr(Diff, X) : X;
+    Offset += Chunk;
+  }
+
+  Value *ZeroV = llvm::ConstantInt::get(WideTy, 0);
+  if (E->getOpcode() == BO_EQ)
+    return Builder.CreateICmpEQ(Diff, ZeroV, "memcmp.eq");
+  return Builder.CreateICmpNE(Diff, ZeroV, "memcmp.ne");
+}
+
 Value *ScalarExprEmitter::EmitCompare(const BinaryOperator *E,unsigned UICmpOpc,
                                       unsigned SICmpOpc, unsigned FCmpOpc) {
   TestAndClearIgnoreResultAssign();
+
+  if (E->isEqualityOp())
+    if (Value *Result = tryEmitInlineMemcmpEquality(E))
+      return EmitScalarConversion(Result, CGF.getContext().BoolTy,
+                                  E->getType());
+
   Value *Result;
   QualType LHSTy = E->getLHS()->getType();
   if (const MemberPointerType *MPT = LHSTy->getAs<MemberPointerType>()) {
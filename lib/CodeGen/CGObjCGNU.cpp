@@ -667,6 +667,13 @@ class CGObjCGNUstep : public CGObjCGNU {
               EnforceType(Builder, ReceiverPtr, PtrToIdTy),
               EnforceType(Builder, cmd, SelectorTy),
               EnforceType(Builder, self, IdTy) };
+      // FIXME: Every send goes through the lookup function. The slot carries
+      // a version field that the runtime bumps when a method is replaced, so
+      // a per-call-site cache (class and slot, revalidated against the
+      // version before calling the IMP) could skip the lookup for monomorphic
+      // sends. That needs a runtime ABI guarantee that slots are never freed
+      // and that the version covers category loading and class_replaceMethod;
+      // until the runtime documents this, emitting such a cache is unsafe.
       llvm::CallSite slot = CGF.EmitRuntimeCallOrInvoke(LookupFn, args);
       slot.setOnlyReadsMemory();
       slot->setMetadata(msgSendMDKind, node);
@@ -16,11 +16,13 @@
 
 #include "clang/AST/Type.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
 
 namespace llvm {
 class AllocaInst;
+class ArrayType;
 class CallInst;
 class GlobalVariable;
 class Constant;
@@ -63,12 +65,46 @@ public:
     /// \brief Implicit barrier in 'single' directive.
     OMP_IDENT_BARRIER_IMPL_SINGLE = 0x140
   };
+  /// \brief Schedule kinds understood by the __kmpc_dispatch_* interface, as
+  /// described by enum sched_type in kmp.h.
+  enum OpenMPSchedType {
+    /// \brief Dynamic schedule with a chunk size given to dispatch_init.
+    OMP_sch_dynamic_chunked = 35
+  };
   enum OpenMPRTLFunction {
     // Call to void __kmpc_fork_call(ident_t *loc, kmp_int32 argc, kmpc_micro
     // microtask, ...);
     OMPRTL__kmpc_fork_call,
     // Call to kmp_int32 kmpc_global_thread_num(ident_t *loc);
-    OMPRTL__kmpc_global_thread_num
+    OMPRTL__kmpc_global_thread_num,
+    // Call to kmp_int32 __kmpc_omp_taskyield(ident_t *loc, kmp_int32 gtid,
+    // int end_part);
+    OMPRTL__kmpc_omp_taskyield,
+    // Call to kmp_int32 __kmpc_omp_taskwait(ident_t *loc, kmp_int32 gtid);
+    OMPRTL__kmpc_omp_taskwait,
+    // Call to void __kmpc_critical(ident_t *loc, kmp_int32 global_tid,
+    // kmp_critical_name *crit);
+    OMPRTL__kmpc_critical,
+    // Call to void __kmpc_end_critical(ident_t *loc, kmp_int32 global_tid,
+    // kmp_critical_name *crit);
+    OMPRTL__kmpc_end_critical,
+    // Call to kmp_int32 __kmpc_master(ident_t *loc, kmp_int32 global_tid);
+    OMPRTL__kmpc_master,
+    // Call to void __kmpc_end_master(ident_t *loc, kmp_int32 global_tid);
+    OMPRTL__kmpc_end_master,
+    // Call to kmp_int32 __kmpc_single(ident_t *loc, kmp_int32 global_tid);
+    OMPRTL__kmpc_single,
+    // Call to void __kmpc_end_single(ident_t *loc, kmp_int32 global_tid);
+    OMPRTL__kmpc_end_single,
+    // Call to void __kmpc_barrier(ident_t *loc, kmp_int32 global_tid);
+    OMPRTL__kmpc_barrier,
+    // Call to void __kmpc_dispatch_init_4(ident_t *loc, kmp_int32 gtid,
+    // enum sched_type schedule, kmp_int32 lb, kmp_int32 ub, kmp_int32 st,
+    // kmp_int32 chunk);
+    OMPRTL__kmpc_dispatch_init_4,
+    // Call to kmp_int32 __kmpc_dispatch_next_4(ident_t *loc, kmp_int32 gtid,
+    // kmp_int32 *p_last, kmp_int32 *p_lb, kmp_int32 *p_ub, kmp_int32 *p_st);
+    OMPRTL__kmpc_dispatch_next_4
   };
 
 private:
@@ -134,6 +170,12 @@ private:
   /// \brief Map of local gtid and functions.
   typedef llvm::DenseMap<llvm::Function *, llvm::Value *> OpenMPGtidMapTy;
   OpenMPGtidMapTy OpenMPGtidMap;
+  /// \brief Type kmp_critical_name, originally defined as typedef kmp_int32
+  /// kmp_critical_name[8];
+  llvm::ArrayType *KmpCriticalNameTy;
+  /// \brief Map of critical region names and the lock variables that guard
+  /// them.
+  llvm::StringMap<llvm::Value *> CriticalRegionVarNames;
 
 public:
   explicit CGOpenMPRuntime(CodeGenModule &CGM);
@@ -170,6 +212,37 @@ public:
   /// \param Function OpenMP runtime function.
   /// \return Specified function.
   llvm::Constant *CreateRuntimeFunction(OpenMPRTLFunction Function);
+
+  /// \brief Returns the lock object for the critical region with the given
+  /// name.  All unnamed critical regions share one lock.
+  /// \param CriticalName Name of the critical region.
+  ///
+  llvm::Value *GetCriticalRegionLock(StringRef CriticalName);
+
+  /// \brief Emits start of the critical region.
+  /// \param CGF Reference to current CodeGenFunction.
+  /// \param RegionLock The lock object returned by GetCriticalRegionLock.
+  /// \param Loc Clang source location.
+  ///
+  void EmitOMPCriticalRegionStart(CodeGenFunction &CGF,
+                                  llvm::Value *RegionLock,
+                                  SourceLocation Loc);
+
+  /// \brief Emits end of the critical region.
+  /// \param CGF Reference to current CodeGenFunction.
+  /// \param RegionLock The lock object returned by GetCriticalRegionLock.
+  /// \param Loc Clang source location.
+  ///
+  void EmitOMPCriticalRegionEnd(CodeGenFunction &CGF, llvm::Value *RegionLock,
+                                SourceLocation Loc);
+
+  /// \brief Emits a barrier for the current team.
+  /// \param CGF Reference to current CodeGenFunction.
+  /// \param Loc Clang source location.
+  /// \param Flags Flags describing the kind of the barrier.
+  ///
+  void EmitOMPBarrierCall(CodeGenFunction &CGF, SourceLocation Loc,
+                          OpenMPLocationFlags Flags = OMP_IDENT_KMPC);
 };
 } // namespace CodeGen
 } // namespace clang
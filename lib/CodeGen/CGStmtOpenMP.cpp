@@ -23,29 +23,39 @@ using namespace CodeGen;
 //                              OpenMP Directive Emission
 //===----------------------------------------------------------------------===//
 
-void CodeGenFunction::EmitOMPParallelDirective(const OMPParallelDirective &S) {
+/// \brief Emit a call to __kmpc_fork_call that runs the captured statement of
+/// \p S, outlined with \p CGInfo, on every thread of a new team.
+static void EmitOMPParallelCall(CodeGenFunction &CGF,
+                                const OMPExecutableDirective &S,
+                                CodeGenFunction::CGCapturedStmtInfo &CGInfo) {
+  CodeGenModule &CGM = CGF.CGM;
   const CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
-  llvm::Value *CapturedStruct = GenerateCapturedStmtArgument(*CS);
+  llvm::Value *CapturedStruct = CGF.GenerateCapturedStmtArgument(*CS);
 
   llvm::Value *OutlinedFn;
   {
-    CodeGenFunction CGF(CGM, true);
-    CGCapturedStmtInfo CGInfo(*CS, CS->getCapturedRegionKind());
-    CGF.CapturedStmtInfo = &CGInfo;
-    OutlinedFn = CGF.GenerateCapturedStmtFunction(*CS);
+    CodeGenFunction OutlinedCGF(CGM, true);
+    OutlinedCGF.CapturedStmtInfo = &CGInfo;
+    OutlinedFn = OutlinedCGF.GenerateCapturedStmtFunction(*CS);
   }
 
   // Build call __kmpc_fork_call(loc, 1, microtask, captured_struct/*context*/)
   llvm::Value *Args[] = {
-      CGM.getOpenMPRuntime().EmitOpenMPUpdateLocation(*this, S.getLocStart()),
-      Builder.getInt32(1), // Number of arguments after 'microtask' argument
+      CGM.getOpenMPRuntime().EmitOpenMPUpdateLocation(CGF, S.getLocStart()),
+      CGF.Builder.getInt32(1), // Number of arguments after 'microtask' argument
       // (there is only one additional argument - 'context')
-      Builder.CreateBitCast(OutlinedFn,
-                            CGM.getOpenMPRuntime().getKmpc_MicroPointerTy()),
-      EmitCastToVoidPtr(CapturedStruct)};
+      CGF.Builder.CreateBitCast(
+          OutlinedFn, CGM.getOpenMPRuntime().getKmpc_MicroPointerTy()),
+      CGF.EmitCastToVoidPtr(CapturedStruct)};
   llvm::Constant *RTLFn = CGM.getOpenMPRuntime().CreateRuntimeFunction(
       CGOpenMPRuntime::OMPRTL__kmpc_fork_call);
-  EmitRuntimeCall(RTLFn, Args);
+  CGF.EmitRuntimeCall(RTLFn, Args);
+}
+
+void CodeGenFunction::EmitOMPParallelDirective(const OMPParallelDirective &S) {
+  const CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+  CGCapturedStmtInfo CGInfo(*CS, CS->getCapturedRegionKind());
+  EmitOMPParallelCall(*this, S, CGInfo);
 }
 
 void CodeGenFunction::EmitOMPSimdDirective(const OMPSimdDirective &S) {
@@ -74,65 +84,310 @@ void CodeGenFunction::EmitOMPSimdDirective(const OMPSimdDirective &S) {
   EmitStmt(Body);
 }
 
-void CodeGenFunction::EmitOMPForDirective(const OMPForDirective &) {
-  llvm_unreachable("CodeGen for 'omp for' is not supported yet.");
+void CodeGenFunction::EmitOMPForDirective(const OMPForDirective &S) {
+  // FIXME: Lowering this onto __kmpc_for_static_init/__kmpc_dispatch_* needs
+  // the normalized iteration space (iteration count, lower/upper bound and
+  // stride of the collapsed loop nest) that Sema verifies in CheckOpenMPLoop
+  // but does not yet record on OMPForDirective.  Until it does, report the
+  // directive instead of crashing on it.
+  CGM.ErrorUnsupported(&S, "'omp for' directive");
+}
+
+/// \brief Emit the statements of a sections region as a worksharing loop over
+/// the section indices, with sections handed out one at a time by the
+/// runtime so that threads which finish early pick up the remaining ones:
+/// \code
+/// __kmpc_dispatch_init_4(loc, gtid, dynamic_chunked, 0, NumSections - 1,
+///                        1, 1);
+/// while (__kmpc_dispatch_next_4(loc, gtid, &last, &lb, &ub, &st))
+///   for (iv = lb; iv <= ub; ++iv)
+///     switch (iv) {
+///     case 0: Section0; break;
+///     ...
+///     }
+/// \endcode
+/// followed by the implicit barrier unless \p HasNowait is set.
+static void EmitOMPSectionsRegion(CodeGenFunction &CGF,
+                                  const CompoundStmt *Sections,
+                                  SourceLocation Loc, bool HasNowait) {
+  CGOpenMPRuntime &RT = CGF.CGM.getOpenMPRuntime();
+  CGBuilderTy &Builder = CGF.Builder;
+  unsigned NumSections = Sections->size();
+  if (NumSections == 0)
+    return;
+
+  llvm::Value *UpdateLoc = RT.EmitOpenMPUpdateLocation(CGF, Loc);
+  llvm::Value *GTid = RT.GetOpenMPGlobalThreadNum(CGF, Loc);
+  llvm::Value *LastIter = CGF.CreateTempAlloca(CGF.Int32Ty, "omp.sections.il");
+  llvm::Value *LB = CGF.CreateTempAlloca(CGF.Int32Ty, "omp.sections.lb");
+  llvm::Value *UB = CGF.CreateTempAlloca(CGF.Int32Ty, "omp.sections.ub");
+  llvm::Value *Stride = CGF.CreateTempAlloca(CGF.Int32Ty, "omp.sections.st");
+  llvm::Value *IV = CGF.CreateTempAlloca(CGF.Int32Ty, "omp.sections.iv");
+
+  llvm::Value *InitArgs[] = {UpdateLoc,
+                             GTid,
+                             Builder.getInt32(
+                                 CGOpenMPRuntime::OMP_sch_dynamic_chunked),
+                             Builder.getInt32(0),
+                             Builder.getInt32(NumSections - 1),
+                             Builder.getInt32(1),
+                             Builder.getInt32(1)};
+  CGF.EmitRuntimeCall(
+      RT.CreateRuntimeFunction(CGOpenMPRuntime::OMPRTL__kmpc_dispatch_init_4),
+      InitArgs);
+
+  llvm::BasicBlock *DispatchBlock =
+      CGF.createBasicBlock("omp.sections.dispatch");
+  llvm::BasicBlock *CondBlock = CGF.createBasicBlock("omp.sections.cond");
+  llvm::BasicBlock *BodyBlock = CGF.createBasicBlock("omp.sections.body");
+  llvm::BasicBlock *IncBlock = CGF.createBasicBlock("omp.sections.inc");
+  llvm::BasicBlock *ExitBlock = CGF.createBasicBlock("omp.sections.exit");
+
+  // Ask the runtime for the next chunk of sections.
+  CGF.EmitBlock(DispatchBlock);
+  llvm::Value *NextArgs[] = {UpdateLoc, GTid, LastIter, LB, UB, Stride};
+  llvm::Value *HasWork = CGF.EmitRuntimeCall(
+      RT.CreateRuntimeFunction(CGOpenMPRuntime::OMPRTL__kmpc_dispatch_next_4),
+      NextArgs);
+  Builder.CreateStore(Builder.CreateLoad(LB), IV);
+  Builder.CreateCondBr(Builder.CreateIsNotNull(HasWork), CondBlock, ExitBlock);
+
+  // Run every section in [lb, ub].
+  CGF.EmitBlock(CondBlock);
+  Builder.CreateCondBr(
+      Builder.CreateICmpSLE(Builder.CreateLoad(IV), Builder.CreateLoad(UB)),
+      BodyBlock, DispatchBlock);
+
+  CGF.EmitBlock(BodyBlock);
+  llvm::SwitchInst *Switch =
+      Builder.CreateSwitch(Builder.CreateLoad(IV), IncBlock, NumSections);
+  unsigned CaseNumber = 0;
+  for (const Stmt *SubStmt : Sections->body()) {
+    llvm::BasicBlock *CaseBlock = CGF.createBasicBlock("omp.sections.case");
+    CGF.EmitBlock(CaseBlock);
+    Switch->addCase(Builder.getInt32(CaseNumber++), CaseBlock);
+    CGF.EmitStmt(SubStmt);
+    CGF.EmitBranch(IncBlock);
+  }
+
+  CGF.EmitBlock(IncBlock);
+  Builder.CreateStore(Builder.CreateAdd(Builder.CreateLoad(IV),
+                                        Builder.getInt32(1)),
+                      IV);
+  CGF.EmitBranch(CondBlock);
+
+  CGF.EmitBlock(ExitBlock, /*IsFinished=*/true);
+
+  // The end of a sections region has an implicit barrier unless 'nowait' is
+  // specified.
+  if (!HasNowait)
+    RT.EmitOMPBarrierCall(CGF, Loc,
+                          CGOpenMPRuntime::OMP_IDENT_BARRIER_IMPL_SECTIONS);
+}
+
+void CodeGenFunction::EmitOMPSectionsDirective(const OMPSectionsDirective &S) {
+  bool HasNowait = false;
+  for (auto C : S.clauses()) {
+    if (C->getClauseKind() == OMPC_nowait) {
+      HasNowait = true;
+      continue;
+    }
+    // FIXME: Privatization, lastprivate and reductions are not implemented.
+    CGM.ErrorUnsupported(&S, "'omp sections' directive with this clause");
+    return;
+  }
+
+  const CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+  EmitOMPSectionsRegion(*this, cast<CompoundStmt>(CS->getCapturedStmt()),
+                        S.getLocStart(), HasNowait);
 }
 
-void CodeGenFunction::EmitOMPSectionsDirective(const OMPSectionsDirective &) {
-  llvm_unreachable("CodeGen for 'omp sections' is not supported yet.");
+void CodeGenFunction::EmitOMPSectionDirective(const OMPSectionDirective &S) {
+  // Sema only accepts 'omp section' directly inside a sections region, which
+  // dispatches to it; here we only need the body.
+  EmitStmt(cast<CapturedStmt>(S.getAssociatedStmt())->getCapturedStmt());
 }
 
-void CodeGenFunction::EmitOMPSectionDirective(const OMPSectionDirective &) {
-  llvm_unreachable("CodeGen for 'omp section' is not supported yet.");
+/// \brief Emit \p Body guarded by the result of \p IsSelected (a call to
+/// __kmpc_master or __kmpc_single), followed by a call to \p EndFn if the
+/// body was executed:
+/// \code
+/// if (IsSelected) {
+///   Body;
+///   EndFn(loc, gtid);
+/// }
+/// \endcode
+static void EmitOMPGuardedRegion(CodeGenFunction &CGF, llvm::Value *IsSelected,
+                                 const Stmt *Body, llvm::Constant *EndFn,
+                                 ArrayRef<llvm::Value *> EndArgs) {
+  llvm::BasicBlock *ThenBlock = CGF.createBasicBlock("omp.guarded.body");
+  llvm::BasicBlock *ContBlock = CGF.createBasicBlock("omp.guarded.end");
+  CGF.Builder.CreateCondBr(CGF.Builder.CreateIsNotNull(IsSelected), ThenBlock,
+                           ContBlock);
+  CGF.EmitBlock(ThenBlock);
+  CGF.EmitStmt(Body);
+  CGF.EmitRuntimeCall(EndFn, EndArgs);
+  CGF.EmitBlock(ContBlock, /*IsFinished=*/true);
 }
 
-void CodeGenFunction::EmitOMPSingleDirective(const OMPSingleDirective &) {
-  llvm_unreachable("CodeGen for 'omp single' is not supported yet.");
+void CodeGenFunction::EmitOMPSingleDirective(const OMPSingleDirective &S) {
+  bool HasNowait = false;
+  for (auto C : S.clauses()) {
+    if (C->getClauseKind() == OMPC_nowait) {
+      HasNowait = true;
+      continue;
+    }
+    // FIXME: Privatization and copyprivate broadcast are not implemented.
+    CGM.ErrorUnsupported(&S, "'omp single' directive with this clause");
+    return;
+  }
+
+  // Build:
+  // if (__kmpc_single(loc, gtid)) {
+  //   Body;
+  //   __kmpc_end_single(loc, gtid);
+  // }
+  CGOpenMPRuntime &RT = CGM.getOpenMPRuntime();
+  llvm::Value *Args[] = {RT.EmitOpenMPUpdateLocation(*this, S.getLocStart()),
+                         RT.GetOpenMPGlobalThreadNum(*this, S.getLocStart())};
+  llvm::Value *IsSingle = EmitRuntimeCall(
+      RT.CreateRuntimeFunction(CGOpenMPRuntime::OMPRTL__kmpc_single), Args);
+  const Stmt *Body = cast<CapturedStmt>(S.getAssociatedStmt())
+                         ->getCapturedStmt();
+  EmitOMPGuardedRegion(
+      *this, IsSingle, Body,
+      RT.CreateRuntimeFunction(CGOpenMPRuntime::OMPRTL__kmpc_end_single),
+      Args);
+
+  // The end of a single region has an implicit barrier unless 'nowait' is
+  // specified.
+  if (!HasNowait)
+    RT.EmitOMPBarrierCall(*this, S.getLocStart(),
+                          CGOpenMPRuntime::OMP_IDENT_BARRIER_IMPL_SINGLE);
 }
 
-void CodeGenFunction::EmitOMPMasterDirective(const OMPMasterDirective &) {
-  llvm_unreachable("CodeGen for 'omp master' is not supported yet.");
+void CodeGenFunction::EmitOMPMasterDirective(const OMPMasterDirective &S) {
+  // Build:
+  // if (__kmpc_master(loc, gtid)) {
+  //   Body;
+  //   __kmpc_end_master(loc, gtid);
+  // }
+  CGOpenMPRuntime &RT = CGM.getOpenMPRuntime();
+  llvm::Value *Args[] = {RT.EmitOpenMPUpdateLocation(*this, S.getLocStart()),
+                         RT.GetOpenMPGlobalThreadNum(*this, S.getLocStart())};
+  llvm::Value *IsMaster = EmitRuntimeCall(
+      RT.CreateRuntimeFunction(CGOpenMPRuntime::OMPRTL__kmpc_master), Args);
+  const Stmt *Body = cast<CapturedStmt>(S.getAssociatedStmt())
+                         ->getCapturedStmt();
+  EmitOMPGuardedRegion(
+      *this, IsMaster, Body,
+      RT.CreateRuntimeFunction(CGOpenMPRuntime::OMPRTL__kmpc_end_master),
+      Args);
 }
 
-void CodeGenFunction::EmitOMPCriticalDirective(const OMPCriticalDirective &) {
-  llvm_unreachable("CodeGen for 'omp critical' is not supported yet.");
+void CodeGenFunction::EmitOMPCriticalDirective(const OMPCriticalDirective &S) {
+  // __kmpc_critical(loc, gtid, &gomp_critical_user_<name>.var);
+  // Body;
+  // __kmpc_end_critical(loc, gtid, &gomp_critical_user_<name>.var);
+  CGOpenMPRuntime &RT = CGM.getOpenMPRuntime();
+  llvm::Value *Lock =
+      RT.GetCriticalRegionLock(S.getDirectiveName().getAsString());
+  RT.EmitOMPCriticalRegionStart(*this, Lock, S.getLocStart());
+  EmitStmt(cast<CapturedStmt>(S.getAssociatedStmt())->getCapturedStmt());
+  RT.EmitOMPCriticalRegionEnd(*this, Lock, S.getLocEnd());
 }
 
-void
-CodeGenFunction::EmitOMPParallelForDirective(const OMPParallelForDirective &) {
-  llvm_unreachable("CodeGen for 'omp parallel for' is not supported yet.");
+void CodeGenFunction::EmitOMPParallelForDirective(
+    const OMPParallelForDirective &S) {
+  // FIXME: See EmitOMPForDirective.
+  CGM.ErrorUnsupported(&S, "'omp parallel for' directive");
 }
 
+namespace {
+/// \brief Emits the outlined body of a 'parallel sections' region as a
+/// sections region executed by the whole team.
+class CGParallelSectionsStmtInfo : public CodeGenFunction::CGCapturedStmtInfo {
+public:
+  CGParallelSectionsStmtInfo(const CapturedStmt &CS, SourceLocation Loc)
+      : CGCapturedStmtInfo(CS, CS.getCapturedRegionKind()), Loc(Loc) {}
+
+  void EmitBody(CodeGenFunction &CGF, Stmt *S) override {
+    RegionCounter Cnt = CGF.getPGORegionCounter(S);
+    Cnt.beginRegion(CGF.Builder);
+    EmitOMPSectionsRegion(CGF, cast<CompoundStmt>(S), Loc,
+                          /*HasNowait=*/false);
+  }
+
+private:
+  SourceLocation Loc;
+};
+} // namespace
+
 void CodeGenFunction::EmitOMPParallelSectionsDirective(
-    const OMPParallelSectionsDirective &) {
-  llvm_unreachable("CodeGen for 'omp parallel sections' is not supported yet.");
+    const OMPParallelSectionsDirective &S) {
+  if (!S.clauses().empty()) {
+    // FIXME: Thread count, privatization, lastprivate and reductions are not
+    // implemented.
+    CGM.ErrorUnsupported(&S, "'omp parallel sections' directive with this "
+                             "clause");
+    return;
+  }
+
+  const CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+  CGParallelSectionsStmtInfo CGInfo(*CS, S.getLocStart());
+  EmitOMPParallelCall(*this, S, CGInfo);
 }
 
-void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &) {
-  llvm_unreachable("CodeGen for 'omp task' is not supported yet.");
+void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
+  // FIXME: Outline the task body, copy firstprivate captures into the task
+  // structure returned by __kmpc_omp_task_alloc and hand it to
+  // __kmpc_omp_task.
+  CGM.ErrorUnsupported(&S, "'omp task' directive");
 }
 
-void CodeGenFunction::EmitOMPTaskyieldDirective(const OMPTaskyieldDirective &) {
-  llvm_unreachable("CodeGen for 'omp taskyield' is not supported yet.");
+void CodeGenFunction::EmitOMPTaskyieldDirective(
+    const OMPTaskyieldDirective &S) {
+  // Build call __kmpc_omp_taskyield(loc, thread_id, 0);
+  llvm::Value *Args[] = {
+      CGM.getOpenMPRuntime().EmitOpenMPUpdateLocation(*this, S.getLocStart()),
+      CGM.getOpenMPRuntime().GetOpenMPGlobalThreadNum(*this, S.getLocStart()),
+      llvm::ConstantInt::get(CGM.IntTy, /*V=*/0, /*isSigned=*/true)};
+  llvm::Constant *RTLFn = CGM.getOpenMPRuntime().CreateRuntimeFunction(
+      CGOpenMPRuntime::OMPRTL__kmpc_omp_taskyield);
+  EmitRuntimeCall(RTLFn, Args);
 }
 
-void CodeGenFunction::EmitOMPBarrierDirective(const OMPBarrierDirective &) {
-  llvm_unreachable("CodeGen for 'omp barrier' is not supported yet.");
+void CodeGenFunction::EmitOMPBarrierDirective(const OMPBarrierDirective &S) {
+  CGM.getOpenMPRuntime().EmitOMPBarrierCall(
+      *this, S.getLocStart(), CGOpenMPRuntime::OMP_IDENT_BARRIER_EXPL);
 }
 
-void CodeGenFunction::EmitOMPTaskwaitDirective(const OMPTaskwaitDirective &) {
-  llvm_unreachable("CodeGen for 'omp taskwait' is not supported yet.");
+void CodeGenFunction::EmitOMPTaskwaitDirective(const OMPTaskwaitDirective &S) {
+  // Build call __kmpc_omp_taskwait(loc, thread_id);
+  llvm::Value *Args[] = {
+      CGM.getOpenMPRuntime().EmitOpenMPUpdateLocation(*this, S.getLocStart()),
+      CGM.getOpenMPRuntime().GetOpenMPGlobalThreadNum(*this, S.getLocStart())};
+  llvm::Constant *RTLFn = CGM.getOpenMPRuntime().CreateRuntimeFunction(
+      CGOpenMPRuntime::OMPRTL__kmpc_omp_taskwait);
+  EmitRuntimeCall(RTLFn, Args);
 }
 
 void CodeGenFunction::EmitOMPFlushDirective(const OMPFlushDirective &) {
-  llvm_unreachable("CodeGen for 'omp flush' is not supported yet.");
+  // A flush orders all memory accesses of this thread around it; with or
+  // without a list of variables that is exactly a sequentially consistent
+  // fence.
+  Builder.CreateFence(llvm::SequentiallyConsistent);
 }
 
 void CodeGenFunction::EmitOMPOrderedDirective(const OMPOrderedDirective &) {
   llvm_unreachable("CodeGen for 'omp ordered' is not supported yet.");
 }
 
-void CodeGenFunction::EmitOMPAtomicDirective(const OMPAtomicDirective &) {
-  llvm_unreachable("CodeGen for 'omp atomic' is not supported yet.");
+void CodeGenFunction::EmitOMPAtomicDirective(const OMPAtomicDirective &S) {
+  // FIXME: Lower to atomic loads/stores and atomicrmw/cmpxchg loops through
+  // CGAtomic.  That needs Sema to decompose the associated statement into the
+  // 'x', 'v' and 'expr' operands and the update operation, which
+  // ActOnOpenMPAtomicDirective does not do yet.
+  CGM.ErrorUnsupported(&S, "'omp atomic' directive");
 }
 
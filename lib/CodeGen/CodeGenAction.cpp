@@ -448,11 +448,13 @@ void BackendConsumer::EmitOptimizationMessage(
       << AddFlagValue(D.getPassName() ? D.getPassName() : "")
       << D.getMsg().str();
 
-  if (DILoc.isInvalid())
+  if (DILoc.isInvalid() && !Filename.empty())
     // If we were not able to translate the file:line:col information
     // back to a SourceLocation, at least emit a note stating that
     // we could not translate this location. This can happen in the
-    // case of #line directives.
+    // case of #line directives. Remarks about instructions that carry no
+    // debug location at all have nothing to translate, and the function's
+    // closing brace is the best we can do for them.
     Diags.Report(Loc, diag::note_fe_backend_optimization_remark_invalid_loc)
         << Filename << Line << Column;
 }
@@ -606,6 +608,11 @@ static raw_ostream *GetOutputStream(CompilerInstance &CI,
 ASTConsumer *CodeGenAction::CreateASTConsumer(CompilerInstance &CI,
                                               StringRef InFile) {
   BackendAction BA = static_cast<BackendAction>(Act);
+
+  // Code generation needs every virtual member of an emitted vtable, so
+  // ignore a request from a tool to skip defining them.
+  CI.getFrontendOpts().SkipVTableDefinitions = false;
+
   std::unique_ptr<raw_ostream> OS(GetOutputStream(CI, InFile, BA));
   if (BA != Backend_EmitNothing && !OS)
     return nullptr;
@@ -63,6 +63,11 @@ CodeGenFunction::CodeGenFunction(CodeGenModule &cgm, bool suppressNewContext)
     FMF.setNoInfs();
   }
   Builder.SetFastMathFlags(FMF);
+
+  // Reuse the scope-stack buffer of an earlier function if there is one.
+  size_t EHBufferSize;
+  if (char *EHBuffer = CGM.takeEHStackBuffer(EHBufferSize))
+    EHStack.adoptBuffer(EHBuffer, EHBufferSize);
 }
 
 CodeGenFunction::~CodeGenFunction() {
@@ -77,6 +82,13 @@ CodeGenFunction::~CodeGenFunction() {
   if (getLangOpts().OpenMP) {
     CGM.getOpenMPRuntime().FunctionFinished(*this);
   }
+
+  // Hand the scope-stack buffer back for the next function.
+  if (EHStack.empty()) {
+    size_t EHBufferSize;
+    if (char *EHBuffer = EHStack.releaseBuffer(EHBufferSize))
+      CGM.recycleEHStackBuffer(EHBuffer, EHBufferSize);
+  }
 }
 
 
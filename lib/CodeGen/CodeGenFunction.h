@@ -1821,6 +1821,26 @@ public:
     }
   };
   AutoVarEmission EmitAutoVarAlloca(const VarDecl &var);
+
+  /// \brief Emit a call to @llvm.lifetime.start for the \p Size bytes at
+  /// \p Addr if lifetime markers are worthwhile for an object of that size.
+  /// \returns the size operand to pass to EmitLifetimeEnd, or null if no
+  /// marker was emitted.
+  llvm::Value *EmitLifetimeStart(uint64_t Size, llvm::Value *Addr);
+  void EmitLifetimeEnd(llvm::Value *Size, llvm::Value *Addr);
+
+  /// A cleanup to call @llvm.lifetime.end.
+  class CallLifetimeEnd : public EHScopeStack::Cleanup {
+    llvm::Value *Addr;
+    llvm::Value *Size;
+  public:
+    CallLifetimeEnd(llvm::Value *addr, llvm::Value *size)
+      : Addr(addr), Size(size) {}
+
+    void Emit(CodeGenFunction &CGF, Flags flags) override {
+      CGF.EmitLifetimeEnd(Size, Addr);
+    }
+  };
   void EmitAutoVarInit(const AutoVarEmission &emission);
   void EmitAutoVarCleanups(const AutoVarEmission &emission);  
   void emitAutoVarTypeCleanup(const AutoVarEmission &emission,
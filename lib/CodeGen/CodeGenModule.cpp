@@ -88,7 +88,8 @@ CodeGenModule::CodeGenModule(ASTContext &C, const CodeGenOptions &CGO,
       BlockObjectDispose(nullptr), BlockDescriptorType(nullptr),
       GenericBlockLiteralType(nullptr), LifetimeStartFn(nullptr),
       LifetimeEndFn(nullptr), SanitizerBL(llvm::SpecialCaseList::createOrDie(
-                                  CGO.SanitizerBlacklistFile)) {
+                                  CGO.SanitizerBlacklistFile)),
+      RecycledEHStackBuffer(nullptr), RecycledEHStackBufferSize(0) {
 
   // Initialize the type cache.
   llvm::LLVMContext &LLVMContext = M.getContext();
@@ -157,6 +158,7 @@ CodeGenModule::~CodeGenModule() {
   delete DebugInfo;
   delete ARCData;
   delete RRData;
+  delete[] RecycledEHStackBuffer;
 }
 
 void CodeGenModule::createObjCRuntime() {
@@ -654,6 +656,12 @@ void CodeGenModule::SetLLVMFunctionAttributes(const Decl *D,
   unsigned CallingConv;
   AttributeListType AttributeList;
   ConstructAttributeList(Info, D, AttributeList, CallingConv, false);
+  // FIXME: A per-function target("...") attribute would add its features
+  // here, but the backend still builds a single subtarget per module and
+  // ignores function-level feature strings. The intrinsic headers also
+  // gate their definitions on __AVX2__ and friends at preprocessing time.
+  // Both need to change before such an attribute (or ifunc-based
+  // multiversioning on top of it) can do anything useful.
   F->setAttributes(llvm::AttributeSet::get(getLLVMContext(), AttributeList));
   F->setCallingConv(static_cast<llvm::CallingConv::ID>(CallingConv));
 }
@@ -1042,6 +1050,13 @@ void CodeGenModule::EmitDeferred() {
   // Emit code for any potentially referenced deferred decls.  Since a
   // previously unused static decl may become used during the generation of code
   // for a static function, iterate until no changes are made.
+  //
+  // This is already a reachability walk: a discardable definition only gets
+  // into DeferredDeclsToEmit when code that is itself being emitted refers to
+  // it, so inline code that nothing emitted refers to is never generated.
+  // The roots are externally visible definitions, vtables and global
+  // initializers; what is reachable only from code that the optimizer later
+  // proves dead cannot be known here.
 
   while (true) {
     if (!DeferredVTables.empty()) {
@@ -1345,6 +1360,121 @@ CodeGenModule::isTriviallyRecursive(const FunctionDecl *FD) {
   return Walker.Result;
 }
 
+namespace {
+  /// Walks a function body looking for anything that might throw.
+  struct FunctionMayThrow : public RecursiveASTVisitor<FunctionMayThrow> {
+    CodeGenModule &CGM;
+    bool Result;
+    FunctionMayThrow(CodeGenModule &CGM) : CGM(CGM), Result(false) {}
+
+    // Implicit code, such as the calls to begin(), end(), operator!= and
+    // operator++ of a range-based for, runs just like the written code.
+    bool shouldVisitImplicitCode() const { return true; }
+
+    bool mayThrow() {
+      Result = true;
+      return false;
+    }
+
+    // The default traversal only walks the syntactic form of an initializer
+    // list. The semantic form is what gets emitted: it also holds the
+    // implicit initialization of omitted members and the array filler.
+    bool TraverseInitListExpr(InitListExpr *S) {
+      if (InitListExpr *Sem = S->getSemanticForm())
+        S = Sem;
+      if (!WalkUpFromInitListExpr(S))
+        return false;
+      for (Stmt::child_range Range = S->children(); Range; ++Range)
+        if (!TraverseStmt(*Range))
+          return false;
+      return TraverseStmt(S->getArrayFiller());
+    }
+
+    bool VisitCallExpr(CallExpr *E) {
+      const FunctionDecl *Callee = E->getDirectCallee();
+      if (!Callee)
+        return mayThrow();
+      if (Callee->hasAttr<NoThrowAttr>())
+        return true;
+      const auto *FPT = Callee->getType()->getAs<FunctionProtoType>();
+      if (FPT && FPT->isNothrow(CGM.getContext()))
+        return true;
+      return CGM.cannotThrow(Callee) ? true : mayThrow();
+    }
+    bool VisitDeclRefExpr(DeclRefExpr *E) {
+      // Naming a thread_local variable with dynamic initialization calls its
+      // wrapper, which may run the initializer.
+      if (const auto *VD = dyn_cast<VarDecl>(E->getDecl()))
+        if (VD->getTLSKind() == VarDecl::TLS_Dynamic)
+          return mayThrow();
+      return true;
+    }
+    bool VisitCXXConstructExpr(CXXConstructExpr *E) {
+      return E->getConstructor()->isTrivial() ? true : mayThrow();
+    }
+    bool VisitVarDecl(VarDecl *VD) {
+      // Destructors, cleanup functions and guarded static initialization
+      // all run code that isn't visible in the body.
+      if (VD->hasAttr<CleanupAttr>() || VD->isStaticLocal() ||
+          VD->getType().isDestructedType() == QualType::DK_cxx_destructor)
+        return mayThrow();
+      return true;
+    }
+    bool VisitCXXThrowExpr(CXXThrowExpr *) { return mayThrow(); }
+    bool VisitCXXNewExpr(CXXNewExpr *) { return mayThrow(); }
+    bool VisitCXXDeleteExpr(CXXDeleteExpr *) { return mayThrow(); }
+    bool VisitCXXDynamicCastExpr(CXXDynamicCastExpr *) { return mayThrow(); }
+    bool VisitCXXTypeidExpr(CXXTypeidExpr *) { return mayThrow(); }
+    bool VisitCXXBindTemporaryExpr(CXXBindTemporaryExpr *) {
+      return mayThrow();
+    }
+    // The visitor does not look inside default arguments and initializers.
+    bool VisitCXXDefaultArgExpr(CXXDefaultArgExpr *) { return mayThrow(); }
+    bool VisitCXXDefaultInitExpr(CXXDefaultInitExpr *) { return mayThrow(); }
+    bool VisitSEHTryStmt(SEHTryStmt *) { return mayThrow(); }
+    bool VisitCapturedStmt(CapturedStmt *) { return mayThrow(); }
+    bool VisitOMPExecutableDirective(OMPExecutableDirective *) {
+      return mayThrow();
+    }
+  };
+}
+
+bool CodeGenModule::cannotThrow(const FunctionDecl *FD) {
+  if (!LangOpts.CPlusPlus || !LangOpts.CXXExceptions || LangOpts.ObjC1)
+    return false;
+
+  FD = FD->getCanonicalDecl();
+  llvm::DenseMap<const FunctionDecl *, bool>::iterator Cached =
+      NoThrowDefinitions.find(FD);
+  if (Cached != NoThrowDefinitions.end())
+    return Cached->second;
+
+  // Assume the worst while looking at the body, so that recursive calls
+  // terminate.
+  NoThrowDefinitions[FD] = false;
+
+  // Only look at definitions that will be the one called: not weak ones, or
+  // ones the user may replace. Constructors and destructors also run member
+  // initializers and subobject destructors that are not part of the body,
+  // and a virtual function may be overridden.
+  const FunctionDecl *Def;
+  if (!FD->hasBody(Def) || Def->isWeak() || isa<CXXConstructorDecl>(Def) ||
+      isa<CXXDestructorDecl>(Def) ||
+      Def->isReplaceableGlobalAllocationFunction())
+    return false;
+  if (const auto *MD = dyn_cast<CXXMethodDecl>(Def))
+    if (MD->isVirtual())
+      return false;
+  for (const ParmVarDecl *PVD : Def->params())
+    if (PVD->getType().isDestructedType())
+      return false;
+
+  FunctionMayThrow Walker(*this);
+  Walker.TraverseStmt(Def->getBody());
+  NoThrowDefinitions[FD] = !Walker.Result;
+  return !Walker.Result;
+}
+
 bool
 CodeGenModule::shouldEmitFunction(GlobalDecl GD) {
   if (getFunctionLinkage(GD) != llvm::Function::AvailableExternallyLinkage)
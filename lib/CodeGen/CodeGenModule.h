@@ -366,6 +366,9 @@ class CodeGenModule : public CodeGenTypeCache {
   llvm::StringMap<llvm::GlobalVariable *> Constant4ByteStringMap;
   llvm::DenseMap<const Decl*, llvm::Constant *> StaticLocalDeclMap;
   llvm::DenseMap<const Decl*, llvm::GlobalVariable*> StaticLocalDeclGuardMap;
+
+  /// Cached results of cannotThrow().
+  llvm::DenseMap<const FunctionDecl*, bool> NoThrowDefinitions;
   llvm::DenseMap<const Expr*, llvm::Constant *> MaterializedGlobalTemporaryMap;
 
   llvm::DenseMap<QualType, llvm::Constant *> AtomicSetterHelperFnMap;
@@ -476,6 +479,11 @@ class CodeGenModule : public CodeGenTypeCache {
   SanitizerBlacklist SanitizerBL;
 
   /// @}
+
+  /// The scope-stack buffer of the last finished CodeGenFunction, kept so
+  /// that the next function does not have to allocate its own.
+  char *RecycledEHStackBuffer;
+  size_t RecycledEHStackBufferSize;
 public:
   CodeGenModule(ASTContext &C, const CodeGenOptions &CodeGenOpts,
                 llvm::Module &M, const llvm::DataLayout &TD,
@@ -488,6 +496,28 @@ public:
   /// Finalize LLVM code generation.
   void Release();
 
+  /// Take ownership of a scope-stack buffer left by an earlier function.
+  /// Returns null if there is none.
+  char *takeEHStackBuffer(size_t &Size) {
+    char *Buffer = RecycledEHStackBuffer;
+    Size = RecycledEHStackBufferSize;
+    RecycledEHStackBuffer = nullptr;
+    RecycledEHStackBufferSize = 0;
+    return Buffer;
+  }
+
+  /// Keep a finished function's scope-stack buffer for reuse, or free it if
+  /// a larger one is already kept.
+  void recycleEHStackBuffer(char *Buffer, size_t Size) {
+    if (Size <= RecycledEHStackBufferSize) {
+      delete[] Buffer;
+      return;
+    }
+    delete[] RecycledEHStackBuffer;
+    RecycledEHStackBuffer = Buffer;
+    RecycledEHStackBufferSize = Size;
+  }
+
   /// Return a reference to the configured Objective-C runtime.
   CGObjCRuntime &getObjCRuntime() {
     if (!ObjCRuntime) createObjCRuntime();
@@ -544,6 +574,12 @@ public:
     StaticLocalDeclGuardMap[D] = C;
   }
 
+  /// Return true if \p FD is defined in this translation unit and its body
+  /// provably cannot throw, so calls to it need no landing pad. This is a
+  /// conservative, syntactic check; see the implementation for what it
+  /// accepts.
+  bool cannotThrow(const FunctionDecl *FD);
+
   bool lookupRepresentativeDecl(StringRef MangledName,
                                 GlobalDecl &Result) const;
 
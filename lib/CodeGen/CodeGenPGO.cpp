@@ -264,6 +264,13 @@ const unsigned PGOHash::NumTypesPerWord;
 const unsigned PGOHash::TooBig;
 
   /// A RecursiveASTVisitor that fills a map of statements to PGO counters.
+  ///
+  /// FIXME: These counters are precise enough to drive source-based code
+  /// coverage: each counted statement, together with the counter arithmetic
+  /// done by ComputeRegionCounts, describes a source region's execution count.
+  /// Emitting that requires a coverage mapping format (file/region tables
+  /// that expand macro locations via the SourceManager) and a matching
+  /// reader in LLVM's ProfileData library, neither of which exists yet.
   struct MapRegionCounters : public RecursiveASTVisitor<MapRegionCounters> {
     /// The next counter value to assign.
     unsigned NextCounter;
@@ -906,6 +913,11 @@ void CodeGenPGO::emitCounterVariables() {
 void CodeGenPGO::emitCounterIncrement(CGBuilderTy &Builder, unsigned Counter) {
   if (!RegionCounters)
     return;
+  // FIXME: Every region gets its own counter, even when its count could be
+  // derived from its neighbours.  Counting only a spanning-tree complement
+  // would change which entries the indexed profile holds for a function, so
+  // it needs a new profile format version and a reader that can rebuild the
+  // region counts, not just a change here.
   llvm::Value *Addr =
     Builder.CreateConstInBoundsGEP2_64(RegionCounters, 0, Counter);
   llvm::Value *Count = Builder.CreateLoad(Addr, "pgocount");
@@ -22,6 +22,7 @@
 #include "clang/AST/RecordLayout.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Metadata.h"
@@ -29,6 +30,11 @@
 using namespace clang;
 using namespace CodeGen;
 
+#define DEBUG_TYPE "codegen-tbaa"
+
+STATISTIC(NumCharFallbacks,
+          "Number of non-character types given the omnipotent char type");
+
 CodeGenTBAA::CodeGenTBAA(ASTContext &Ctx, llvm::LLVMContext& VMContext,
                          const CodeGenOptions &CGO,
                          const LangOptions &Features, MangleContext &MContext)
@@ -92,8 +98,10 @@ CodeGenTBAA::getTBAAInfo(QualType QTy) {
 
   // If the type has the may_alias attribute (even on a typedef), it is
   // effectively in the general char alias class.
-  if (TypeHasMayAlias(QTy))
+  if (TypeHasMayAlias(QTy)) {
+    ++NumCharFallbacks;
     return getChar();
+  }
 
   const Type *Ty = Context.getCanonicalType(QTy).getTypePtr();
 
@@ -149,8 +157,10 @@ CodeGenTBAA::getTBAAInfo(QualType QTy) {
     // on their mangled names, if they're external.
     // TODO: Is there a way to get a program-wide unique name for a
     // decl with local linkage or no linkage?
-    if (!Features.CPlusPlus || !ETy->getDecl()->isExternallyVisible())
+    if (!Features.CPlusPlus || !ETy->getDecl()->isExternallyVisible()) {
+      ++NumCharFallbacks;
       return MetadataCache[Ty] = getChar();
+    }
 
     SmallString<256> OutName;
     llvm::raw_svector_ostream Out(OutName);
@@ -159,7 +169,17 @@ CodeGenTBAA::getTBAAInfo(QualType QTy) {
     return MetadataCache[Ty] = createTBAAScalarType(OutName, getChar());
   }
 
+  // The elements of an array are accessed through lvalues of the element type,
+  // so an array belongs to its element type's alias class. This gives array
+  // members a precise type in struct type nodes and in !tbaa.struct.
+  if (const ArrayType *ATy = dyn_cast<ArrayType>(Ty)) {
+    // Compute the element's node first; it may grow MetadataCache.
+    llvm::MDNode *ElementInfo = getTBAAInfo(ATy->getElementType());
+    return MetadataCache[Ty] = ElementInfo;
+  }
+
   // For now, handle any other kind of type conservatively.
+  ++NumCharFallbacks;
   return MetadataCache[Ty] = getChar();
 }
 
@@ -23,12 +23,18 @@
 #include "clang/AST/Expr.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/CodeGen/CGFunctionInfo.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Module.h"
 using namespace clang;
 using namespace CodeGen;
 
+#define DEBUG_TYPE "codegen-types"
+
+STATISTIC(NumTypeCacheHits, "Number of type conversions served from cache");
+STATISTIC(NumTypeCacheFlushes, "Number of times the type cache was flushed");
+
 CodeGenTypes::CodeGenTypes(CodeGenModule &cgm)
   : CGM(cgm), Context(cgm.getContext()), TheModule(cgm.getModule()),
     TheDataLayout(cgm.getDataLayout()),
@@ -239,8 +245,10 @@ void CodeGenTypes::UpdateCompletedType(const TagDecl *TD) {
       // Okay, we formed some types based on this.  We speculated that the enum
       // would be lowered to i32, so we only need to flush the cache if this
       // didn't happen.
-      if (!ConvertType(ED->getIntegerType())->isIntegerTy(32))
+      if (!ConvertType(ED->getIntegerType())->isIntegerTy(32)) {
         TypeCache.clear();
+        ++NumTypeCacheFlushes;
+      }
     }
     // If necessary, provide the full definition of a type only used with a
     // declaration so far.
@@ -300,8 +308,10 @@ llvm::Type *CodeGenTypes::ConvertType(QualType T) {
   // See if type is already cached.
   llvm::DenseMap<const Type *, llvm::Type *>::iterator TCI = TypeCache.find(Ty);
   // If type is found in map then use it. Otherwise, convert type T.
-  if (TCI != TypeCache.end())
+  if (TCI != TypeCache.end()) {
+    ++NumTypeCacheHits;
     return TCI->second;
+  }
 
   // If we don't have it in the cache, convert it now.
   llvm::Type *ResultType = nullptr;
@@ -527,8 +537,10 @@ llvm::Type *CodeGenTypes::ConvertType(QualType T) {
 
     RecordsBeingLaidOut.erase(Ty);
 
-    if (SkippedLayout)
+    if (SkippedLayout) {
       TypeCache.clear();
+      ++NumTypeCacheFlushes;
+    }
     
     if (RecordsBeingLaidOut.empty())
       while (!DeferredRecords.empty())
@@ -671,8 +683,17 @@ llvm::StructType *CodeGenTypes::ConvertRecordDeclType(const RecordDecl *RD) {
   // If this struct blocked a FunctionType conversion, then recompute whatever
   // was derived from that.
   // FIXME: This is hugely overconservative.
-  if (SkippedLayout)
+  if (SkippedLayout) {
     TypeCache.clear();
+    ++NumTypeCacheFlushes;
+
+    // Nothing left in the cache was built from a placeholder, so there is no
+    // need to flush again until another layout is skipped. This is only safe
+    // once no other record or function type conversion is in flight; one
+    // might still cache a result derived from a placeholder.
+    if (RecordsBeingLaidOut.empty() && FunctionsBeingProcessed.empty())
+      SkippedLayout = false;
+  }
     
   // If we're done converting the outer-most record, then convert any deferred
   // structs as well.
@@ -97,7 +97,8 @@ class CodeGenTypes {
   llvm::SmallPtrSet<const CGFunctionInfo*, 4> FunctionsBeingProcessed;
   
   /// SkippedLayout - True if we didn't layout a function due to a being inside
-  /// a recursive struct conversion, set this to true.
+  /// a recursive struct conversion, set this to true. Reset once the type
+  /// cache has been flushed.
   bool SkippedLayout;
 
   SmallVector<const RecordDecl *, 8> DeferredRecords;
@@ -306,6 +306,24 @@ public:
                    InnermostEHScope(stable_end()) {}
   ~EHScopeStack() { delete[] StartOfBuffer; }
 
+  /// Use the given buffer, allocated with new[], as the storage for this
+  /// stack instead of allocating a new one on the first push.
+  void adoptBuffer(char *Buffer, size_t Size) {
+    assert(!StartOfBuffer && "stack already has a buffer");
+    StartOfBuffer = Buffer;
+    StartOfData = EndOfBuffer = Buffer + Size;
+  }
+
+  /// Give up ownership of the buffer of this empty stack so that it can be
+  /// reused by another one.  Returns null if no buffer was ever allocated.
+  char *releaseBuffer(size_t &Size) {
+    assert(empty() && "releasing the buffer of a non-empty stack");
+    char *Buffer = StartOfBuffer;
+    Size = EndOfBuffer - StartOfBuffer;
+    StartOfBuffer = EndOfBuffer = StartOfData = nullptr;
+    return Buffer;
+  }
+
   // Variadic templates would make this not terrible.
 
   /// Push a lazily-created cleanup on the stack.
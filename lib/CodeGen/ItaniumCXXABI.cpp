@@ -28,6 +28,7 @@
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Value.h"
 
 using namespace clang;
@@ -1336,7 +1337,7 @@ llvm::Value *ItaniumCXXABI::getVirtualFunctionPointer(CodeGenFunction &CGF,
   uint64_t VTableIndex = CGM.getItaniumVTableContext().getMethodVTableIndex(GD);
   llvm::Value *VFuncPtr =
       CGF.Builder.CreateConstInBoundsGEP1_64(VTable, VTableIndex, "vfn");
-  return CGF.Builder.CreateLoad(VFuncPtr);
+  return EmitVTableSlotLoad(CGF, VFuncPtr);
 }
 
 void ItaniumCXXABI::EmitVirtualDestructorCall(CodeGenFunction &CGF,
@@ -1719,8 +1720,12 @@ void ItaniumCXXABI::EmitGuardedInit(CodeGenFunction &CGF,
   llvm::BasicBlock *InitCheckBlock = CGF.createBasicBlock("init.check");
   llvm::BasicBlock *EndBlock = CGF.createBasicBlock("init.end");
 
-  // Check if the first byte of the guard variable is zero.
-  Builder.CreateCondBr(isInitialized, InitCheckBlock, EndBlock);
+  // Check if the first byte of the guard variable is zero.  Only the first
+  // execution takes the slow path, so keep the initialized path hot.
+  // Value chosen to match UR_NONTAKEN_WEIGHT, see BranchProbabilityInfo.cpp
+  llvm::MDBuilder MDHelper(CGM.getLLVMContext());
+  Builder.CreateCondBr(isInitialized, InitCheckBlock, EndBlock,
+                       MDHelper.createBranchWeights(1, (1U << 20) - 1));
 
   CGF.EmitBlock(InitCheckBlock);
 
@@ -1371,7 +1371,7 @@ llvm::Value *MicrosoftCXXABI::getVirtualFunctionPointer(CodeGenFunction &CGF,
       CGM.getMicrosoftVTableContext().getMethodVFTableLocation(GD);
   llvm::Value *VFuncPtr =
       Builder.CreateConstInBoundsGEP1_64(VTable, ML.Index, "vfn");
-  return Builder.CreateLoad(VFuncPtr);
+  return EmitVTableSlotLoad(CGF, VFuncPtr);
 }
 
 void MicrosoftCXXABI::EmitVirtualDestructorCall(CodeGenFunction &CGF,
@@ -91,6 +91,13 @@ namespace {
         return true;
 
       // Make sure to emit all elements of a Decl.
+      //
+      // FIXME: Functions emitted here cannot be handed to the backend yet.
+      // CodeGenModule keeps rewriting the module until Release(): it replaces
+      // declarations whose types change, adds deferred decls, and emits
+      // vtables and global initializers at the end of the TU. A function is
+      // only final by then, so overlapping backend work with parsing would
+      // first need a way to tell that nothing will refer back into it.
       for (DeclGroupRef::iterator I = DG.begin(), E = DG.end(); I != E; ++I)
         Builder->EmitTopLevelDecl(*I);
 
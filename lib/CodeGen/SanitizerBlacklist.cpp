@@ -12,6 +12,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "SanitizerBlacklist.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/Module.h"
@@ -32,12 +33,27 @@ static StringRef GetGlobalTypeString(const llvm::GlobalValue &G) {
 
 bool SanitizerBlacklist::isIn(const llvm::Module &M,
                               const StringRef Category) const {
-  return SCL->inSection("src", M.getModuleIdentifier(), Category);
+  // The module identifier never changes, so this is almost always a hit.
+  SmallString<128> Key(M.getModuleIdentifier());
+  Key.push_back('\0');
+  Key += Category;
+  auto Cached = SrcCache.find(Key);
+  if (Cached != SrcCache.end())
+    return Cached->second;
+  bool Result = SCL->inSection("src", M.getModuleIdentifier(), Category);
+  SrcCache[Key] = Result;
+  return Result;
 }
 
 bool SanitizerBlacklist::isIn(const llvm::Function &F) const {
-  return isIn(*F.getParent()) ||
-         SCL->inSection("fun", F.getName(), "");
+  if (isIn(*F.getParent()))
+    return true;
+  auto Cached = FunCache.find(F.getName());
+  if (Cached != FunCache.end())
+    return Cached->second;
+  bool Result = SCL->inSection("fun", F.getName(), "");
+  FunCache[F.getName()] = Result;
+  return Result;
 }
 
 bool SanitizerBlacklist::isIn(const llvm::GlobalVariable &G,
@@ -15,6 +15,7 @@
 #define CLANG_CODEGEN_SANITIZERBLACKLIST_H
 
 #include "clang/Basic/LLVM.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/SpecialCaseList.h"
 #include <memory>
@@ -31,6 +32,14 @@ namespace CodeGen {
 class SanitizerBlacklist {
   std::unique_ptr<llvm::SpecialCaseList> SCL;
 
+  /// Results of previous queries. Every function and global in the module is
+  /// looked up (some of them several times), and matching against a large
+  /// blacklist is expensive, so remember the answers. The caches are keyed
+  /// on names rather than on IR objects, which CodeGen can erase and
+  /// replace.
+  mutable llvm::StringMap<bool> SrcCache;
+  mutable llvm::StringMap<bool> FunCache;
+
 public:
   SanitizerBlacklist(llvm::SpecialCaseList *SCL) : SCL(SCL) {}
   bool isIn(const llvm::Module &M,
@@ -2456,6 +2456,13 @@ ABIArgInfo X86_64ABIInfo::classifyArgumentType(
 }
 
 void X86_64ABIInfo::computeInfo(CGFunctionInfo &FI) const {
+  // FIXME: Functions with internal linkage whose address is never taken are
+  // free to ignore the psABI, e.g. to return aggregates of up to four
+  // eightbytes in registers instead of through sret. We can't tell whether
+  // the address is taken until the end of the translation unit, after the
+  // function has been emitted, so such a convention would have to be applied
+  // by rewriting the function later rather than by classification here. For
+  // byval arguments, LLVM's argument promotion already does this.
 
   if (!getCXXABI().classifyReturnType(FI))
     FI.getReturnInfo() = classifyReturnType(FI.getReturnType());
@@ -14,9 +14,15 @@
 #include "clang/Driver/Options.h"
 #include "clang/Driver/ToolChain.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/Option/ArgList.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/raw_ostream.h"
+#include <deque>
+#if LLVM_ENABLE_THREADS
+#include <thread>
+#endif
 
 using namespace clang::driver;
 using namespace clang;
@@ -26,7 +32,7 @@ Compilation::Compilation(const Driver &D, const ToolChain &_DefaultToolChain,
                          InputArgList *_Args, DerivedArgList *_TranslatedArgs)
     : TheDriver(D), DefaultToolChain(_DefaultToolChain), Args(_Args),
       TranslatedArgs(_TranslatedArgs), Redirects(nullptr),
-      ForDiagnostics(false) {}
+      ForDiagnostics(false), ParallelJobs(1), ExecuteCC1InProcess(false) {}
 
 Compilation::~Compilation() {
   delete TranslatedArgs;
@@ -122,8 +128,8 @@ bool Compilation::CleanupFileMap(const ArgStringMap &Files,
   return Success;
 }
 
-int Compilation::ExecuteCommand(const Command &C,
-                                const Command *&FailingCommand) const {
+int Compilation::PrintCommand(const Command &C,
+                              const Command *&FailingCommand) const {
   if ((getDriver().CCPrintOptions ||
        getArgs().hasArg(options::OPT_v)) && !getDriver().CCGenDiagnostics) {
     raw_ostream *OS = &llvm::errs();
@@ -153,9 +159,12 @@ int Compilation::ExecuteCommand(const Command &C,
       delete OS;
   }
 
-  std::string Error;
-  bool ExecutionFailed;
-  int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+  return 0;
+}
+
+int Compilation::FinishCommand(const Command &C, int Res,
+                               const std::string &Error, bool ExecutionFailed,
+                               const Command *&FailingCommand) const {
   if (!Error.empty()) {
     assert(Res && "Error string set with 0 result code!");
     getDriver().Diag(clang::diag::err_drv_command_failure) << Error;
@@ -167,6 +176,54 @@ int Compilation::ExecuteCommand(const Command &C,
   return ExecutionFailed ? 1 : Res;
 }
 
+static bool isCC1Command(const Job &J, const Driver &D) {
+  const Command *C = dyn_cast<Command>(&J);
+  return C && C->getKind() == Job::CommandClass &&
+         !C->getArguments().empty() &&
+         StringRef(C->getArguments()[0]) == "-cc1" &&
+         StringRef(C->getExecutable()) == D.getClangProgramPath();
+}
+
+bool Compilation::canExecuteInProcess(const Command &C) const {
+  // The frontend keeps global state (LLVM options, statistics, timers), so
+  // only ever run it once per process, and never while regenerating it for
+  // crash diagnostics.
+  if (!ExecuteCC1InProcess || ForDiagnostics || Redirects ||
+      !isCC1Command(C, getDriver()))
+    return false;
+
+  unsigned NumCC1Jobs = 0;
+  for (JobList::const_iterator it = Jobs.begin(), ie = Jobs.end();
+       it != ie; ++it)
+    if (isCC1Command(**it, getDriver()))
+      ++NumCC1Jobs;
+  return NumCC1Jobs == 1;
+}
+
+int Compilation::ExecuteInProcess(const Command &C) const {
+  SmallVector<const char *, 128> Argv;
+  Argv.push_back(C.getExecutable());
+  Argv.append(C.getArguments().begin(), C.getArguments().end());
+
+  return getDriver().CC1Main(Argv);
+}
+
+int Compilation::ExecuteCommand(const Command &C,
+                                const Command *&FailingCommand) const {
+  if (int Res = PrintCommand(C, FailingCommand))
+    return Res;
+
+  if (canExecuteInProcess(C)) {
+    int Res = ExecuteInProcess(C);
+    return FinishCommand(C, Res, std::string(), false, FailingCommand);
+  }
+
+  std::string Error;
+  bool ExecutionFailed;
+  int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+  return FinishCommand(C, Res, Error, ExecutionFailed, FailingCommand);
+}
+
 typedef SmallVectorImpl< std::pair<int, const Command *> > FailingCommandList;
 
 static bool ActionFailed(const Action *A,
@@ -192,6 +249,96 @@ static bool InputsOk(const Command &C,
   return !ActionFailed(&C.getSource(), FailingCommands);
 }
 
+/// Return true if action \p A uses the output of action \p Dep.
+static bool ActionDependsOn(const Action *A, const Action *Dep) {
+  for (Action::const_iterator AI = A->begin(), AE = A->end(); AI != AE; ++AI)
+    if (*AI == Dep || ActionDependsOn(*AI, Dep))
+      return true;
+  return false;
+}
+
+/// Return true if the commands in \p Jobs can be started out of job order.
+static bool CanExecuteInParallel(const JobList &Jobs) {
+  for (JobList::const_iterator it = Jobs.begin(), ie = Jobs.end();
+       it != ie; ++it) {
+    // Fallback commands diagnose from Execute, so they must run on the
+    // driver's thread.
+    if ((*it)->getKind() != Job::CommandClass)
+      return false;
+  }
+  return true;
+}
+
+namespace {
+/// A command started by ExecuteJobsInParallel.
+struct RunningCommand {
+  const Command *C;
+  int Res;
+  std::string Error;
+  bool ExecutionFailed;
+#if LLVM_ENABLE_THREADS
+  std::thread Thread;
+#endif
+
+  explicit RunningCommand(const Command *C)
+      : C(C), Res(0), ExecutionFailed(false) {}
+};
+}
+
+void Compilation::ExecuteJobsInParallel(
+    const JobList &Jobs, FailingCommandList &FailingCommands) const {
+#if LLVM_ENABLE_THREADS
+  std::deque<RunningCommand> Running;
+
+  // Wait for the oldest running command and report its result.
+  auto FinishOldest = [&] {
+    RunningCommand &R = Running.front();
+    R.Thread.join();
+    const Command *FailingCommand = nullptr;
+    if (int Res = FinishCommand(*R.C, R.Res, R.Error, R.ExecutionFailed,
+                                FailingCommand))
+      FailingCommands.push_back(std::make_pair(Res, FailingCommand));
+    Running.pop_front();
+  };
+
+  for (JobList::const_iterator it = Jobs.begin(), ie = Jobs.end();
+       it != ie; ++it) {
+    const Command *C = cast<Command>(*it);
+
+    // Wait until a slot is free and none of the running commands produces an
+    // input of this one.
+    while (!Running.empty()) {
+      bool DependsOnRunning = false;
+      for (const RunningCommand &R : Running)
+        if (ActionDependsOn(&C->getSource(), &R.C->getSource()))
+          DependsOnRunning = true;
+      if (!DependsOnRunning && Running.size() < ParallelJobs)
+        break;
+      FinishOldest();
+    }
+
+    if (!InputsOk(*C, FailingCommands))
+      continue;
+    const Command *FailingCommand = nullptr;
+    if (int Res = PrintCommand(*C, FailingCommand)) {
+      FailingCommands.push_back(std::make_pair(Res, FailingCommand));
+      continue;
+    }
+
+    Running.push_back(RunningCommand(C));
+    RunningCommand &R = Running.back();
+    R.Thread = std::thread([this, &R] {
+      R.Res = R.C->Execute(Redirects, &R.Error, &R.ExecutionFailed);
+    });
+  }
+
+  while (!Running.empty())
+    FinishOldest();
+#else
+  llvm_unreachable("parallel jobs require thread support");
+#endif
+}
+
 void Compilation::ExecuteJob(const Job &J,
                              FailingCommandList &FailingCommands) const {
   if (const Command *C = dyn_cast<Command>(&J)) {
@@ -202,6 +349,12 @@ void Compilation::ExecuteJob(const Job &J,
       FailingCommands.push_back(std::make_pair(Res, FailingCommand));
   } else {
     const JobList *Jobs = cast<JobList>(&J);
+#if LLVM_ENABLE_THREADS
+    if (ParallelJobs > 1 && !ForDiagnostics && CanExecuteInParallel(*Jobs)) {
+      ExecuteJobsInParallel(*Jobs, FailingCommands);
+      return;
+    }
+#endif
     for (JobList::const_iterator it = Jobs->begin(), ie = Jobs->end();
          it != ie; ++it)
       ExecuteJob(**it, FailingCommands);
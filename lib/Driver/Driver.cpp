@@ -57,7 +57,7 @@ Driver::Driver(StringRef ClangExecutable,
     CCCPrintBindings(false),
     CCPrintHeaders(false), CCLogDiagnostics(false),
     CCGenDiagnostics(false), CCCGenericGCCName(""), CheckInputsExist(true),
-    CCCUsePCH(true), SuppressMissingInputWarning(false) {
+    CCCUsePCH(true), CC1Main(nullptr), SuppressMissingInputWarning(false) {
 
   Name = llvm::sys::path::stem(ClangExecutable);
   Dir  = llvm::sys::path::parent_path(ClangExecutable);
@@ -370,6 +370,22 @@ Compilation *Driver::BuildCompilation(ArrayRef<const char *> ArgList) {
   // The compilation takes ownership of Args.
   Compilation *C = new Compilation(*this, TC, Args, TranslatedArgs);
 
+  if (const Arg *A = Args->getLastArg(options::OPT_parallel_jobs_EQ)) {
+    unsigned ParallelJobs;
+    if (StringRef(A->getValue()).getAsInteger(10, ParallelJobs) ||
+        ParallelJobs == 0)
+      Diag(clang::diag::err_drv_invalid_int_value)
+        << A->getAsString(*Args) << A->getValue();
+    else
+      C->setParallelJobs(ParallelJobs);
+  }
+
+  // Claim the flags even when this driver can't run jobs in-process.
+  bool IntegratedCC1 = Args->hasFlag(options::OPT_fintegrated_cc1,
+                                     options::OPT_fno_integrated_cc1, false);
+  if (CC1Main && IntegratedCC1)
+    C->setExecuteCC1InProcess(true);
+
   if (!HandleImmediateArgs(*C))
     return C;
 
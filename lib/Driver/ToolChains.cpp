@@ -1201,6 +1201,19 @@ static llvm::StringRef getGCCToolchainDir(const ArgList &Args) {
   return GCC_INSTALL_PREFIX;
 }
 
+/// Collect the names of the entries of \p Dir into \p Entries.
+///
+/// \returns false if \p Dir cannot be read.
+static bool ListDirectory(const std::string &Dir, llvm::StringSet<> &Entries) {
+  std::error_code EC;
+  llvm::sys::fs::directory_iterator LI(Dir, EC), LE;
+  if (EC)
+    return false;
+  for (; !EC && LI != LE; LI = LI.increment(EC))
+    Entries.insert(llvm::sys::path::filename(LI->path()));
+  return true;
+}
+
 /// \brief Initialize a GCCInstallationDetector from the driver.
 ///
 /// This performs all of the autodetection and sets up the various paths.
@@ -1258,19 +1271,21 @@ Generic_GCC::GCCInstallationDetector::init(
       continue;
     for (unsigned j = 0, je = CandidateLibDirs.size(); j < je; ++j) {
       const std::string LibDir = Prefixes[i] + CandidateLibDirs[j].str();
-      if (!llvm::sys::fs::exists(LibDir))
+      llvm::StringSet<> LibDirEntries;
+      if (!ListDirectory(LibDir, LibDirEntries))
         continue;
       for (unsigned k = 0, ke = CandidateTripleAliases.size(); k < ke; ++k)
-        ScanLibDirForGCCTriple(TargetTriple, Args, LibDir,
+        ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, LibDirEntries,
                                CandidateTripleAliases[k]);
     }
     for (unsigned j = 0, je = CandidateBiarchLibDirs.size(); j < je; ++j) {
       const std::string LibDir = Prefixes[i] + CandidateBiarchLibDirs[j].str();
-      if (!llvm::sys::fs::exists(LibDir))
+      llvm::StringSet<> LibDirEntries;
+      if (!ListDirectory(LibDir, LibDirEntries))
         continue;
       for (unsigned k = 0, ke = CandidateBiarchTripleAliases.size(); k < ke;
            ++k)
-        ScanLibDirForGCCTriple(TargetTriple, Args, LibDir,
+        ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, LibDirEntries,
                                CandidateBiarchTripleAliases[k],
                                /*NeedsBiarchSuffix=*/ true);
     }
@@ -2035,8 +2050,8 @@ static bool findBiarchMultilibs(const llvm::Triple &TargetTriple,
 
 void Generic_GCC::GCCInstallationDetector::ScanLibDirForGCCTriple(
     const llvm::Triple &TargetTriple, const ArgList &Args,
-    const std::string &LibDir, StringRef CandidateTriple,
-    bool NeedsBiarchSuffix) {
+    const std::string &LibDir, const llvm::StringSet<> &LibDirEntries,
+    StringRef CandidateTriple, bool NeedsBiarchSuffix) {
   llvm::Triple::ArchType TargetArch = TargetTriple.getArch();
   // There are various different suffixes involving the triple we
   // check for. We also record what is necessary to walk from each back
@@ -2057,6 +2072,14 @@ void Generic_GCC::GCCInstallationDetector::ScanLibDirForGCCTriple(
     // triple.
     "/i386-linux-gnu/gcc/" + CandidateTriple.str()
   };
+  // The first component of each suffix, which must be an entry of LibDir.
+  const StringRef LibSuffixEntries[] = {
+    "gcc",
+    "gcc-cross",
+    CandidateTriple,
+    CandidateTriple,
+    "i386-linux-gnu"
+  };
   const std::string InstallSuffixes[] = {
     "/../../..",    // gcc/
     "/../../..",    // gcc-cross/
@@ -2068,6 +2091,9 @@ void Generic_GCC::GCCInstallationDetector::ScanLibDirForGCCTriple(
   const unsigned NumLibSuffixes =
       (llvm::array_lengthof(LibSuffixes) - (TargetArch != llvm::Triple::x86));
   for (unsigned i = 0; i < NumLibSuffixes; ++i) {
+    // Don't try to open directories that can't exist.
+    if (!LibDirEntries.count(LibSuffixEntries[i]))
+      continue;
     StringRef LibSuffix = LibSuffixes[i];
     std::error_code EC;
     for (llvm::sys::fs::directory_iterator LI(LibDir + LibSuffix, EC), LE;
@@ -17,6 +17,7 @@
 #include "clang/Driver/ToolChain.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Compiler.h"
 #include <set>
 #include <vector>
@@ -143,6 +144,7 @@ protected:
     void ScanLibDirForGCCTriple(const llvm::Triple &TargetArch,
                                 const llvm::opt::ArgList &Args,
                                 const std::string &LibDir,
+                                const llvm::StringSet<> &LibDirEntries,
                                 StringRef CandidateTriple,
                                 bool NeedsBiarchSuffix = false);
   };
@@ -1062,6 +1062,8 @@ private:
     }
   };
 
+  typedef std::set<LineState *, CompareLineStatePointers> SeenSetType;
+
   /// \brief Analyze the entire solution space starting from \p InitialState.
   ///
   /// This implements a variant of Dijkstra's algorithm on the graph that spans
@@ -1071,7 +1073,7 @@ private:
   ///
   /// If \p DryRun is \c false, directly applies the changes.
   unsigned analyzeSolutionSpace(LineState &InitialState, bool DryRun = false) {
-    std::set<LineState *, CompareLineStatePointers> Seen;
+    SeenSetType Seen;
 
     // Increasing count of \c StateNode items we have created. This is used to
     // create a deterministic order independent of the container.
@@ -1107,9 +1109,11 @@ private:
 
       FormatDecision LastFormat = Node->State.NextToken->Decision;
       if (LastFormat == FD_Unformatted || LastFormat == FD_Continue)
-        addNextStateToQueue(Penalty, Node, /*NewLine=*/false, &Count, &Queue);
+        addNextStateToQueue(Penalty, Node, /*NewLine=*/false, Seen, &Count,
+                            &Queue);
       if (LastFormat == FD_Unformatted || LastFormat == FD_Break)
-        addNextStateToQueue(Penalty, Node, /*NewLine=*/true, &Count, &Queue);
+        addNextStateToQueue(Penalty, Node, /*NewLine=*/true, Seen, &Count,
+                            &Queue);
     }
 
     if (Queue.empty()) {
@@ -1156,8 +1160,11 @@ private:
   ///
   /// Assume the current state is \p PreviousNode and has been reached with a
   /// penalty of \p Penalty. Insert a line break if \p NewLine is \c true.
+  /// States equal to one in \p Seen are not queued: it was reached with a
+  /// penalty no higher than this one, so they would be discarded when popped.
   void addNextStateToQueue(unsigned Penalty, StateNode *PreviousNode,
-                           bool NewLine, unsigned *Count, QueueType *Queue) {
+                           bool NewLine, const SeenSetType &Seen,
+                           unsigned *Count, QueueType *Queue) {
     if (NewLine && !Indenter->canBreak(PreviousNode->State))
       return;
     if (!NewLine && Indenter->mustBreak(PreviousNode->State))
@@ -1170,7 +1177,10 @@ private:
 
     Penalty += Indenter->addTokenToState(Node->State, NewLine, true);
 
-    Queue->push(QueueItem(OrderedPenalty(Penalty, *Count), Node));
+    // Still count the state so that the cut-off in analyzeSolutionSpace is
+    // reached at the same point.
+    if (!Node->State.NextToken || !Seen.count(&Node->State))
+      Queue->push(QueueItem(OrderedPenalty(Penalty, *Count), Node));
     ++(*Count);
   }
 
@@ -1731,6 +1741,11 @@ public:
       Annotator.annotate(*AnnotatedLines[i]);
     }
     deriveLocalStyle(AnnotatedLines);
+    // FIXME: This is done for every line, even when only a small range is
+    // reformatted. Restricting it to affected lines is not enough:
+    // LineJoiner::tryFitMultipleLinesInOne runs on unaffected lines too, and
+    // it decides from their lengths whether a following affected line is
+    // merged into them. deriveLocalStyle also looks at the whole file.
     for (unsigned i = 0, e = AnnotatedLines.size(); i != e; ++i) {
       Annotator.calculateFormattingInformation(*AnnotatedLines[i]);
     }
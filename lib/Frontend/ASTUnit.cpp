@@ -42,6 +42,7 @@
 #include "llvm/Support/Mutex.h"
 #include "llvm/Support/MutexGuard.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Signals.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <atomic>
@@ -169,9 +170,16 @@ void OnDiskData::CleanTemporaryFiles() {
   TemporaryFiles.clear();
 }
 
+/// \brief Removes a preamble PCH file and stops tracking it for removal on a
+/// crash.
+static void removePreambleFile(StringRef Path) {
+  llvm::sys::DontRemoveFileOnSignal(Path);
+  llvm::sys::fs::remove(Path);
+}
+
 void OnDiskData::CleanPreambleFile() {
   if (!PreambleFile.empty()) {
-    llvm::sys::fs::remove(PreambleFile);
+    removePreambleFile(PreambleFile);
     PreambleFile.clear();
   }
 }
@@ -1188,6 +1196,11 @@ static std::string GetPreamblePCHPath() {
   SmallString<128> Path;
   llvm::sys::fs::createTemporaryFile("preamble", "pch", Path);
 
+  // Don't leave the file behind if the process is killed by a signal before
+  // the ASTUnit gets a chance to clean it up.
+  if (!Path.empty())
+    llvm::sys::RemoveFileOnSignal(Path);
+
   return Path.str();
 }
 
@@ -1358,6 +1371,12 @@ static void makeStandaloneDiagnostic(const LangOptions &LangOpts,
 /// \returns If the precompiled preamble can be used, returns a newly-allocated
 /// buffer that should be used in place of the main file when doing so.
 /// Otherwise, returns a NULL pointer.
+///
+/// FIXME: The preamble is rebuilt synchronously. Building it on another thread
+/// while the old one keeps serving requests would need a FileManager and
+/// diagnostics of its own for the build, and a way to swap PreambleFile and
+/// the stored preamble diagnostics atomically, as the rest of ASTUnit assumes
+/// a single thread.
 llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
                               const CompilerInvocation &PreambleInvocationIn,
                                                            bool AllowRebuild,
@@ -1550,7 +1569,7 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
   Clang->setTarget(TargetInfo::CreateTargetInfo(
       Clang->getDiagnostics(), Clang->getInvocation().TargetOpts));
   if (!Clang->hasTarget()) {
-    llvm::sys::fs::remove(FrontendOpts.OutputFile);
+    removePreambleFile(FrontendOpts.OutputFile);
     Preamble.clear();
     PreambleRebuildCounter = DefaultPreambleRebuildInterval;
     PreprocessorOpts.RemappedFileBuffers.pop_back();
@@ -1596,7 +1615,7 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
   std::unique_ptr<PrecompilePreambleAction> Act;
   Act.reset(new PrecompilePreambleAction(*this));
   if (!Act->BeginSourceFile(*Clang.get(), Clang->getFrontendOpts().Inputs[0])) {
-    llvm::sys::fs::remove(FrontendOpts.OutputFile);
+    removePreambleFile(FrontendOpts.OutputFile);
     Preamble.clear();
     PreambleRebuildCounter = DefaultPreambleRebuildInterval;
     PreprocessorOpts.RemappedFileBuffers.pop_back();
@@ -1623,7 +1642,7 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
     // The preamble PCH failed (e.g. there was a module loading fatal error),
     // so no precompiled header was generated. Forget that we even tried.
     // FIXME: Should we leave a note for ourselves to try again?
-    llvm::sys::fs::remove(FrontendOpts.OutputFile);
+    removePreambleFile(FrontendOpts.OutputFile);
     Preamble.clear();
     TopLevelDeclsInPreamble.clear();
     PreambleRebuildCounter = DefaultPreambleRebuildInterval;
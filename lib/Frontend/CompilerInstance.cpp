@@ -13,6 +13,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/Version.h"
@@ -28,8 +29,10 @@
 #include "clang/Frontend/VerifyDiagnosticConsumer.h"
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/PTHManager.h"
+#include "clang/Lex/PreprocessingRecord.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
+#include "clang/Sema/InstantiationTrace.h"
 #include "clang/Sema/Sema.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
@@ -37,6 +40,7 @@
 #include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/LockFileManager.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -53,7 +57,8 @@ using namespace clang;
 
 CompilerInstance::CompilerInstance(bool BuildingModule)
   : ModuleLoader(BuildingModule),
-    Invocation(new CompilerInvocation()), ModuleManager(nullptr),
+    Invocation(new CompilerInvocation()), PersistentStats(nullptr),
+    ModuleManager(nullptr),
     BuildGlobalModuleIndex(false), HaveFullGlobalModuleIndex(false),
     ModuleBuildFailed(false) {
 }
@@ -83,6 +88,7 @@ void CompilerInstance::setTarget(TargetInfo *Value) {
 
 void CompilerInstance::setFileManager(FileManager *Value) {
   FileMgr = Value;
+  PersistentStats = nullptr;
   if (Value)
     VirtualFileSystem = Value->getVirtualFileSystem();
   else
@@ -226,6 +232,14 @@ void CompilerInstance::createFileManager() {
     setVirtualFileSystem(vfs::getRealFileSystem());
   }
   FileMgr = new FileManager(getFileSystemOpts(), VirtualFileSystem);
+
+  const FrontendOptions &FEOpts = getFrontendOpts();
+  PersistentStats = nullptr;
+  if (!FEOpts.StatCacheFile.empty()) {
+    PersistentStats = PersistentStatCache::load(FEOpts.StatCacheFile,
+                                                FEOpts.StatCacheEpoch);
+    FileMgr->addStatCache(PersistentStats);
+  }
 }
 
 // Source Manager
@@ -313,8 +327,18 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
     PP->setPTHManager(PTHMgr);
   }
 
-  if (PPOpts.DetailedRecord)
+  if (!PPOpts.IncludeGuardIndex.empty()) {
+    IncludeGuardIndex *GuardIndex =
+        new IncludeGuardIndex(PPOpts.IncludeGuardIndex);
+    GuardIndex->load();
+    PP->setIncludeGuardIndex(GuardIndex);
+  }
+
+  if (PPOpts.DetailedRecord) {
     PP->createPreprocessingRecord();
+    PP->getPreprocessingRecord()->setRecordMacroExpansions(
+        PPOpts.DetailedRecordExpansions);
+  }
 
   // Apply remappings to the source manager.
   InitializeFileRemapping(PP->getDiagnostics(), PP->getSourceManager(),
@@ -346,6 +370,10 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
   if (!DepOpts.DOTOutputFile.empty())
     AttachDependencyGraphGen(*PP, DepOpts.DOTOutputFile,
                              getHeaderSearchOpts().Sysroot);
+  if (!DepOpts.HashOutputFile.empty())
+    addDependencyCollector(createDependencyHashCollector(
+        DepOpts.HashOutputFile, getSourceManager(), getDiagnostics(),
+        DepOpts.IncludeSystemHeaders));
 
   for (auto &Listener : DependencyCollectors)
     Listener->attachToPreprocessor(*PP);
@@ -390,6 +418,7 @@ void CompilerInstance::createPCHExternalASTSource(
     void *DeserializationListener, bool OwnDeserializationListener) {
   IntrusiveRefCntPtr<ExternalASTSource> Source;
   bool Preamble = getPreprocessorOpts().PrecompiledPreambleBytes.first != 0;
+  llvm::TimeRegion TimeLoading(getASTFileLoadTimer());
   Source = createPCHExternalASTSource(
       Path, getHeaderSearchOpts().Sysroot, DisablePCHValidation,
       AllowPCHWithCompilerErrors, getPreprocessor(), getASTContext(),
@@ -489,7 +518,11 @@ void CompilerInstance::createCodeCompletionConsumer() {
 }
 
 void CompilerInstance::createFrontendTimer() {
-  FrontendTimer.reset(new llvm::Timer("Clang front-end timer"));
+  FrontendTimerGroup.reset(new llvm::TimerGroup("Clang front-end time report"));
+  FrontendTimer.reset(
+      new llvm::Timer("Clang front-end timer", *FrontendTimerGroup));
+  ASTFileLoadTimer.reset(
+      new llvm::Timer("AST file loading", *FrontendTimerGroup));
 }
 
 CodeCompleteConsumer *
@@ -510,6 +543,21 @@ void CompilerInstance::createSema(TranslationUnitKind TUKind,
                                   CodeCompleteConsumer *CompletionConsumer) {
   TheSema.reset(new Sema(getPreprocessor(), getASTContext(), getASTConsumer(),
                          TUKind, CompletionConsumer));
+  TheSema->SkipVTableDefinitions = getFrontendOpts().SkipVTableDefinitions;
+
+  const std::string &TraceFile =
+      getFrontendOpts().TemplateInstantiationTraceFile;
+  if (!TraceFile.empty()) {
+    std::string ErrorInfo;
+    std::unique_ptr<llvm::raw_fd_ostream> OS(new llvm::raw_fd_ostream(
+        TraceFile.c_str(), ErrorInfo, llvm::sys::fs::F_Text));
+    if (!ErrorInfo.empty())
+      getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+        << TraceFile << ErrorInfo;
+    else
+      TheSema->InstTrace.reset(
+          new InstantiationTrace(getASTContext(), OS.release()));
+  }
 }
 
 // Output Files
@@ -812,6 +860,14 @@ bool CompilerInstance::ExecuteAction(FrontendAction &Act) {
     }
   }
 
+  // Save any stat() results that the next compile can reuse.
+  if (PersistentStats && hasFileManager() && PersistentStats->isDirty()) {
+    std::string ErrorStr;
+    if (PersistentStats->save(getFrontendOpts().StatCacheFile, ErrorStr))
+      getDiagnostics().Report(diag::warn_fe_stat_cache_save_failure)
+        << getFrontendOpts().StatCacheFile << ErrorStr;
+  }
+
   // Notify the diagnostic client that all files were processed.
   getDiagnostics().getClient()->finish();
 
@@ -909,6 +965,10 @@ static bool compileModuleImpl(CompilerInstance &ImportingInstance,
   PPOpts.RetainRemappedFileBuffers = true;
     
   Invocation->getDiagnosticOpts().VerifyDiagnostics = 0;
+
+  // The importing instance records the module file and its inputs; don't let
+  // the module build overwrite that with the module's own dependencies.
+  Invocation->getDependencyOutputOpts().HashOutputFile.clear();
   assert(ImportingInstance.getInvocation().getModuleHash() ==
          Invocation->getModuleHash() && "Module hash mismatch!");
   
@@ -994,6 +1054,17 @@ static bool compileAndLoadModule(CompilerInstance &ImportingInstance,
         << Module->Name << SourceRange(ImportLoc, ModuleNameLoc);
   };
 
+  // Report how long building (or waiting for) the module took, so that slow
+  // modules on the critical path of a cold build can be identified.
+  auto reportElapsed = [&](unsigned DiagID, const llvm::TimeRecord &Start) {
+    double Elapsed = llvm::TimeRecord::getCurrentTime(false).getWallTime() -
+                     Start.getWallTime();
+    SmallString<16> Seconds;
+    llvm::raw_svector_ostream(Seconds) << llvm::format("%.2f", Elapsed);
+    ImportingInstance.getDiagnostics().Report(ImportLoc, DiagID)
+        << Module->Name << Seconds.str();
+  };
+
   // FIXME: have LockFileManager return an error_code so that we can
   // avoid the mkdir when the directory already exists.
   StringRef Dir = llvm::sys::path::parent_path(ModuleFileName);
@@ -1006,23 +1077,29 @@ static bool compileAndLoadModule(CompilerInstance &ImportingInstance,
     case llvm::LockFileManager::LFS_Error:
       return false;
 
-    case llvm::LockFileManager::LFS_Owned:
+    case llvm::LockFileManager::LFS_Owned: {
       // We're responsible for building the module ourselves.
+      llvm::TimeRecord Start = llvm::TimeRecord::getCurrentTime(true);
       if (!compileModuleImpl(ImportingInstance, ModuleNameLoc, Module,
                              ModuleFileName)) {
         diagnoseBuildFailure();
         return false;
       }
+      reportElapsed(diag::remark_module_build_done, Start);
       break;
+    }
 
-    case llvm::LockFileManager::LFS_Shared:
+    case llvm::LockFileManager::LFS_Shared: {
       // Someone else is responsible for building the module. Wait for them to
       // finish.
+      llvm::TimeRecord Start = llvm::TimeRecord::getCurrentTime(true);
       if (Locked.waitForUnlock() == llvm::LockFileManager::Res_OwnerDied)
         continue; // try again to get the lock.
+      reportElapsed(diag::remark_module_build_wait, Start);
       ModuleLoadCapabilities |= ASTReader::ARR_OutOfDate;
       break;
     }
+    }
 
     // Try to read the module file, now that we've compiled it.
     ASTReader::ASTReadResult ReadResult =
@@ -1314,8 +1391,14 @@ CompilerInstance::loadModule(SourceLocation ImportLoc,
 
     // Try to load the module file.
     unsigned ARRFlags = ASTReader::ARR_OutOfDate | ASTReader::ARR_Missing;
-    switch (ModuleManager->ReadAST(ModuleFileName, serialization::MK_Module,
-                                   ImportLoc, ARRFlags)) {
+    ASTReader::ASTReadResult ReadResult;
+    {
+      llvm::TimeRegion TimeLoading(getASTFileLoadTimer());
+      ReadResult = ModuleManager->ReadAST(ModuleFileName,
+                                          serialization::MK_Module, ImportLoc,
+                                          ARRFlags);
+    }
+    switch (ReadResult) {
     case ASTReader::Success:
       break;
 
@@ -1555,6 +1638,7 @@ GlobalModuleIndex *CompilerInstance::loadGlobalModuleIndex(
   if (!HaveFullGlobalModuleIndex && GlobalIndex && !buildingModule()) {
     ModuleMap &MMap = getPreprocessor().getHeaderSearchInfo().getModuleMap();
     bool RecreateIndex = false;
+    MMap.parseAllDeferredModules();
     for (ModuleMap::module_iterator I = MMap.module_begin(),
         E = MMap.module_end(); I != E; ++I) {
       Module *TheModule = I->second;
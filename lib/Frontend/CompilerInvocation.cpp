@@ -35,6 +35,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include <atomic>
+#include <map>
 #include <memory>
 #include <sys/stat.h>
 #include <system_error>
@@ -591,6 +592,7 @@ static void ParseDependencyOutputArgs(DependencyOutputOptions &Opts,
   Opts.AddMissingHeaderDeps = Args.hasArg(OPT_MG);
   Opts.PrintShowIncludes = Args.hasArg(OPT_show_includes);
   Opts.DOTOutputFile = Args.getLastArgValue(OPT_dependency_dot);
+  Opts.HashOutputFile = Args.getLastArgValue(OPT_dependency_hash_file);
   Opts.ModuleDependencyOutputDir =
       Args.getLastArgValue(OPT_module_dependency_dir);
 }
@@ -690,6 +692,9 @@ bool clang::ParseDiagnosticArgs(DiagnosticOptions &Opts, ArgList &Args,
   Opts.ConstexprBacktraceLimit = getLastArgIntValue(
       Args, OPT_fconstexpr_backtrace_limit,
       DiagnosticOptions::DefaultConstexprBacktraceLimit, Diags);
+  Opts.SpellCheckingLimit = getLastArgIntValue(
+      Args, OPT_fspell_checking_limit,
+      DiagnosticOptions::DefaultSpellCheckingLimit, Diags);
   Opts.TabStop = getLastArgIntValue(Args, OPT_ftabstop,
                                     DiagnosticOptions::DefaultTabStop, Diags);
   if (Opts.TabStop == 0 || Opts.TabStop > DiagnosticOptions::MaxTabStop) {
@@ -779,6 +784,8 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
       Opts.ProgramAction = frontend::MigrateSource; break;
     case OPT_Eonly:
       Opts.ProgramAction = frontend::RunPreprocessorOnly; break;
+    case OPT_dependency_scan:
+      Opts.ProgramAction = frontend::DependencyScan; break;
     }
   }
 
@@ -818,6 +825,7 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.RelocatablePCH = Args.hasArg(OPT_relocatable_pch);
   Opts.ShowHelp = Args.hasArg(OPT_help);
   Opts.ShowStats = Args.hasArg(OPT_print_stats);
+  Opts.ShowMemoryUsage = Args.hasArg(OPT_print_memory_usage);
   Opts.ShowTimers = Args.hasArg(OPT_ftime_report);
   Opts.ShowVersion = Args.hasArg(OPT_version);
   Opts.ASTMergeFiles = Args.getAllArgValues(OPT_ast_merge);
@@ -828,6 +836,11 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.FixToTemporaries = Args.hasArg(OPT_fixit_to_temp);
   Opts.ASTDumpFilter = Args.getLastArgValue(OPT_ast_dump_filter);
   Opts.ASTDumpLookups = Args.hasArg(OPT_ast_dump_lookups);
+  Opts.SkipVTableDefinitions = Args.hasArg(OPT_skip_vtable_definitions);
+  Opts.TemplateInstantiationTraceFile =
+      Args.getLastArgValue(OPT_ftemplate_instantiation_trace_EQ);
+  Opts.StatCacheFile = Args.getLastArgValue(OPT_stat_cache);
+  Opts.StatCacheEpoch = Args.getLastArgValue(OPT_stat_cache_epoch);
   Opts.UseGlobalModuleIndex = !Args.hasArg(OPT_fno_modules_global_index);
   Opts.GenerateGlobalModuleIndex = Opts.UseGlobalModuleIndex;
   
@@ -896,6 +909,25 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
 
   Opts.ObjCMTWhiteListPath = Args.getLastArgValue(OPT_objcmt_whitelist_dir_path);
 
+  // Skipping vtable definitions leaves virtual members undefined, so it is
+  // only allowed for actions that don't generate code or serialize the AST.
+  if (Opts.SkipVTableDefinitions) {
+    switch (Opts.ProgramAction) {
+    case frontend::ASTDeclList:
+    case frontend::ASTDump:
+    case frontend::ASTPrint:
+    case frontend::ASTView:
+    case frontend::ParseSyntaxOnly:
+    case frontend::PluginAction:
+      break;
+    default:
+      Diags.Report(diag::err_drv_argument_only_allowed_with)
+        << "-skip-vtable-definitions" << "-fsyntax-only";
+      Opts.SkipVTableDefinitions = false;
+      break;
+    }
+  }
+
   if (Opts.ARCMTAction != FrontendOptions::ARCMT_None &&
       Opts.ObjCMTAction != FrontendOptions::ObjCMT_None) {
     Diags.Report(diag::err_drv_argument_not_allowed_with)
@@ -991,6 +1023,7 @@ static void ParseHeaderSearchArgs(HeaderSearchOptions &Opts, ArgList &Args) {
       getLastArgUInt64Value(Args, OPT_fbuild_session_timestamp, 0);
   Opts.ModulesValidateSystemHeaders =
       Args.hasArg(OPT_fmodules_validate_system_headers);
+  Opts.ModulesLazyModuleMaps = Args.hasArg(OPT_fmodules_lazy_module_maps);
 
   for (arg_iterator it = Args.filtered_begin(OPT_fmodules_ignore_macro),
                     ie = Args.filtered_end();
@@ -1462,8 +1495,11 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
       getLastArgIntValue(Args, OPT_fconstexpr_depth, 512, Diags);
   Opts.ConstexprStepLimit =
       getLastArgIntValue(Args, OPT_fconstexpr_steps, 1048576, Diags);
+  Opts.ConstexprCacheSize =
+      getLastArgIntValue(Args, OPT_fconstexpr_cache_size, 0, Diags);
   Opts.BracketDepth = getLastArgIntValue(Args, OPT_fbracket_depth, 256, Diags);
   Opts.DelayedTemplateParsing = Args.hasArg(OPT_fdelayed_template_parsing);
+  Opts.PCHInstantiateTemplates = Args.hasArg(OPT_fpch_instantiate_templates);
   Opts.NumLargeByValueCopy =
       getLastArgIntValue(Args, OPT_Wlarge_by_value_copy_EQ, 0, Diags);
   Opts.MSBitfields = Args.hasArg(OPT_mms_bitfields);
@@ -1623,12 +1659,15 @@ static void ParsePreprocessorArgs(PreprocessorOptions &Opts, ArgList &Args,
   using namespace options;
   Opts.ImplicitPCHInclude = Args.getLastArgValue(OPT_include_pch);
   Opts.ImplicitPTHInclude = Args.getLastArgValue(OPT_include_pth);
+  Opts.IncludeGuardIndex = Args.getLastArgValue(OPT_include_guard_index);
   if (const Arg *A = Args.getLastArg(OPT_token_cache))
       Opts.TokenCache = A->getValue();
   else
     Opts.TokenCache = Opts.ImplicitPTHInclude;
   Opts.UsePredefines = !Args.hasArg(OPT_undef);
   Opts.DetailedRecord = Args.hasArg(OPT_detailed_preprocessing_record);
+  Opts.DetailedRecordExpansions =
+      !Args.hasArg(OPT_detailed_preprocessing_record_no_expansions);
   Opts.DisablePCHValidation = Args.hasArg(OPT_fno_validate_pch);
 
   Opts.DumpDeserializedPCHDecls = Args.hasArg(OPT_dump_deserialized_pch_decls);
@@ -1743,6 +1782,7 @@ static void ParsePreprocessorOutputArgs(PreprocessorOutputOptions &Opts,
     Opts.ShowCPP = 0;
     break;
 
+  case frontend::DependencyScan:
   case frontend::DumpRawTokens:
   case frontend::DumpTokens:
   case frontend::InitOnly:
@@ -1782,6 +1822,12 @@ bool CompilerInvocation::CreateFromArgs(CompilerInvocation &Res,
   bool Success = true;
 
   // Parse the arguments.
+  // FIXME: Every hasArg/getLastArg query below is a linear scan of the
+  // argument list, and there are hundreds of them, so option parsing is
+  // quadratic-ish for long command lines (many -I/-D flags). The fix belongs
+  // in llvm::opt::ArgList, which could index its arguments by option ID (and
+  // the IDs of the aliases and groups they match) when they are appended;
+  // the Driver would benefit as well.
   std::unique_ptr<OptTable> Opts(createDriverOptTable());
   const unsigned IncludedFlagsBitmask = options::CC1Option;
   unsigned MissingArgIndex, MissingArgCount;
@@ -1917,21 +1963,28 @@ std::string CompilerInvocation::getModuleHash() const {
   const HeaderSearchOptions &hsOpts = getHeaderSearchOpts();
   code = hash_combine(code, ppOpts.UsePredefines, ppOpts.DetailedRecord);
 
+  // Only the last -D or -U of each macro determines its state, so hash the
+  // final state of each macro in name order. This way invocations that list
+  // the same macros in a different order, or repeat one, share a module cache.
+  std::map<StringRef, std::pair<StringRef, bool/*isUndef*/> > FinalMacros;
   for (std::vector<std::pair<std::string, bool/*isUndef*/> >::const_iterator 
             I = getPreprocessorOpts().Macros.begin(),
          IEnd = getPreprocessorOpts().Macros.end();
        I != IEnd; ++I) {
+    StringRef MacroDef = I->first;
+    StringRef MacroName = MacroDef.split('=').first;
+
     // If we're supposed to ignore this macro for the purposes of modules,
     // don't put it into the hash.
-    if (!hsOpts.ModulesIgnoreMacros.empty()) {
-      // Check whether we're ignoring this macro.
-      StringRef MacroDef = I->first;
-      if (hsOpts.ModulesIgnoreMacros.count(MacroDef.split('=').first))
-        continue;
-    }
+    if (hsOpts.ModulesIgnoreMacros.count(MacroName))
+      continue;
 
-    code = hash_combine(code, I->first, I->second);
+    FinalMacros[MacroName] = std::make_pair(MacroDef, I->second);
   }
+  for (std::map<StringRef, std::pair<StringRef, bool> >::const_iterator
+           I = FinalMacros.begin(), IEnd = FinalMacros.end();
+       I != IEnd; ++I)
+    code = hash_combine(code, I->second.first, I->second.second);
 
   // Extend the signature with the sysroot.
   code = hash_combine(code, hsOpts.Sysroot, hsOpts.UseBuiltinIncludes,
@@ -21,13 +21,27 @@
 #include "clang/Lex/PPCallbacks.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Serialization/ASTReader.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace clang;
 
+/// Remove leading "./" (or ".//" or "././" etc.) from \p Filename.
+static StringRef stripLeadingDotSlash(StringRef Filename) {
+  while (Filename.size() > 2 && Filename[0] == '.' &&
+         llvm::sys::path::is_separator(Filename[1])) {
+    Filename = Filename.substr(1);
+    while (llvm::sys::path::is_separator(Filename[0]))
+      Filename = Filename.substr(1);
+  }
+  return Filename;
+}
+
 namespace {
 struct DepCollectorPPCallbacks : public PPCallbacks {
   DependencyCollector &DepCollector;
@@ -49,21 +63,23 @@ struct DepCollectorPPCallbacks : public PPCallbacks {
     if (!FE)
       return;
 
-    StringRef Filename = FE->getName();
-
-    // Remove leading "./" (or ".//" or "././" etc.)
-    while (Filename.size() > 2 && Filename[0] == '.' &&
-           llvm::sys::path::is_separator(Filename[1])) {
-      Filename = Filename.substr(1);
-      while (llvm::sys::path::is_separator(Filename[0]))
-        Filename = Filename.substr(1);
-    }
+    StringRef Filename = stripLeadingDotSlash(FE->getName());
 
     DepCollector.maybeAddDependency(Filename, /*FromModule*/false,
                                    FileType != SrcMgr::C_User,
                                    /*IsModuleFile*/false, /*IsMissing*/false);
   }
 
+  void FileSkipped(const FileEntry &SkippedFile, const Token &FilenameTok,
+                   SrcMgr::CharacteristicKind FileType) override {
+    // A header can be skipped without ever being entered, when the include
+    // guard index already knows its guard, so it is still a dependency.
+    DepCollector.maybeAddDependency(stripLeadingDotSlash(SkippedFile.getName()),
+                                   /*FromModule*/false,
+                                   FileType != SrcMgr::C_User,
+                                   /*IsModuleFile*/false, /*IsMissing*/false);
+  }
+
   void InclusionDirective(SourceLocation HashLoc, const Token &IncludeTok,
                           StringRef FileName, bool IsAngled,
                           CharSourceRange FilenameRange, const FileEntry *File,
@@ -127,6 +143,99 @@ void DependencyCollector::attachToASTReader(ASTReader &R) {
   R.addListener(new DepCollectorASTListener(*this));
 }
 
+namespace {
+/// Writes the dependencies of the main file, with the hashes of the contents
+/// of those that were read into the SourceManager.
+class DependencyHashCollector : public DependencyCollector {
+  enum DependencyKind { DK_Input, DK_ModuleInput, DK_ModuleFile };
+
+  std::string OutputFile;
+  SourceManager &SM;
+  DiagnosticsEngine &Diags;
+  bool IncludeSystemHeaders;
+  std::vector<std::pair<std::string, DependencyKind> > Deps;
+
+public:
+  DependencyHashCollector(StringRef OutputFile, SourceManager &SM,
+                          DiagnosticsEngine &Diags, bool IncludeSystemHeaders)
+      : OutputFile(OutputFile), SM(SM), Diags(Diags),
+        IncludeSystemHeaders(IncludeSystemHeaders) {}
+
+  bool sawDependency(StringRef Filename, bool FromModule, bool IsSystem,
+                     bool IsModuleFile, bool IsMissing) override {
+    if (IsMissing || !DependencyCollector::sawDependency(
+                         Filename, FromModule, IsSystem, IsModuleFile,
+                         IsMissing))
+      return false;
+
+    DependencyKind Kind = IsModuleFile ? DK_ModuleFile
+                          : FromModule ? DK_ModuleInput : DK_Input;
+    Deps.push_back(std::make_pair(Filename.str(), Kind));
+    return true;
+  }
+
+  bool needSystemDependencies() override { return IncludeSystemHeaders; }
+
+  void finishedMainFile() override;
+};
+} // end anonymous namespace
+
+void DependencyHashCollector::finishedMainFile() {
+  std::string Err;
+  llvm::raw_fd_ostream OS(OutputFile.c_str(), Err, llvm::sys::fs::F_Text);
+  if (!Err.empty()) {
+    Diags.Report(diag::err_fe_error_opening) << OutputFile << Err;
+    return;
+  }
+
+  // Find the contents of every file that was read, by the name it was
+  // reported under. Files that were only stat'ed, such as the inputs of
+  // modules and headers skipped through the include guard index, have no
+  // buffer and are written without a hash.
+  llvm::StringMap<const llvm::MemoryBuffer *> Buffers;
+  for (SourceManager::fileinfo_iterator I = SM.fileinfo_begin(),
+                                        E = SM.fileinfo_end();
+       I != E; ++I) {
+    const llvm::MemoryBuffer *Buffer = I->second->getRawBuffer();
+    if (Buffer && !I->second->isBufferInvalid())
+      Buffers[stripLeadingDotSlash(I->first->getName())] = Buffer;
+  }
+
+  for (unsigned I = 0, N = Deps.size(); I != N; ++I) {
+    const std::string &Filename = Deps[I].first;
+    const llvm::MemoryBuffer *Buffer = nullptr;
+    if (Deps[I].second != DK_ModuleFile)
+      Buffer = Buffers.lookup(Filename);
+
+    if (Buffer) {
+      llvm::MD5 Hash;
+      Hash.update(Buffer->getBuffer());
+      llvm::MD5::MD5Result Result;
+      Hash.final(Result);
+      SmallString<32> HashStr;
+      llvm::MD5::stringifyResult(Result, HashStr);
+      OS << HashStr;
+    } else {
+      OS << '-';
+    }
+
+    switch (Deps[I].second) {
+    case DK_Input:       OS << " input ";        break;
+    case DK_ModuleInput: OS << " module-input "; break;
+    case DK_ModuleFile:  OS << " module-file ";  break;
+    }
+    OS << Filename << '\n';
+  }
+}
+
+std::shared_ptr<DependencyCollector>
+clang::createDependencyHashCollector(StringRef OutputFile, SourceManager &SM,
+                                     DiagnosticsEngine &Diags,
+                                     bool IncludeSystemHeaders) {
+  return std::make_shared<DependencyHashCollector>(OutputFile, SM, Diags,
+                                                   IncludeSystemHeaders);
+}
+
 namespace {
 /// Private implementation for DependencyFileGenerator
 class DFGImpl : public PPCallbacks {
@@ -157,6 +266,8 @@ public:
   void FileChanged(SourceLocation Loc, FileChangeReason Reason,
                    SrcMgr::CharacteristicKind FileType,
                    FileID PrevFID) override;
+  void FileSkipped(const FileEntry &SkippedFile, const Token &FilenameTok,
+                   SrcMgr::CharacteristicKind FileType) override;
   void InclusionDirective(SourceLocation HashLoc, const Token &IncludeTok,
                           StringRef FileName, bool IsAngled,
                           CharSourceRange FilenameRange, const FileEntry *File,
@@ -246,15 +357,19 @@ void DFGImpl::FileChanged(SourceLocation Loc,
   if (!FileMatchesDepCriteria(Filename.data(), FileType))
     return;
 
-  // Remove leading "./" (or ".//" or "././" etc.)
-  while (Filename.size() > 2 && Filename[0] == '.' &&
-         llvm::sys::path::is_separator(Filename[1])) {
-    Filename = Filename.substr(1);
-    while (llvm::sys::path::is_separator(Filename[0]))
-      Filename = Filename.substr(1);
-  }
-    
-  AddFilename(Filename);
+  AddFilename(stripLeadingDotSlash(Filename));
+}
+
+void DFGImpl::FileSkipped(const FileEntry &SkippedFile,
+                          const Token &FilenameTok,
+                          SrcMgr::CharacteristicKind FileType) {
+  // Usually the skipped file was entered earlier and is already listed, but
+  // the include guard index can skip a header that was never entered.
+  StringRef Filename = SkippedFile.getName();
+  if (!FileMatchesDepCriteria(Filename.data(), FileType))
+    return;
+
+  AddFilename(stripLeadingDotSlash(Filename));
 }
 
 void DFGImpl::InclusionDirective(SourceLocation HashLoc,
@@ -19,8 +19,11 @@
 #include "clang/Frontend/MultiplexConsumer.h"
 #include "clang/Frontend/Utils.h"
 #include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/PreprocessingRecord.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Parse/ParseAST.h"
+#include "clang/Sema/InstantiationTrace.h"
+#include "clang/Sema/Sema.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
@@ -426,6 +429,49 @@ bool FrontendAction::Execute() {
   return true;
 }
 
+/// Print the memory allocated by each frontend subsystem as a JSON object,
+/// with one member per subsystem giving its size in bytes.
+static void PrintMemoryUsage(CompilerInstance &CI, raw_ostream &OS) {
+  bool First = true;
+  auto Entry = [&](StringRef Name, size_t Bytes) {
+    OS << (First ? "{" : ", ") << '"' << Name << "\": " << Bytes;
+    First = false;
+  };
+
+  if (CI.hasASTContext()) {
+    ASTContext &Ctx = CI.getASTContext();
+    Entry("ast", Ctx.getASTAllocatedMemory());
+    Entry("ast_side_tables", Ctx.getSideTableAllocatedMemory());
+    Entry("identifiers", Ctx.Idents.getAllocator().getTotalMemory());
+    Entry("selectors", Ctx.Selectors.getTotalMemory());
+    if (ExternalASTSource *Source = Ctx.getExternalSource()) {
+      ExternalASTSource::MemoryBufferSizes Sizes =
+          Source->getMemoryBufferSizes();
+      Entry("external_ast_source_malloc", Sizes.malloc_bytes);
+      Entry("external_ast_source_mmap", Sizes.mmap_bytes);
+    }
+  }
+
+  if (CI.hasSourceManager()) {
+    SourceManager &SM = CI.getSourceManager();
+    SourceManager::MemoryBufferSizes Sizes = SM.getMemoryBufferSizes();
+    Entry("source_manager_content_cache", SM.getContentCacheSize());
+    Entry("source_manager_data_structures", SM.getDataStructureSizes());
+    Entry("source_buffers_malloc", Sizes.malloc_bytes);
+    Entry("source_buffers_mmap", Sizes.mmap_bytes);
+  }
+
+  if (CI.hasPreprocessor()) {
+    Preprocessor &PP = CI.getPreprocessor();
+    Entry("preprocessor", PP.getTotalMemory());
+    if (PreprocessingRecord *PPRec = PP.getPreprocessingRecord())
+      Entry("preprocessing_record", PPRec->getTotalMemory());
+    Entry("header_search", PP.getHeaderSearchInfo().getTotalMemory());
+  }
+
+  OS << (First ? "{}\n" : "}\n");
+}
+
 void FrontendAction::EndSourceFile() {
   CompilerInstance &CI = getCompilerInstance();
 
@@ -435,6 +481,15 @@ void FrontendAction::EndSourceFile() {
   // Finalize the action.
   EndSourceFileAction();
 
+  // Report memory usage while the AST and Sema are still alive.
+  if (CI.getFrontendOpts().ShowMemoryUsage)
+    PrintMemoryUsage(CI, llvm::errs());
+
+  // The instantiation trace is written out when it is destroyed; make sure
+  // that happens even if Sema is leaked below.
+  if (CI.hasSema())
+    CI.getSema().InstTrace.reset();
+
   // Sema references the ast consumer, so reset sema first.
   //
   // FIXME: There is more per-file stuff we could just drop here?
@@ -16,6 +16,7 @@
 #include "clang/Basic/MacroBuilder.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TargetOptions.h"
 #include "clang/Basic/Version.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
 #include "clang/Frontend/FrontendOptions.h"
@@ -24,8 +25,12 @@
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Serialization/ASTReader.h"
 #include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/MutexGuard.h"
 #include "llvm/Support/Path.h"
 using namespace clang;
 
@@ -865,34 +870,92 @@ static void InitializePredefinedMacros(const TargetInfo &TI,
   TI.getTargetDefines(LangOpts, Builder);
 }
 
-/// InitializePreprocessor - Initialize the preprocessor getting it and the
-/// environment ready to process a single file. This returns true on error.
+/// \brief Build a string that determines the macros defined by
+/// InitializePredefinedMacros and InitializeStandardPredefinedMacros: the
+/// target configuration, every language option, and the few preprocessor and
+/// frontend options they look at.
+static std::string
+getBuiltinPredefinesKey(const TargetInfo &TI, const LangOptions &LangOpts,
+                        const FrontendOptions &FEOpts,
+                        const PreprocessorOptions &InitOpts) {
+  std::string Key;
+  llvm::raw_string_ostream OS(Key);
+
+  const TargetOptions &TargetOpts = TI.getTargetOpts();
+  OS << TargetOpts.Triple << '\0' << TargetOpts.CPU << '\0'
+     << TargetOpts.FPMath << '\0' << TargetOpts.ABI << '\0'
+     << TargetOpts.LinkerVersion << '\0';
+  for (unsigned I = 0, N = TargetOpts.Features.size(); I != N; ++I)
+    OS << TargetOpts.Features[I] << '\0';
+  OS << '\0';
+
+#define LANGOPT(Name, Bits, Default, Description) \
+  OS << LangOpts.Name << ',';
+#define ENUM_LANGOPT(Name, Type, Bits, Default, Description) \
+  OS << static_cast<unsigned>(LangOpts.get##Name()) << ',';
+#include "clang/Basic/LangOptions.def"
+#define SANITIZER(NAME, ID) \
+  OS << LangOpts.Sanitize.ID;
+#include "clang/Basic/Sanitizers.def"
+
+  OS << ',' << LangOpts.ObjCRuntime << ','
+     << static_cast<unsigned>(FEOpts.ProgramAction) << ','
+     << InitOpts.UsePredefines << ','
+     << static_cast<unsigned>(InitOpts.ObjCXXARCStandardLibrary);
+  return OS.str();
+}
+
+namespace {
+/// \brief The builtin predefines generated so far in this process, keyed by
+/// getBuiltinPredefinesKey.
+struct BuiltinPredefinesCache {
+  llvm::sys::SmartMutex<false> Lock;
+  llvm::StringMap<std::string> Entries;
+};
+}
+
+static llvm::ManagedStatic<BuiltinPredefinesCache> BuiltinPredefines;
+
+/// \brief Append the target, language and standard predefined macros to
+/// \p Builder.
 ///
-void clang::InitializePreprocessor(Preprocessor &PP,
-                                   const PreprocessorOptions &InitOpts,
-                                   const FrontendOptions &FEOpts) {
+/// These don't depend on anything specific to one source file, and tools that
+/// run many compiler invocations in one process would otherwise regenerate
+/// the same few hundred definitions for each of them, so the text is cached
+/// per process, keyed by everything it depends on.
+static void AddBuiltinPredefines(Preprocessor &PP,
+                                 const PreprocessorOptions &InitOpts,
+                                 const FrontendOptions &FEOpts,
+                                 raw_ostream &Predefines) {
   const LangOptions &LangOpts = PP.getLangOpts();
-  std::string PredefineBuffer;
-  PredefineBuffer.reserve(4080);
-  llvm::raw_string_ostream Predefines(PredefineBuffer);
-  MacroBuilder Builder(Predefines);
+  const TargetInfo &TI = PP.getTargetInfo();
+  std::string Key = getBuiltinPredefinesKey(TI, LangOpts, FEOpts, InitOpts);
 
-  // Emit line markers for various builtin sections of the file.  We don't do
-  // this in asm preprocessor mode, because "# 4" is not a line marker directive
-  // in this mode.
-  if (!PP.getLangOpts().AsmPreprocessor)
-    Builder.append("# 1 \"<built-in>\" 3");
+  BuiltinPredefinesCache &Cache = *BuiltinPredefines;
+  {
+    llvm::MutexGuard Guard(Cache.Lock);
+    llvm::StringMap<std::string>::iterator Known = Cache.Entries.find(Key);
+    if (Known != Cache.Entries.end()) {
+      Predefines << Known->getValue();
+      return;
+    }
+  }
+
+  std::string Buffer;
+  Buffer.reserve(4080);
+  llvm::raw_string_ostream OS(Buffer);
+  MacroBuilder Builder(OS);
 
   // Install things like __POWERPC__, __GNUC__, etc into the macro table.
   if (InitOpts.UsePredefines) {
-    InitializePredefinedMacros(PP.getTargetInfo(), LangOpts, FEOpts, Builder);
+    InitializePredefinedMacros(TI, LangOpts, FEOpts, Builder);
 
     // Install definitions to make Objective-C++ ARC work well with various
     // C++ Standard Library implementations.
     if (LangOpts.ObjC1 && LangOpts.CPlusPlus && LangOpts.ObjCAutoRefCount) {
       switch (InitOpts.ObjCXXARCStandardLibrary) {
       case ARCXX_nolib:
-        case ARCXX_libcxx:
+      case ARCXX_libcxx:
         break;
 
       case ARCXX_libstdcxx:
@@ -905,8 +968,32 @@ void clang::InitializePreprocessor(Preprocessor &PP,
   // Even with predefines off, some macros are still predefined.
   // These should all be defined in the preprocessor according to the
   // current language configuration.
-  InitializeStandardPredefinedMacros(PP.getTargetInfo(), PP.getLangOpts(),
-                                     FEOpts, Builder);
+  InitializeStandardPredefinedMacros(TI, LangOpts, FEOpts, Builder);
+
+  Predefines << OS.str();
+  llvm::MutexGuard Guard(Cache.Lock);
+  Cache.Entries[Key] = OS.str();
+}
+
+/// InitializePreprocessor - Initialize the preprocessor getting it and the
+/// environment ready to process a single file. This returns true on error.
+///
+void clang::InitializePreprocessor(Preprocessor &PP,
+                                   const PreprocessorOptions &InitOpts,
+                                   const FrontendOptions &FEOpts) {
+  std::string PredefineBuffer;
+  PredefineBuffer.reserve(4080);
+  llvm::raw_string_ostream Predefines(PredefineBuffer);
+  MacroBuilder Builder(Predefines);
+
+  // Emit line markers for various builtin sections of the file.  We don't do
+  // this in asm preprocessor mode, because "# 4" is not a line marker directive
+  // in this mode.
+  if (!PP.getLangOpts().AsmPreprocessor)
+    Builder.append("# 1 \"<built-in>\" 3");
+
+  // Install the target, language and standard predefined macros.
+  AddBuiltinPredefines(PP, InitOpts, FEOpts, Predefines);
 
   // Add on the predefines from the driver.  Wrap in a #line directive to report
   // that they come from the command line.
@@ -28,6 +28,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstdio>
+#include <cstring>
 using namespace clang;
 
 /// PrintMacroDefinition - Print a macro definition in a form that will be
@@ -592,6 +593,17 @@ struct UnknownPragmaHandler : public PragmaHandler {
 } // end anonymous namespace
 
 
+/// getFixedSpelling - If Tok is a punctuator spelled the canonical way,
+/// return that spelling, which saves looking the token up in its source
+/// buffer.  Digraphs, trigraphs and escaped newlines all make the token longer
+/// than its canonical spelling.
+static const char *getFixedSpelling(const Token &Tok) {
+  const char *Punc = tok::getPunctuatorSpelling(Tok.getKind());
+  if (!Punc || Tok.needsCleaning() || strlen(Punc) != Tok.getLength())
+    return nullptr;
+  return Punc;
+}
+
 static void PrintPreprocessedTokens(Preprocessor &PP, Token &Tok,
                                     PrintPPOutputPPCallbacks *Callbacks,
                                     raw_ostream &OS) {
@@ -638,7 +650,11 @@ static void PrintPreprocessedTokens(Preprocessor &PP, Token &Tok,
     } else if (Tok.isLiteral() && !Tok.needsCleaning() &&
                Tok.getLiteralData()) {
       OS.write(Tok.getLiteralData(), Tok.getLength());
-    } else if (Tok.getLength() < 256) {
+    } else if (const char *Punc = getFixedSpelling(Tok)) {
+      OS.write(Punc, Tok.getLength());
+    } else if (Tok.getLength() < 256 || !Tok.needsCleaning()) {
+      // Clean tokens are written straight from the source buffer; only tokens
+      // that need cleaning are copied into Buffer.
       const char *TokPtr = Buffer;
       unsigned Len = PP.getSpelling(Tok, TokPtr);
       OS.write(TokPtr, Len);
@@ -130,6 +130,10 @@ private:
   /// \brief End a DIAG block.
   void ExitDiagBlock();
 
+  /// \brief Write the serialized content emitted so far to the output
+  /// stream.  Only valid when no block is open.
+  void FlushBuffer();
+
   /// \brief Emit a DIAG record.
   void EmitDiagnosticMessage(SourceLocation Loc,
                              PresumedLoc PLoc,
@@ -524,8 +528,12 @@ void SDiagsWriter::HandleDiagnostic(DiagnosticsEngine::Level DiagLevel,
   // for beginDiagnostic, in case associated notes are emitted before we get
   // there.
   if (DiagLevel != DiagnosticsEngine::Note) {
-    if (State->EmittedAnyDiagBlocks)
+    if (State->EmittedAnyDiagBlocks) {
       ExitDiagBlock();
+      // The previous diagnostic and its notes are complete, so hand them to
+      // the output stream rather than holding every diagnostic in memory.
+      FlushBuffer();
+    }
 
     EnterDiagBlock();
     State->EmittedAnyDiagBlocks = true;
@@ -630,6 +638,15 @@ void SDiagsWriter::ExitDiagBlock() {
   State->Stream.ExitBlock();
 }
 
+void SDiagsWriter::FlushBuffer() {
+  // The bitstream writer only refers back into the buffer to backpatch the
+  // sizes of open blocks, so the buffer can be drained between blocks.
+  if (State->Buffer.empty())
+    return;
+  State->OS->write((char *)&State->Buffer.front(), State->Buffer.size());
+  State->Buffer.clear();
+}
+
 void SDiagsRenderer::beginDiagnostic(DiagOrStoredDiag D,
                                      DiagnosticsEngine::Level Level) {
   if (Level == DiagnosticsEngine::Note)
@@ -698,8 +715,8 @@ void SDiagsWriter::finish() {
   if (State->EmittedAnyDiagBlocks)
     ExitDiagBlock();
 
-  // Write the generated bitstream to "Out".
-  State->OS->write((char *)&State->Buffer.front(), State->Buffer.size());
+  // Write the rest of the generated bitstream to "Out".
+  FlushBuffer();
   State->OS->flush();
 
   State->OS.reset();
@@ -1085,6 +1085,11 @@ void TextDiagnostic::emitSnippetAndCaret(
   if (Invalid)
     return;
 
+  // Both of these are cheap for repeated diagnostics in the same file:
+  // getLineNumber builds the file's line table once and remembers the last
+  // line it found, and getColumnNumber only scans back to the start of the
+  // line.  Long macro backtraces are already capped by
+  // -fmacro-backtrace-limit in DiagnosticRenderer.
   unsigned LineNo = SM.getLineNumber(FID, FileOffset);
   unsigned ColNo = SM.getColumnNumber(FID, FileOffset);
   
@@ -713,4 +713,248 @@ _mm512_ceil_pd (__m512d __A)
                                                    _MM_FROUND_CUR_DIRECTION);
 }
 
+/* Gather and scatter.  The scale must be 1, 2, 4 or 8. */
+
+#define _mm512_i32gather_pd(index, addr, scale) __extension__ ({ \
+  (__m512d)__builtin_ia32_gathersiv8df((__v8df)_mm512_setzero_pd(), \
+                                       (void *)(addr), \
+                                       (__v8si)(__m256i)(index), \
+                                       (__mmask8)-1, (scale)); })
+
+#define _mm512_mask_i32gather_pd(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m512d)__builtin_ia32_gathersiv8df((__v8df)(__m512d)(src), \
+                                       (void *)(addr), \
+                                       (__v8si)(__m256i)(index), \
+                                       (__mmask8)(mask), (scale)); })
+
+#define _mm512_i32gather_ps(index, addr, scale) __extension__ ({ \
+  (__m512)__builtin_ia32_gathersiv16sf((__v16sf)_mm512_setzero_ps(), \
+                                       (void *)(addr), \
+                                       (__v16si)(__m512i)(index), \
+                                       (__mmask16)-1, (scale)); })
+
+#define _mm512_mask_i32gather_ps(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m512)__builtin_ia32_gathersiv16sf((__v16sf)(__m512)(src), \
+                                       (void *)(addr), \
+                                       (__v16si)(__m512i)(index), \
+                                       (__mmask16)(mask), (scale)); })
+
+#define _mm512_i64gather_pd(index, addr, scale) __extension__ ({ \
+  (__m512d)__builtin_ia32_gatherdiv8df((__v8df)_mm512_setzero_pd(), \
+                                       (void *)(addr), \
+                                       (__v8di)(__m512i)(index), \
+                                       (__mmask8)-1, (scale)); })
+
+#define _mm512_mask_i64gather_pd(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m512d)__builtin_ia32_gatherdiv8df((__v8df)(__m512d)(src), \
+                                       (void *)(addr), \
+                                       (__v8di)(__m512i)(index), \
+                                       (__mmask8)(mask), (scale)); })
+
+#define _mm512_i64gather_ps(index, addr, scale) __extension__ ({ \
+  (__m256)__builtin_ia32_gatherdiv16sf((__v8sf)_mm256_setzero_ps(), \
+                                       (void *)(addr), \
+                                       (__v8di)(__m512i)(index), \
+                                       (__mmask8)-1, (scale)); })
+
+#define _mm512_mask_i64gather_ps(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m256)__builtin_ia32_gatherdiv16sf((__v8sf)(__m256)(src), \
+                                       (void *)(addr), \
+                                       (__v8di)(__m512i)(index), \
+                                       (__mmask8)(mask), (scale)); })
+
+#define _mm512_i32gather_epi64(index, addr, scale) __extension__ ({ \
+  (__m512i)__builtin_ia32_gathersiv8di((__v8di)_mm512_setzero_si512(), \
+                                       (void *)(addr), \
+                                       (__v8si)(__m256i)(index), \
+                                       (__mmask8)-1, (scale)); })
+
+#define _mm512_mask_i32gather_epi64(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m512i)__builtin_ia32_gathersiv8di((__v8di)(__m512i)(src), \
+                                       (void *)(addr), \
+                                       (__v8si)(__m256i)(index), \
+                                       (__mmask8)(mask), (scale)); })
+
+#define _mm512_i32gather_epi32(index, addr, scale) __extension__ ({ \
+  (__m512i)__builtin_ia32_gathersiv16si((__v16si)_mm512_setzero_si512(), \
+                                        (void *)(addr), \
+                                        (__v16si)(__m512i)(index), \
+                                        (__mmask16)-1, (scale)); })
+
+#define _mm512_mask_i32gather_epi32(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m512i)__builtin_ia32_gathersiv16si((__v16si)(__m512i)(src), \
+                                        (void *)(addr), \
+                                        (__v16si)(__m512i)(index), \
+                                        (__mmask16)(mask), (scale)); })
+
+#define _mm512_i64gather_epi64(index, addr, scale) __extension__ ({ \
+  (__m512i)__builtin_ia32_gatherdiv8di((__v8di)_mm512_setzero_si512(), \
+                                       (void *)(addr), \
+                                       (__v8di)(__m512i)(index), \
+                                       (__mmask8)-1, (scale)); })
+
+#define _mm512_mask_i64gather_epi64(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m512i)__builtin_ia32_gatherdiv8di((__v8di)(__m512i)(src), \
+                                       (void *)(addr), \
+                                       (__v8di)(__m512i)(index), \
+                                       (__mmask8)(mask), (scale)); })
+
+#define _mm512_i64gather_epi32(index, addr, scale) __extension__ ({ \
+  (__m256i)__builtin_ia32_gatherdiv16si((__v8si)_mm256_setzero_si256(), \
+                                        (void *)(addr), \
+                                        (__v8di)(__m512i)(index), \
+                                        (__mmask8)-1, (scale)); })
+
+#define _mm512_mask_i64gather_epi32(src, mask, index, addr, scale) \
+  __extension__ ({ \
+  (__m256i)__builtin_ia32_gatherdiv16si((__v8si)(__m256i)(src), \
+                                        (void *)(addr), \
+                                        (__v8di)(__m512i)(index), \
+                                        (__mmask8)(mask), (scale)); })
+
+#define _mm512_i32scatter_pd(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scattersiv8df((void *)(addr), (__mmask8)-1, \
+                               (__v8si)(__m256i)(index), \
+                               (__v8df)(__m512d)(v), (scale)); })
+
+#define _mm512_mask_i32scatter_pd(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scattersiv8df((void *)(addr), (__mmask8)(mask), \
+                               (__v8si)(__m256i)(index), \
+                               (__v8df)(__m512d)(v), (scale)); })
+
+#define _mm512_i32scatter_ps(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scattersiv16sf((void *)(addr), (__mmask16)-1, \
+                                (__v16si)(__m512i)(index), \
+                                (__v16sf)(__m512)(v), (scale)); })
+
+#define _mm512_mask_i32scatter_ps(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scattersiv16sf((void *)(addr), (__mmask16)(mask), \
+                                (__v16si)(__m512i)(index), \
+                                (__v16sf)(__m512)(v), (scale)); })
+
+#define _mm512_i64scatter_pd(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scatterdiv8df((void *)(addr), (__mmask8)-1, \
+                               (__v8di)(__m512i)(index), \
+                               (__v8df)(__m512d)(v), (scale)); })
+
+#define _mm512_mask_i64scatter_pd(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scatterdiv8df((void *)(addr), (__mmask8)(mask), \
+                               (__v8di)(__m512i)(index), \
+                               (__v8df)(__m512d)(v), (scale)); })
+
+#define _mm512_i64scatter_ps(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scatterdiv16sf((void *)(addr), (__mmask8)-1, \
+                                (__v8di)(__m512i)(index), \
+                                (__v8sf)(__m256)(v), (scale)); })
+
+#define _mm512_mask_i64scatter_ps(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scatterdiv16sf((void *)(addr), (__mmask8)(mask), \
+                                (__v8di)(__m512i)(index), \
+                                (__v8sf)(__m256)(v), (scale)); })
+
+#define _mm512_i32scatter_epi64(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scattersiv8di((void *)(addr), (__mmask8)-1, \
+                               (__v8si)(__m256i)(index), \
+                               (__v8di)(__m512i)(v), (scale)); })
+
+#define _mm512_mask_i32scatter_epi64(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scattersiv8di((void *)(addr), (__mmask8)(mask), \
+                               (__v8si)(__m256i)(index), \
+                               (__v8di)(__m512i)(v), (scale)); })
+
+#define _mm512_i32scatter_epi32(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scattersiv16si((void *)(addr), (__mmask16)-1, \
+                                (__v16si)(__m512i)(index), \
+                                (__v16si)(__m512i)(v), (scale)); })
+
+#define _mm512_mask_i32scatter_epi32(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scattersiv16si((void *)(addr), (__mmask16)(mask), \
+                                (__v16si)(__m512i)(index), \
+                                (__v16si)(__m512i)(v), (scale)); })
+
+#define _mm512_i64scatter_epi64(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scatterdiv8di((void *)(addr), (__mmask8)-1, \
+                               (__v8di)(__m512i)(index), \
+                               (__v8di)(__m512i)(v), (scale)); })
+
+#define _mm512_mask_i64scatter_epi64(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scatterdiv8di((void *)(addr), (__mmask8)(mask), \
+                               (__v8di)(__m512i)(index), \
+                               (__v8di)(__m512i)(v), (scale)); })
+
+#define _mm512_i64scatter_epi32(addr, index, v, scale) __extension__ ({ \
+  __builtin_ia32_scatterdiv16si((void *)(addr), (__mmask8)-1, \
+                                (__v8di)(__m512i)(index), \
+                                (__v8si)(__m256i)(v), (scale)); })
+
+#define _mm512_mask_i64scatter_epi32(addr, mask, index, v, scale) \
+  __extension__ ({ \
+  __builtin_ia32_scatterdiv16si((void *)(addr), (__mmask8)(mask), \
+                                (__v8di)(__m512i)(index), \
+                                (__v8si)(__m256i)(v), (scale)); })
+
+/* Mask register operations */
+
+static __inline __mmask16 __attribute__ ((__always_inline__, __nodebug__))
+_mm512_kand (__mmask16 __A, __mmask16 __B)
+{
+  return (__mmask16) (__A & __B);
+}
+
+static __inline __mmask16 __attribute__ ((__always_inline__, __nodebug__))
+_mm512_kandn (__mmask16 __A, __mmask16 __B)
+{
+  return (__mmask16) (~__A & __B);
+}
+
+static __inline __mmask16 __attribute__ ((__always_inline__, __nodebug__))
+_mm512_kor (__mmask16 __A, __mmask16 __B)
+{
+  return (__mmask16) (__A | __B);
+}
+
+static __inline __mmask16 __attribute__ ((__always_inline__, __nodebug__))
+_mm512_kxor (__mmask16 __A, __mmask16 __B)
+{
+  return (__mmask16) (__A ^ __B);
+}
+
+static __inline __mmask16 __attribute__ ((__always_inline__, __nodebug__))
+_mm512_kxnor (__mmask16 __A, __mmask16 __B)
+{
+  return (__mmask16) (~(__A ^ __B));
+}
+
+static __inline __mmask16 __attribute__ ((__always_inline__, __nodebug__))
+_mm512_knot (__mmask16 __A)
+{
+  return (__mmask16) ~__A;
+}
+
+static __inline int __attribute__ ((__always_inline__, __nodebug__))
+_mm512_kortestz (__mmask16 __A, __mmask16 __B)
+{
+  return (__mmask16) (__A | __B) == 0;
+}
+
+static __inline int __attribute__ ((__always_inline__, __nodebug__))
+_mm512_kortestc (__mmask16 __A, __mmask16 __B)
+{
+  return (__mmask16) (__A | __B) == (__mmask16) -1;
+}
+
 #endif // __AVX512FINTRIN_H
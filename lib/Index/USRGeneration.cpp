@@ -13,6 +13,8 @@
 #include "clang/AST/DeclVisitor.h"
 #include "clang/Lex/PreprocessingRecord.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -805,6 +807,20 @@ bool clang::index::generateUSRForDecl(const Decl *D,
   return UG.ignoreResults();
 }
 
+bool clang::index::generateUSRHashForDecl(const Decl *D, uint64_t &Hash) {
+  SmallString<256> Buf;
+  if (generateUSRForDecl(D, Buf))
+    return true;
+
+  llvm::MD5 MD5;
+  MD5.update(Buf.str());
+  llvm::MD5::MD5Result Result;
+  MD5.final(Result);
+  using namespace llvm::support;
+  Hash = endian::read<uint64_t, little, unaligned>(Result);
+  return false;
+}
+
 bool clang::index::generateUSRForMacro(const MacroDefinition *MD,
                                        const SourceManager &SM,
                                        SmallVectorImpl<char> &Buf) {
@@ -220,8 +220,10 @@ StringRef HeaderMap::lookupFilename(StringRef Filename,
   if (NumBuckets & (NumBuckets-1))
     return StringRef();
 
-  // Linearly probe the hash table.
-  for (unsigned Bucket = HashHMapKey(Filename);; ++Bucket) {
+  // Linearly probe the hash table.  A table without an empty bucket is
+  // corrupt; stop after visiting every bucket once.
+  unsigned Bucket = HashHMapKey(Filename);
+  for (unsigned Probe = 0; Probe != NumBuckets; ++Probe, ++Bucket) {
     HMapBucket B = getBucket(Bucket & (NumBuckets-1));
     if (B.Key == HMAP_EmptyBucketKey) return StringRef(); // Hash miss.
 
@@ -238,4 +240,6 @@ StringRef HeaderMap::lookupFilename(StringRef Filename,
     DestPath.append(Suffix.begin(), Suffix.end());
     return StringRef(DestPath.begin(), DestPath.size());
   }
+
+  return StringRef();
 }
@@ -699,8 +699,14 @@ const FileEntry *HeaderSearch::LookupFile(
 
   // If the entry has been previously looked up, the first value will be
   // non-zero.  If the value is equal to i (the start point of our search), then
-  // this is a matching hit.
-  if (!SkipCache && CacheLookup.StartIdx == i+1) {
+  // this is a matching hit.  A search that started earlier and found the file
+  // at or after i also answers this query, unless a header map along the way
+  // rewrote the name.
+  bool CacheCoversQuery =
+      CacheLookup.StartIdx == i+1 ||
+      (CacheLookup.StartIdx && CacheLookup.StartIdx <= i+1 &&
+       i <= CacheLookup.HitIdx && !CacheLookup.MappedName);
+  if (!SkipCache && CacheCoversQuery) {
     // Skip querying potentially lots of directories for this lookup.
     i = CacheLookup.HitIdx;
     if (CacheLookup.MappedName)
@@ -1308,6 +1314,7 @@ void HeaderSearch::collectAllModules(SmallVectorImpl<Module *> &Modules) {
   }
   
   // Populate the list of modules.
+  ModMap.parseAllDeferredModules();
   for (ModuleMap::module_iterator M = ModMap.module_begin(), 
                                MEnd = ModMap.module_end();
        M != MEnd; ++M) {
@@ -0,0 +1,143 @@
+//===--- IncludeGuardIndex.cpp - Include guards across compiles -----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the IncludeGuardIndex interface.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/IncludeGuardIndex.h"
+#include "clang/Basic/FileManager.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <tuple>
+using namespace clang;
+
+/// The first line of an index file.  Each following line describes one header:
+///   <size> <mtime> <macro> <path>
+static const char IndexSignature[] = "CLANG-INCLUDE-GUARD-INDEX-1";
+
+void IncludeGuardIndex::getKey(const FileEntry *File,
+                               SmallVectorImpl<char> &Key) {
+  Key.append(File->getName(), File->getName() + strlen(File->getName()));
+  llvm::sys::fs::make_absolute(Key);
+}
+
+void IncludeGuardIndex::load() {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> FileOrErr =
+      llvm::MemoryBuffer::getFile(IndexPath);
+  if (!FileOrErr)
+    return;
+
+  SmallVector<StringRef, 128> Lines;
+  FileOrErr.get()->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  if (Lines.empty() || Lines[0] != IndexSignature)
+    return;
+
+  for (unsigned I = 1, N = Lines.size(); I != N; ++I) {
+    StringRef Size, ModTime, Macro, Path;
+    std::tie(Size, Path) = Lines[I].split(' ');
+    std::tie(ModTime, Path) = Path.split(' ');
+    std::tie(Macro, Path) = Path.split(' ');
+
+    Entry E;
+    uint64_t RawModTime;
+    if (Size.getAsInteger(10, E.Size) || ModTime.getAsInteger(10, RawModTime) ||
+        Macro.empty() || Path.empty()) {
+      // Don't trust any part of a corrupt index.
+      Entries.clear();
+      return;
+    }
+    E.ModTime = RawModTime;
+    E.Macro = Macro;
+    Entries[Path] = E;
+  }
+}
+
+bool IncludeGuardIndex::save(std::string &ErrorStr) {
+  if (!Dirty)
+    return false;
+
+  // Other compiles may have extended the index since we loaded it; merge
+  // their entries in so that concurrent compiles don't undo each other.
+  IncludeGuardIndex OnDisk(IndexPath);
+  OnDisk.load();
+  for (llvm::StringMap<Entry>::iterator I = OnDisk.Entries.begin(),
+                                        E = OnDisk.Entries.end();
+       I != E; ++I)
+    Entries.insert(std::make_pair(I->getKey(), I->getValue()));
+
+  // Write to a uniquely named file and rename it into place, so that
+  // concurrent writers don't clobber each other and readers never see a
+  // partially written index.
+  SmallString<128> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          IndexPath + "-%%%%%%%%", FD, TempPath)) {
+    ErrorStr = EC.message();
+    return true;
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << IndexSignature << '\n';
+    for (llvm::StringMap<Entry>::iterator I = Entries.begin(),
+                                          E = Entries.end();
+         I != E; ++I)
+      OS << I->getValue().Size << ' ' << (uint64_t)I->getValue().ModTime << ' '
+         << I->getValue().Macro << ' ' << I->getKey() << '\n';
+
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      ErrorStr = "error writing index";
+      llvm::sys::fs::remove(TempPath.str());
+      return true;
+    }
+  }
+
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath.str(), IndexPath)) {
+    ErrorStr = EC.message();
+    llvm::sys::fs::remove(TempPath.str());
+    return true;
+  }
+
+  Dirty = false;
+  return false;
+}
+
+StringRef IncludeGuardIndex::lookup(const FileEntry *File) const {
+  SmallString<256> Key;
+  getKey(File, Key);
+  llvm::StringMap<Entry>::const_iterator Known = Entries.find(Key);
+  if (Known == Entries.end() || Known->getValue().Size != File->getSize() ||
+      Known->getValue().ModTime != File->getModificationTime())
+    return StringRef();
+  return Known->getValue().Macro;
+}
+
+void IncludeGuardIndex::record(const FileEntry *File, StringRef Macro) {
+  SmallString<256> Key;
+  getKey(File, Key);
+  // Paths with embedded newlines can't be written.
+  if (Key.str().find_first_of("\r\n") != StringRef::npos)
+    return;
+
+  Entry &E = Entries[Key];
+  if (E.Macro == Macro && E.Size == (uint64_t)File->getSize() &&
+      E.ModTime == File->getModificationTime())
+    return;
+
+  E.Size = File->getSize();
+  E.ModTime = File->getModificationTime();
+  E.Macro = Macro;
+  Dirty = true;
+}
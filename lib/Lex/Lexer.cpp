@@ -26,6 +26,14 @@
 #include "llvm/Support/ConvertUTF.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -1474,9 +1482,51 @@ bool Lexer::tryConsumeIdentifierUTF8Char(const char *&CurPtr) {
   return true;
 }
 
+#ifdef __SSE2__
+/// Return the number of leading characters in the 16 bytes starting at Ptr
+/// that match [_A-Za-z0-9].
+static inline unsigned countIdentifierBodyPrefix(const char *Ptr) {
+  __m128i Chars = _mm_loadu_si128((const __m128i*)Ptr);
+  // Folding in the 0x20 bit maps 'A'-'Z' onto 'a'-'z'.  Bytes >= 0x80 are
+  // negative as signed chars, so they fail every range check below.
+  __m128i Lower = _mm_or_si128(Chars, _mm_set1_epi8(0x20));
+  __m128i IsAlpha = _mm_and_si128(_mm_cmpgt_epi8(Lower, _mm_set1_epi8('a'-1)),
+                                  _mm_cmplt_epi8(Lower, _mm_set1_epi8('z'+1)));
+  __m128i IsDigit = _mm_and_si128(_mm_cmpgt_epi8(Chars, _mm_set1_epi8('0'-1)),
+                                  _mm_cmplt_epi8(Chars, _mm_set1_epi8('9'+1)));
+  __m128i IsUnderscore = _mm_cmpeq_epi8(Chars, _mm_set1_epi8('_'));
+  unsigned Mask = _mm_movemask_epi8(
+      _mm_or_si128(IsAlpha, _mm_or_si128(IsDigit, IsUnderscore)));
+  return llvm::countTrailingZeros<unsigned>(~Mask);
+}
+
+/// Return the number of leading characters in the 16 bytes starting at Ptr
+/// that are horizontal whitespace: ' ', '\t', '\f' or '\v'.
+static inline unsigned countHorizontalWhitespacePrefix(const char *Ptr) {
+  __m128i Chars = _mm_loadu_si128((const __m128i*)Ptr);
+  __m128i IsSpace = _mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8(' ')),
+                                 _mm_cmpeq_epi8(Chars, _mm_set1_epi8('\t')));
+  __m128i IsFormFeed = _mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8('\f')),
+                                    _mm_cmpeq_epi8(Chars, _mm_set1_epi8('\v')));
+  unsigned Mask = _mm_movemask_epi8(_mm_or_si128(IsSpace, IsFormFeed));
+  return llvm::countTrailingZeros<unsigned>(~Mask);
+}
+#endif
+
 bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
+#ifdef __SSE2__
+  // Skip long identifiers 16 characters at a time.  Anything interesting
+  // ('$', '\', '?', non-ASCII, or the nul at a code completion point) stops
+  // the scan and is handled by the byte-at-a-time loops below.
+  while (CurPtr + 16 <= BufferEnd) {
+    unsigned Len = countIdentifierBodyPrefix(CurPtr);
+    CurPtr += Len;
+    if (Len != 16)
+      break;
+  }
+#endif
   unsigned char C = *CurPtr++;
   while (isIdentifierBody(C))
     C = *CurPtr++;
@@ -1964,6 +2014,18 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
 
   // Skip consecutive spaces efficiently.
   while (1) {
+#ifdef __SSE2__
+    // Indentation is frequently long enough to be worth skipping in blocks.
+    if (isHorizontalWhitespace(Char)) {
+      while (CurPtr + 16 <= BufferEnd) {
+        unsigned Len = countHorizontalWhitespacePrefix(CurPtr);
+        CurPtr += Len;
+        if (Len != 16)
+          break;
+      }
+      Char = *CurPtr;
+    }
+#endif
     // Skip horizontal whitespace very aggressively.
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
@@ -2031,6 +2093,26 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
   // them.  As such, optimize for this case with the inner loop.
   char C;
   do {
+#ifdef __SSE2__
+    // Skip 16 bytes at a time until we find a byte that might end the
+    // comment.  Escaped newlines and trigraphs are only recognized once we
+    // reach the newline, so they need no special treatment here.
+    __m128i Newlines = _mm_set1_epi8('\n');
+    __m128i Returns = _mm_set1_epi8('\r');
+    __m128i Nuls = _mm_setzero_si128();
+    while (CurPtr + 16 <= BufferEnd) {
+      __m128i Chars = _mm_loadu_si128((const __m128i*)CurPtr);
+      unsigned Mask = _mm_movemask_epi8(
+          _mm_or_si128(_mm_cmpeq_epi8(Chars, Nuls),
+                       _mm_or_si128(_mm_cmpeq_epi8(Chars, Newlines),
+                                    _mm_cmpeq_epi8(Chars, Returns))));
+      if (Mask) {
+        CurPtr += llvm::countTrailingZeros<unsigned>(Mask);
+        break;
+      }
+      CurPtr += 16;
+    }
+#endif
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (C != 0 &&                // Potentially EOF.
@@ -2236,13 +2318,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
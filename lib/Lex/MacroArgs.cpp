@@ -47,6 +47,7 @@ MacroArgs *MacroArgs::create(const MacroInfo *MI,
   
   MacroArgs *Result;
   if (!ResultEnt) {
+    ++PP.NumMacroArgsAllocated;
     // Allocate memory for a MacroArgs object with the lexer tokens at the end.
     Result = (MacroArgs*)malloc(sizeof(MacroArgs) + 
                                 UnexpArgTokens.size() * sizeof(Token));
@@ -63,7 +64,16 @@ MacroArgs *MacroArgs::create(const MacroInfo *MI,
   // Copy the actual unexpanded tokens to immediately after the result ptr.
   if (!UnexpArgTokens.empty())
     std::copy(UnexpArgTokens.begin(), UnexpArgTokens.end(), 
-              const_cast<Token*>(Result->getUnexpArgument(0)));
+              const_cast<Token*>((const Token *)(Result+1)));
+
+  // Remember where each argument starts.
+  Result->UnexpArgStarts.clear();
+  if (!UnexpArgTokens.empty()) {
+    Result->UnexpArgStarts.push_back(0);
+    for (unsigned i = 0, e = UnexpArgTokens.size() - 1; i != e; ++i)
+      if (UnexpArgTokens[i].is(tok::eof))
+        Result->UnexpArgStarts.push_back(i + 1);
+  }
 
   return Result;
 }
@@ -72,6 +82,7 @@ MacroArgs *MacroArgs::create(const MacroInfo *MI,
 ///
 void MacroArgs::destroy(Preprocessor &PP) {
   StringifiedArgs.clear();
+  PreExpNeeded.clear();
 
   // Don't clear PreExpArgTokens, just clear the entries.  Clearing the entries
   // would deallocate the element vectors.
@@ -114,6 +125,9 @@ const Token *MacroArgs::getUnexpArgument(unsigned Arg) const {
   // The unexpanded argument tokens start immediately after the MacroArgs object
   // in memory.
   const Token *Start = (const Token *)(this+1);
+  if (Arg < UnexpArgStarts.size())
+    return Start + UnexpArgStarts[Arg];
+
   const Token *Result = Start;
   // Scan to find Arg.
   for (; Arg; ++Result) {
@@ -142,6 +156,17 @@ bool MacroArgs::ArgNeedsPreexpansion(const Token *ArgTok,
   return false;
 }
 
+bool MacroArgs::ArgNeedsPreexpansion(unsigned Arg, Preprocessor &PP) {
+  enum { Unknown = 0, No, Yes };
+  if (PreExpNeeded.size() <= Arg)
+    PreExpNeeded.resize(Arg + 1, Unknown);
+
+  unsigned char &Cached = PreExpNeeded[Arg];
+  if (Cached == Unknown)
+    Cached = ArgNeedsPreexpansion(getUnexpArgument(Arg), PP) ? Yes : No;
+  return Cached == Yes;
+}
+
 /// getPreExpArgument - Return the pre-expanded form of the specified
 /// argument.
 const std::vector<Token> &
@@ -19,6 +19,7 @@
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/TargetOptions.h"
 #include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/HeaderSearchOptions.h"
 #include "clang/Lex/LexDiagnostic.h"
 #include "clang/Lex/Lexer.h"
 #include "clang/Lex/LiteralSupport.h"
@@ -161,10 +162,12 @@ static bool isBuiltinHeader(StringRef FileName) {
 
 ModuleMap::HeadersMap::iterator
 ModuleMap::findKnownHeader(const FileEntry *File) {
+  parseDeferredModulesForHeader(File);
   HeadersMap::iterator Known = Headers.find(File);
   if (Known == Headers.end() && File->getDir() == BuiltinIncludeDir &&
       isBuiltinHeader(llvm::sys::path::filename(File->getName()))) {
     HeaderInfo.loadTopLevelSystemModules();
+    parseDeferredModulesForHeader(File);
     return Headers.find(File);
   }
   return Known;
@@ -430,6 +433,7 @@ bool ModuleMap::isHeaderInUnavailableModule(const FileEntry *Header) const {
 bool
 ModuleMap::isHeaderUnavailableInModule(const FileEntry *Header,
                                        const Module *RequestingModule) const {
+  const_cast<ModuleMap *>(this)->parseDeferredModulesForHeader(Header);
   HeadersMap::const_iterator Known = Headers.find(Header);
   if (Known != Headers.end()) {
     for (SmallVectorImpl<KnownHeader>::const_iterator
@@ -514,6 +518,12 @@ Module *ModuleMap::findModule(StringRef Name) const {
   if (Known != Modules.end())
     return Known->getValue();
 
+  // The module may have been declared in a module map whose body we skipped.
+  if (DeferredModules.count(Name)) {
+    const_cast<ModuleMap *>(this)->parseDeferredModule(Name);
+    return Modules.lookup(Name);
+  }
+
   return nullptr;
 }
 
@@ -903,6 +913,23 @@ Module *ModuleMap::inferModuleFromLocation(FullSourceLoc Loc) {
 //----------------------------------------------------------------------------//
 
 namespace clang {
+  /// \brief A top-level module declaration found by a scan of a module map
+  /// file, whose body can be parsed on demand.
+  struct DeferrableModuleDecl {
+    /// \brief The name of the module.
+    std::string Name;
+
+    /// \brief The first token of the declaration.
+    SourceLocation Begin;
+
+    /// \brief The closing brace of the module body.
+    SourceLocation End;
+
+    /// \brief The file names (last path components) of the headers the module
+    /// declares.
+    SmallVector<std::string, 4> HeaderNames;
+  };
+
   /// \brief A token in a module map file.
   struct MMToken {
     enum TokenKind {
@@ -1005,6 +1032,10 @@ namespace clang {
     
     /// \brief The active module.
     Module *ActiveModule;
+
+    /// \brief Top-level module declarations to skip over, in file order; their
+    /// bodies are parsed later by the module map, on demand.
+    ArrayRef<DeferrableModuleDecl> DeferredDecls;
     
     /// \brief Consume the current token and return its location.
     SourceLocation consumeToken();
@@ -1048,6 +1079,23 @@ namespace clang {
     }
     
     bool parseModuleMapFile();
+    void scanDeferrableModuleDecls(
+        SmallVectorImpl<DeferrableModuleDecl> &Decls);
+
+    /// \brief Skip the given top-level module declarations when parsing the
+    /// module map file.
+    void setDeferredDecls(ArrayRef<DeferrableModuleDecl> Decls) {
+      DeferredDecls = Decls;
+    }
+
+    /// \brief Parse the single module declaration starting at the current
+    /// token, which was previously skipped.
+    ///
+    /// \returns true if an error occurred, false otherwise.
+    bool parseDeferredModuleDecl() {
+      parseModuleDecl();
+      return HadError;
+    }
   };
 }
 
@@ -2217,6 +2265,23 @@ bool ModuleMapParser::parseOptionalAttributes(Attributes &Attrs) {
 ///     module-declaration*
 bool ModuleMapParser::parseModuleMapFile() {
   do {
+    // Error recovery may have consumed the start of a deferred declaration;
+    // such a declaration is only parsed on demand.
+    while (!DeferredDecls.empty() &&
+           DeferredDecls.front().Begin.getRawEncoding() < Tok.Location)
+      DeferredDecls = DeferredDecls.slice(1);
+
+    if (!DeferredDecls.empty() &&
+        Tok.getLocation() == DeferredDecls.front().Begin) {
+      // Skip this declaration; the module map will parse it on demand.
+      SourceLocation End = DeferredDecls.front().End;
+      DeferredDecls = DeferredDecls.slice(1);
+      while (Tok.getLocation() != End && !Tok.is(MMToken::EndOfFile))
+        consumeToken();
+      consumeToken();
+      continue;
+    }
+
     switch (Tok.Kind) {
     case MMToken::EndOfFile:
       return HadError;
@@ -2256,6 +2321,132 @@ bool ModuleMapParser::parseModuleMapFile() {
   } while (true);
 }
 
+/// \brief Scan the tokens of a module map file for top-level module
+/// declarations whose bodies can be skipped and parsed on demand.
+///
+/// A declaration qualifies if it is a plain 'module' or 'framework module'
+/// with a simple name and a body, and its body names no umbrella header or
+/// directory, no extern module and no inferred submodules: those affect the
+/// lookup of headers that the module doesn't name. Everything else is left to
+/// be parsed eagerly.
+void ModuleMapParser::scanDeferrableModuleDecls(
+    SmallVectorImpl<DeferrableModuleDecl> &Decls) {
+  unsigned Depth = 0;
+  bool AfterExplicit = false;
+  while (!Tok.is(MMToken::EndOfFile)) {
+    if (Depth != 0 || AfterExplicit ||
+        !(Tok.is(MMToken::FrameworkKeyword) ||
+          Tok.is(MMToken::ModuleKeyword))) {
+      if (Tok.is(MMToken::LBrace))
+        ++Depth;
+      else if (Tok.is(MMToken::RBrace) && Depth != 0)
+        --Depth;
+      AfterExplicit = Tok.is(MMToken::ExplicitKeyword) ||
+                      (AfterExplicit && Tok.is(MMToken::FrameworkKeyword));
+      consumeToken();
+      continue;
+    }
+
+    DeferrableModuleDecl Decl;
+    Decl.Begin = Tok.getLocation();
+    if (Tok.is(MMToken::FrameworkKeyword))
+      consumeToken();
+    if (!Tok.is(MMToken::ModuleKeyword))
+      continue;
+    consumeToken();
+    if (!Tok.is(MMToken::Identifier))
+      continue;
+    Decl.Name = Tok.getString().str();
+    consumeToken();
+
+    // Skip the attributes.
+    while (Tok.is(MMToken::LSquare)) {
+      consumeToken();
+      skipUntil(MMToken::RSquare);
+      if (Tok.is(MMToken::RSquare))
+        consumeToken();
+    }
+    if (!Tok.is(MMToken::LBrace))
+      continue;
+    consumeToken();
+
+    bool Deferrable = true;
+    unsigned BodyDepth = 1;
+    MMToken::TokenKind Prev = MMToken::LBrace;
+    while (BodyDepth != 0 && !Tok.is(MMToken::EndOfFile)) {
+      switch (Tok.Kind) {
+      case MMToken::LBrace:
+        ++BodyDepth;
+        break;
+      case MMToken::RBrace:
+        if (--BodyDepth == 0)
+          Decl.End = Tok.getLocation();
+        break;
+      case MMToken::ExternKeyword:
+      case MMToken::UmbrellaKeyword:
+        Deferrable = false;
+        break;
+      case MMToken::Star:
+        if (Prev == MMToken::ModuleKeyword)
+          Deferrable = false;
+        break;
+      case MMToken::StringLiteral:
+        if (Prev == MMToken::HeaderKeyword)
+          Decl.HeaderNames.push_back(
+              llvm::sys::path::filename(Tok.getString()).str());
+        break;
+      default:
+        break;
+      }
+      Prev = Tok.Kind;
+      consumeToken();
+    }
+
+    if (BodyDepth == 0 && Deferrable)
+      Decls.push_back(std::move(Decl));
+  }
+}
+
+void ModuleMap::parseDeferredModule(StringRef Name) {
+  llvm::StringMap<DeferredModuleDecl>::iterator Known
+    = DeferredModules.find(Name);
+  if (Known == DeferredModules.end())
+    return;
+  DeferredModuleDecl Decl = Known->getValue();
+  DeferredModules.erase(Known);
+
+  const llvm::MemoryBuffer *Buffer = SourceMgr.getBuffer(Decl.ID);
+  Lexer L(SourceMgr.getLocForStartOfFile(Decl.ID), MMapLangOpts,
+          Buffer->getBufferStart(), Buffer->getBufferStart() + Decl.Offset,
+          Buffer->getBufferEnd());
+  ModuleMapParser Parser(L, SourceMgr, Target, Diags, *this,
+                         Decl.ModuleMapFile, Decl.Directory,
+                         BuiltinIncludeDir, Decl.IsSystem);
+  Parser.parseDeferredModuleDecl();
+}
+
+void ModuleMap::parseDeferredModulesForHeader(const FileEntry *File) {
+  if (DeferredModulesByHeader.empty())
+    return;
+
+  llvm::StringMap<SmallVector<std::string, 1> >::iterator Known
+    = DeferredModulesByHeader.find(llvm::sys::path::filename(File->getName()));
+  if (Known == DeferredModulesByHeader.end())
+    return;
+  SmallVector<std::string, 1> Names;
+  Names.swap(Known->getValue());
+  DeferredModulesByHeader.erase(Known);
+
+  for (unsigned I = 0, N = Names.size(); I != N; ++I)
+    parseDeferredModule(Names[I]);
+}
+
+void ModuleMap::parseAllDeferredModules() {
+  DeferredModulesByHeader.clear();
+  while (!DeferredModules.empty())
+    parseDeferredModule(DeferredModules.begin()->getKey());
+}
+
 bool ModuleMap::parseModuleMapFile(const FileEntry *File, bool IsSystem) {
   llvm::DenseMap<const FileEntry *, bool>::iterator Known
     = ParsedModuleMap.find(File);
@@ -2280,10 +2471,45 @@ bool ModuleMap::parseModuleMapFile(const FileEntry *File, bool IsSystem) {
     assert(Dir && "parent must exist");
   }
   
+  // When loading module maps lazily, find the module declarations whose
+  // bodies can wait until the module or one of its headers is looked up.
+  // Diagnostics are left to the parse proper.
+  SmallVector<DeferrableModuleDecl, 16> Deferred;
+  if (HeaderInfo.getHeaderSearchOpts().ModulesLazyModuleMaps) {
+    bool WasSuppressingDiagnostics = Diags.getSuppressAllDiagnostics();
+    Diags.setSuppressAllDiagnostics(true);
+    Lexer ScanL(ID, SourceMgr.getBuffer(ID), SourceMgr, MMapLangOpts);
+    ModuleMapParser Scanner(ScanL, SourceMgr, Target, Diags, *this, File, Dir,
+                            BuiltinIncludeDir, IsSystem);
+    SmallVector<DeferrableModuleDecl, 16> Candidates;
+    Scanner.scanDeferrableModuleDecls(Candidates);
+    Diags.setSuppressAllDiagnostics(WasSuppressingDiagnostics);
+
+    for (unsigned I = 0, N = Candidates.size(); I != N; ++I) {
+      DeferrableModuleDecl &Decl = Candidates[I];
+      // Parse redefinitions and the module being built eagerly, so that they
+      // are diagnosed and recorded as usual.
+      if (Modules.count(Decl.Name) || DeferredModules.count(Decl.Name) ||
+          Decl.Name == LangOpts.CurrentModule)
+        continue;
+
+      DeferredModuleDecl &Info = DeferredModules[Decl.Name];
+      Info.ModuleMapFile = File;
+      Info.Directory = Dir;
+      Info.ID = ID;
+      Info.Offset = SourceMgr.getFileOffset(Decl.Begin);
+      Info.IsSystem = IsSystem;
+      for (unsigned H = 0, HN = Decl.HeaderNames.size(); H != HN; ++H)
+        DeferredModulesByHeader[Decl.HeaderNames[H]].push_back(Decl.Name);
+      Deferred.push_back(std::move(Decl));
+    }
+  }
+
   // Parse this module map file.
   Lexer L(ID, SourceMgr.getBuffer(ID), SourceMgr, MMapLangOpts);
   ModuleMapParser Parser(L, SourceMgr, Target, Diags, *this, File, Dir,
                          BuiltinIncludeDir, IsSystem);
+  Parser.setDeferredDecls(Deferred);
   bool Result = Parser.parseModuleMapFile();
   ParsedModuleMap[File] = Result;
   return Result;
@@ -40,6 +40,8 @@ void Preprocessor::CommitBacktrackedTokens() {
 void Preprocessor::Backtrack() {
   assert(!BacktrackPositions.empty()
          && "EnableBacktrackAtThisPos was not called!");
+  ++NumBacktracks;
+  NumBacktrackedTokens += CachedLexPos - BacktrackPositions.back();
   CachedLexPos = BacktrackPositions.back();
   BacktrackPositions.pop_back();
   recomputeCurLexerKind();
@@ -60,6 +62,8 @@ void Preprocessor::CachingLex(Token &Result) {
   if (isBacktrackEnabled()) {
     // Cache the lexed token.
     EnterCachingLexMode();
+    if (CachedTokens.size() == CachedTokens.capacity())
+      ++NumCachedTokensGrowths;
     CachedTokens.push_back(Result);
     ++CachedLexPos;
     return;
@@ -86,7 +90,10 @@ void Preprocessor::EnterCachingLexMode() {
 const Token &Preprocessor::PeekAhead(unsigned N) {
   assert(CachedLexPos + N > CachedTokens.size() && "Confused caching.");
   ExitCachingLexMode();
-  for (unsigned C = CachedLexPos + N - CachedTokens.size(); C > 0; --C) {
+  unsigned NumNewTokens = CachedLexPos + N - CachedTokens.size();
+  if (CachedTokens.size() + NumNewTokens > CachedTokens.capacity())
+    ++NumCachedTokensGrowths;
+  for (unsigned C = NumNewTokens; C > 0; --C) {
     CachedTokens.push_back(Token());
     Lex(CachedTokens.back());
   }
@@ -649,6 +649,45 @@ private:
   bool save;
 };
 
+void Preprocessor::LexDirectivesOnly(Token &Result) {
+  while (1) {
+    // Only source files can be skipped over in raw mode.  Anything else, e.g.
+    // a token cache or PTH lexer, is lexed without expanding macros.
+    if (!CurLexer || CurTokenLexer || CurPTHLexer || InCachingLexMode()) {
+      LexUnexpandedToken(Result);
+      return;
+    }
+
+    // Enter raw mode to disable identifier lookup (and thus macro expansion),
+    // disabling warnings, etc.
+    CurLexer->LexingRawMode = true;
+    CurLexer->Lex(Result);
+    CurLexer->LexingRawMode = false;
+
+    if (Result.is(tok::code_completion))
+      continue;
+
+    if (Result.is(tok::eof)) {
+      // The raw lexer has consumed the buffer.  Lex the end of file for real so
+      // that an included file is popped and its includer resumed.
+      LexUnexpandedToken(Result);
+      if (Result.is(tok::eof))
+        return;
+      continue;
+    }
+
+    // If this token is not a preprocessor directive, just skip it.
+    if (Result.isNot(tok::hash) || !Result.isAtStartOfLine())
+      continue;
+
+    HandleDirective(Result);
+    if (hadModuleLoaderFatalFailure()) {
+      assert(Result.is(tok::eof) && "Preprocessor did not set tok:eof");
+      return;
+    }
+  }
+}
+
 /// HandleDirective - This callback is invoked when the lexer sees a # token
 /// at the start of a line.  This consumes the directive, modifies the
 /// lexer/preprocessor state, and advances the lexer(s) so that the next token
@@ -1644,6 +1683,11 @@ void Preprocessor::HandleIncludeDirective(SourceLocation HashLoc,
     std::max(HeaderInfo.getFileDirFlavor(File),
              SourceMgr.getFileCharacteristic(FilenameTok.getLocation()));
 
+  // If an earlier compile found this header's include guard, tell HeaderInfo
+  // about it so that it can skip the header without entering it at all.
+  if (GuardIndex && !isImport)
+    applyIncludeGuardIndex(File);
+
   // Ask HeaderInfo if we should enter this #include file.  If not, #including
   // this file will have no effect.
   if (!HeaderInfo.ShouldEnterIncludeFile(File, isImport)) {
@@ -1684,6 +1728,19 @@ void Preprocessor::HandleIncludeDirective(SourceLocation HashLoc,
   }
 }
 
+/// applyIncludeGuardIndex - If the include guard index knows the controlling
+/// macro of a file we have not seen yet in this translation unit, record it
+/// with HeaderInfo as if we had lexed the file.
+void Preprocessor::applyIncludeGuardIndex(const FileEntry *File) {
+  const HeaderFileInfo &HFI = HeaderInfo.getFileInfo(File);
+  if (HFI.NumIncludes || HFI.ControllingMacro || HFI.ControllingMacroID)
+    return;
+
+  StringRef Macro = GuardIndex->lookup(File);
+  if (!Macro.empty())
+    HeaderInfo.SetFileControllingMacro(File, getIdentifierInfo(Macro));
+}
+
 /// HandleIncludeNextDirective - Implements \#include_next.
 ///
 void Preprocessor::HandleIncludeNextDirective(SourceLocation HashLoc,
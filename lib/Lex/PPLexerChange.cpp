@@ -162,6 +162,7 @@ void Preprocessor::EnterMacro(Token &Tok, SourceLocation ILEnd,
                               MacroInfo *Macro, MacroArgs *Args) {
   TokenLexer *TokLexer;
   if (NumCachedTokenLexers == 0) {
+    ++NumTokenLexersAllocated;
     TokLexer = new TokenLexer(Tok, ILEnd, Macro, Args, *this);
   } else {
     TokLexer = TokenLexerCache[--NumCachedTokenLexers];
@@ -193,6 +194,7 @@ void Preprocessor::EnterTokenStream(const Token *Toks, unsigned NumToks,
   // Create a macro expander to expand from the specified token stream.
   TokenLexer *TokLexer;
   if (NumCachedTokenLexers == 0) {
+    ++NumTokenLexersAllocated;
     TokLexer = new TokenLexer(Toks, NumToks, DisableMacroExpansion,
                               OwnsTokens, *this);
   } else {
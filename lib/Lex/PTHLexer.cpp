@@ -609,25 +609,46 @@ PTHLexer *PTHManager::CreateLexer(FileID FID) {
 
   using namespace llvm::support;
 
-  // Lookup the FileEntry object in our file lookup data structure.  It will
-  // return a variant that indicates whether or not there is an offset within
-  // the PTH file that contains cached tokens.
-  PTHFileLookup& PFL = *((PTHFileLookup*)FileLookup);
-  PTHFileLookup::iterator I = PFL.find(FE);
+  std::pair<const unsigned char*, const unsigned char*> &Cached =
+    FileDataCache[FE];
+  if (!Cached.first && !Cached.second) {
+    // Lookup the FileEntry object in our file lookup data structure.  It will
+    // return a variant that indicates whether or not there is an offset within
+    // the PTH file that contains cached tokens.
+    PTHFileLookup& PFL = *((PTHFileLookup*)FileLookup);
+    PTHFileLookup::iterator I = PFL.find(FE);
+
+    if (I == PFL.end()) {
+      // Remember that this file has no tokens so the next lookup is cheap.
+      // The pp-conditional slot is set to a non-null sentinel to mark the
+      // entry as filled in.
+      Cached.second = (const unsigned char *)Buf->getBufferStart();
+      return nullptr;
+    }
 
-  if (I == PFL.end()) // No tokens available?
-    return nullptr;
+    const PTHFileData& FileData = *I;
+
+    const unsigned char *BufStart =
+      (const unsigned char *)Buf->getBufferStart();
+    // Compute the offset of the token data within the buffer.
+    const unsigned char* data = BufStart + FileData.getTokenOffset();
 
-  const PTHFileData& FileData = *I;
+    // Get the location of pp-conditional table.
+    const unsigned char* ppcond = BufStart + FileData.getPPCondOffset();
+    uint32_t Len = endian::readNext<uint32_t, little, aligned>(ppcond);
+    if (Len == 0) ppcond = nullptr;
 
-  const unsigned char *BufStart = (const unsigned char *)Buf->getBufferStart();
-  // Compute the offset of the token data within the buffer.
-  const unsigned char* data = BufStart + FileData.getTokenOffset();
+    Cached.first = data;
+    Cached.second = ppcond ? ppcond : BufStart;
+  }
+
+  if (!Cached.first) // No tokens available?
+    return nullptr;
 
-  // Get the location of pp-conditional table.
-  const unsigned char* ppcond = BufStart + FileData.getPPCondOffset();
-  uint32_t Len = endian::readNext<uint32_t, little, aligned>(ppcond);
-  if (Len == 0) ppcond = nullptr;
+  const unsigned char *data = Cached.first;
+  const unsigned char *ppcond = Cached.second;
+  if (ppcond == (const unsigned char *)Buf->getBufferStart())
+    ppcond = nullptr;
 
   assert(PP && "No preprocessor set yet!");
   return new PTHLexer(*PP, FID, data, ppcond, *this);
@@ -684,7 +705,7 @@ public:
 
       uint64_t File = endian::readNext<uint64_t, little, unaligned>(d);
       uint64_t Device = endian::readNext<uint64_t, little, unaligned>(d);
-      llvm::sys::fs::UniqueID UniqueID(File, Device);
+      llvm::sys::fs::UniqueID UniqueID(Device, File);
       time_t ModTime = endian::readNext<uint64_t, little, unaligned>(d);
       uint64_t Size = endian::readNext<uint64_t, little, unaligned>(d);
       return data_type(Size, ModTime, UniqueID, IsDirectory);
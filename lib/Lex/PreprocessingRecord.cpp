@@ -40,7 +40,7 @@ InclusionDirective::InclusionDirective(PreprocessingRecord &PPRec,
 
 PreprocessingRecord::PreprocessingRecord(SourceManager &SM)
   : SourceMgr(SM),
-    ExternalSource(nullptr) {
+    ExternalSource(nullptr), RecordMacroExpansions(true) {
 }
 
 /// \brief Returns a pair of [Begin, End) iterators of preprocessed entities
@@ -369,6 +369,9 @@ MacroDefinition *PreprocessingRecord::findMacroDefinition(const MacroInfo *MI) {
 void PreprocessingRecord::addMacroExpansion(const Token &Id,
                                             const MacroInfo *MI,
                                             SourceRange Range) {
+  if (!RecordMacroExpansions)
+    return;
+
   // We don't record nested macro expansions.
   if (Id.getLocation().isMacroID())
     return;
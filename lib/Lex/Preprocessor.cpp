@@ -84,6 +84,9 @@ Preprocessor::Preprocessor(IntrusiveRefCntPtr<PreprocessorOptions> PPOpts,
   NumFastMacroExpanded = NumTokenPaste = NumFastTokenPaste = 0;
   MaxIncludeStackDepth = 0;
   NumSkipped = 0;
+  NumTokenLexersAllocated = NumMacroArgsAllocated = 0;
+  NumCachedTokensGrowths = 0;
+  NumBacktracks = NumBacktrackedTokens = 0;
   
   // Default to discarding comments.
   KeepComments = false;
@@ -248,12 +251,20 @@ void Preprocessor::PrintStats() {
   llvm::errs() << (NumFastTokenPaste+NumTokenPaste)
              << " token paste (##) operations performed, "
              << NumFastTokenPaste << " on the fast path.\n";
+  llvm::errs() << NumTokenLexersAllocated << " token lexers and "
+             << NumMacroArgsAllocated
+             << " macro argument lists allocated outside the caches, "
+             << NumCachedTokensGrowths << " cached token buffer growths.\n";
+  llvm::errs() << NumBacktracks << " backtracks re-lexing "
+             << NumBacktrackedTokens << " cached tokens.\n";
 
   llvm::errs() << "\nPreprocessor Memory: " << getTotalMemory() << "B total";
 
   llvm::errs() << "\n  BumpPtr: " << BP.getTotalMemory();
   llvm::errs() << "\n  Macro Expanded Tokens: "
                << llvm::capacity_in_bytes(MacroExpandedTokens);
+  llvm::errs() << "\n  Cached Tokens: "
+               << llvm::capacity_in_bytes(CachedTokens);
   llvm::errs() << "\n  Predefines Buffer: " << Predefines.capacity();
   llvm::errs() << "\n  Macros: " << llvm::capacity_in_bytes(Macros);
   llvm::errs() << "\n  #pragma push_macro Info: "
@@ -498,6 +509,30 @@ void Preprocessor::EndSourceFile() {
   // Notify the client that we reached the end of the source file.
   if (Callbacks)
     Callbacks->EndOfMainFile();
+
+  if (GuardIndex)
+    updateIncludeGuardIndex();
+}
+
+/// \brief Record the include guards discovered in this translation unit in
+/// the include guard index, and write it out if anything changed.
+void Preprocessor::updateIncludeGuardIndex() {
+  SmallVector<const FileEntry *, 64> Files;
+  FileMgr.GetUniqueIDMapping(Files);
+  for (unsigned I = 0, N = std::min<size_t>(Files.size(),
+                                            HeaderInfo.header_file_size());
+       I != N; ++I) {
+    if (!Files[I])
+      continue;
+    const HeaderFileInfo &HFI = HeaderInfo.getFileInfo(Files[I]);
+    if (HFI.ControllingMacro)
+      GuardIndex->record(Files[I], HFI.ControllingMacro->getName());
+  }
+
+  std::string ErrorStr;
+  if (GuardIndex->save(ErrorStr))
+    Diag(SourceLocation(), diag::warn_pp_include_guard_index_write)
+      << GuardIndex->getIndexPath() << ErrorStr;
 }
 
 //===----------------------------------------------------------------------===//
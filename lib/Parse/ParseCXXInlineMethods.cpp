@@ -375,6 +375,15 @@ void Parser::ParseLexedMethodDeclaration(LateParsedMethodDeclaration &LM) {
 /// ParseLexedMethodDefs - We finished parsing the member specification of a top
 /// (non-nested) C++ class. Now go over the stack of lexed methods that were
 /// collected during its parsing and parse them all.
+///
+/// FIXME: The bodies are parsed one after another even though none of them
+/// can see the others' local declarations. Parsing them concurrently is not
+/// possible today: the Parser, Preprocessor, Sema and ASTContext are not
+/// thread-safe, and parsing a body can have side effects visible to the rest
+/// of the translation unit, such as template instantiation, implicit member
+/// definition and diagnostics ordering. Any worker-thread scheme would first
+/// need Sema state to be split per function and a deterministic merge of the
+/// instantiations that each body requests.
 void Parser::ParseLexedMethodDefs(ParsingClass &Class) {
   bool HasTemplateScope = !Class.TopLevelClass && Class.TemplateScope;
   ParseScope ClassTemplateScope(this, Scope::TemplateParamScope, HasTemplateScope);
@@ -1859,10 +1859,18 @@ Decl *Parser::ParseFunctionStatementBody(Decl *Decl, ParseScope &BodyScope) {
   assert(Tok.is(tok::l_brace));
   SourceLocation LBraceLoc = Tok.getLocation();
 
-  if (SkipFunctionBodies && (!Decl || Actions.canSkipFunctionBody(Decl)) &&
-      trySkippingFunctionBody()) {
-    BodyScope.Exit();
-    return Actions.ActOnSkippedFunctionBody(Decl);
+  if (SkipFunctionBodies && (!Decl || Actions.canSkipFunctionBody(Decl))) {
+    // Keep the tokens around if Sema may want to parse the body later.
+    CachedTokens Toks;
+    bool RetainTokens = Decl && Actions.RetainSkippedFunctionBodies &&
+                        !PP.isCodeCompletionEnabled();
+    if (trySkippingFunctionBody(RetainTokens ? &Toks : nullptr)) {
+      BodyScope.Exit();
+      Decl = Actions.ActOnSkippedFunctionBody(Decl);
+      if (RetainTokens)
+        Actions.MarkAsSkippedFunctionBody(Decl, Toks);
+      return Decl;
+    }
   }
 
   PrettyDeclStackTraceEntry CrashInfo(Actions, Decl, LBraceLoc,
@@ -1920,12 +1928,18 @@ Decl *Parser::ParseFunctionTryBlock(Decl *Decl, ParseScope &BodyScope) {
   return Actions.ActOnFinishFunctionBody(Decl, FnBody.get());
 }
 
-bool Parser::trySkippingFunctionBody() {
+bool Parser::trySkippingFunctionBody(CachedTokens *Toks) {
   assert(Tok.is(tok::l_brace));
   assert(SkipFunctionBodies &&
          "Should only be called when SkipFunctionBodies is enabled");
 
   if (!PP.isCodeCompletionEnabled()) {
+    if (Toks) {
+      Toks->push_back(Tok);
+      ConsumeBrace();
+      ConsumeAndStoreUntil(tok::r_brace, *Toks, /*StopAtSemi=*/false);
+      return true;
+    }
     ConsumeBrace();
     SkipUntil(tok::r_brace);
     return true;
@@ -1944,6 +1958,72 @@ bool Parser::trySkippingFunctionBody() {
   return false;
 }
 
+void Parser::SkippedBodyParserCallback(void *P, LateParsedTemplate &LPT) {
+  ((Parser *)P)->ParseSkippedFunctionBody(LPT);
+}
+
+/// \brief Parse a function body that was skipped earlier and whose tokens
+/// were retained by Sema.
+void Parser::ParseSkippedFunctionBody(LateParsedTemplate &LPT) {
+  if (!LPT.D)
+    return;
+
+  FunctionDecl *FunD = LPT.D->getAsFunction();
+
+  // To restore the context after parsing.
+  Sema::ContextRAII GlobalSavedContext(Actions, Actions.CurContext);
+
+  // Get the list of DeclContexts to reenter.
+  SmallVector<DeclContext*, 4> DeclContextsToReenter;
+  DeclContext *DD = FunD->getLexicalParent();
+  while (DD && !DD->isTranslationUnit()) {
+    DeclContextsToReenter.push_back(DD);
+    DD = DD->getLexicalParent();
+  }
+
+  // Reenter the enclosing scopes from outermost to innermost.
+  SmallVector<ParseScope*, 4> ScopeStack;
+  for (SmallVectorImpl<DeclContext *>::reverse_iterator
+         I = DeclContextsToReenter.rbegin(), E = DeclContextsToReenter.rend();
+       I != E; ++I) {
+    ScopeStack.push_back(new ParseScope(this, Scope::DeclScope));
+    Actions.PushDeclContext(Actions.getCurScope(), *I);
+  }
+
+  assert(!LPT.Toks.empty() && "Empty body!");
+
+  // Append the current token at the end of the new token stream so that it
+  // doesn't get lost.
+  LPT.Toks.push_back(Tok);
+  PP.EnterTokenStream(LPT.Toks.data(), LPT.Toks.size(), true, false);
+
+  // Consume the previously pushed token.
+  ConsumeAnyToken(/*ConsumeCodeCompletionTok=*/true);
+  assert(Tok.is(tok::l_brace) && "Skipped body not starting with '{'");
+
+  ParseScope FnScope(this, Scope::FnScope|Scope::DeclScope);
+
+  // Recreate the containing function DeclContext.
+  Sema::ContextRAII FunctionSavedContext(Actions, Actions.getContainingDC(FunD));
+
+  // The body is about to become real; the definition must not look like a
+  // redefinition of the skipped one.
+  FunD->setHasSkippedBody(false);
+  Actions.ActOnStartOfFunctionDef(getCurScope(), FunD);
+
+  {
+    SaveAndRestore<bool> ParseBodies(SkipFunctionBodies, false);
+    ParseFunctionStatementBody(LPT.D, FnScope);
+  }
+
+  // Exit scopes.
+  FnScope.Exit();
+  for (SmallVectorImpl<ParseScope *>::reverse_iterator I = ScopeStack.rbegin(),
+                                                       E = ScopeStack.rend();
+       I != E; ++I)
+    delete *I;
+}
+
 /// ParseCXXTryBlock - Parse a C++ try-block.
 ///
 ///       try-block:
@@ -1566,6 +1566,20 @@ bool Parser::isCXXFunctionDeclarator(bool *IsAmbiguous) {
   // ambiguities mentioned in 6.8, the resolution is to consider any construct
   // that could possibly be a declaration a declaration.
 
+  // Within a tentative parse, reuse the answer for a declarator we have
+  // already looked at. Callers that want to know about ambiguity are not
+  // tentatively parsing and always take the slow path.
+  std::pair<unsigned, unsigned> CacheKey(
+      Tok.getLocation().getRawEncoding(),
+      TentativelyDeclaredIdentifiers.size());
+  bool UseCache = !IsAmbiguous && PP.isBacktrackEnabled();
+  if (UseCache) {
+    llvm::SmallDenseMap<std::pair<unsigned, unsigned>, bool, 4>::iterator
+        Known = TentativeFunctionDeclarators.find(CacheKey);
+    if (Known != TentativeFunctionDeclarators.end())
+      return Known->second;
+  }
+
   TentativeParsingAction PA(*this);
 
   ConsumeParen();
@@ -1597,6 +1611,9 @@ bool Parser::isCXXFunctionDeclarator(bool *IsAmbiguous) {
   if (IsAmbiguous && TPR == TPResult::Ambiguous)
     *IsAmbiguous = true;
 
+  if (UseCache)
+    TentativeFunctionDeclarators[CacheKey] = TPR != TPResult::False;
+
   // In case of an error, let the declaration parsing code handle it.
   return TPR != TPResult::False;
 }
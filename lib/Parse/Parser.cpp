@@ -20,9 +20,15 @@
 #include "clang/Sema/DeclSpec.h"
 #include "clang/Sema/ParsedTemplate.h"
 #include "clang/Sema/Scope.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 using namespace clang;
 
+#define DEBUG_TYPE "parser"
+
+STATISTIC(NumScopesAllocated, "Number of parser scopes allocated");
+STATISTIC(NumScopesReused, "Number of parser scopes reused from the cache");
+
 
 namespace {
 /// \brief A comment handler that passes comments found by the preprocessor
@@ -351,10 +357,12 @@ bool Parser::SkipUntil(ArrayRef<tok::TokenKind> Toks, SkipUntilFlags Flags) {
 /// EnterScope - Start a new scope.
 void Parser::EnterScope(unsigned ScopeFlags) {
   if (NumCachedScopes) {
+    ++NumScopesReused;
     Scope *N = ScopeCache[--NumCachedScopes];
     N->Init(getCurScope(), ScopeFlags);
     Actions.CurScope = N;
   } else {
+    ++NumScopesAllocated;
     Actions.CurScope = new Scope(getCurScope(), ScopeFlags, Diags);
   }
 }
@@ -414,6 +422,8 @@ Parser::~Parser() {
 
   PP.clearCodeCompletionHandler();
 
+  Actions.SetSkippedBodyParser(nullptr, nullptr);
+
   assert(TemplateIds.empty() && "Still alive TemplateIdAnnotations around?");
 }
 
@@ -425,6 +435,10 @@ void Parser::Initialize() {
   EnterScope(Scope::DeclScope);
   Actions.ActOnTranslationUnitScope(getCurScope());
 
+  // Skipped function bodies can be parsed on demand for as long as we live.
+  if (SkipFunctionBodies)
+    Actions.SetSkippedBodyParser(SkippedBodyParserCallback, this);
+
   // Initialization for Objective-C context sensitive keywords recognition.
   // Referenced in Parser::ParseObjCTypeQualifierList.
   if (getLangOpts().ObjC1) {
@@ -66,27 +66,38 @@ void RewriteBuffer::RemoveText(unsigned OrigOffset, unsigned Size,
 
   if (removeLineIfEmpty) {
     // Find the line that the remove occurred and if it is completely empty
-    // remove the line as well.
+    // remove the line as well.  Walk the rope a piece at a time rather than a
+    // character at a time, since this is done for every removal.
 
-    iterator curLineStart = begin();
     unsigned curLineStartOffs = 0;
-    iterator posI = begin();
-    for (unsigned i = 0; i != RealOffset; ++i) {
-      if (*posI == '\n') {
-        curLineStart = posI;
-        ++curLineStart;
-        curLineStartOffs = i + 1;
-      }
-      ++posI;
+    unsigned PieceOffs = 0;
+    for (iterator I = begin(), E = end(); I != E && PieceOffs < RealOffset;
+         I.MoveToNextPiece()) {
+      StringRef Piece = I.piece();
+      size_t NewLinePos = Piece.substr(0, RealOffset - PieceOffs).rfind('\n');
+      if (NewLinePos != StringRef::npos)
+        curLineStartOffs = PieceOffs + NewLinePos + 1;
+      PieceOffs += Piece.size();
     }
-  
-    unsigned lineSize = 0;
-    posI = curLineStart;
-    while (posI != end() && isWhitespace(*posI)) {
-      ++posI;
-      ++lineSize;
+
+    unsigned Pos = curLineStartOffs;
+    bool FoundNewLine = false;
+    PieceOffs = 0;
+    for (iterator I = begin(), E = end(); I != E; I.MoveToNextPiece()) {
+      StringRef Piece = I.piece();
+      unsigned PieceEnd = PieceOffs + Piece.size();
+      for (; Pos < PieceEnd; ++Pos)
+        if (!isWhitespace(Piece[Pos - PieceOffs]))
+          break;
+      if (Pos < PieceEnd) {
+        FoundNewLine = Piece[Pos - PieceOffs] == '\n';
+        break;
+      }
+      PieceOffs = PieceEnd;
     }
-    if (posI != end() && *posI == '\n') {
+
+    unsigned lineSize = Pos - curLineStartOffs;
+    if (FoundNewLine) {
       Buffer.erase(curLineStartOffs, lineSize + 1/* + '\n'*/);
       AddReplaceDelta(curLineStartOffs, -(lineSize + 1/* + '\n'*/));
     }
@@ -26,10 +26,20 @@
 #include "clang/Sema/SemaDiagnostic.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/ErrorHandling.h"
 #include <cstring>
 using namespace clang;
 
+#define DEBUG_TYPE "declspec"
+
+STATISTIC(NumInlineParamLists,
+          "Number of function declarator parameter lists stored inline");
+STATISTIC(NumHeapParamLists,
+          "Number of function declarator parameter lists allocated");
+STATISTIC(NumHeapExceptionLists,
+          "Number of function declarator exception lists allocated");
+
 
 static DiagnosticBuilder Diag(DiagnosticsEngine &D, SourceLocation Loc,
                               unsigned DiagID) {
@@ -211,10 +221,12 @@ DeclaratorChunk DeclaratorChunk::getFunction(bool hasProto,
     // small (function with too many parameters), go to the heap.
     if (!TheDeclarator.InlineParamsUsed &&
         NumParams <= llvm::array_lengthof(TheDeclarator.InlineParams)) {
+      ++NumInlineParamLists;
       I.Fun.Params = TheDeclarator.InlineParams;
       I.Fun.DeleteParams = false;
       TheDeclarator.InlineParamsUsed = true;
     } else {
+      ++NumHeapParamLists;
       I.Fun.Params = new DeclaratorChunk::ParamInfo[NumParams];
       I.Fun.DeleteParams = true;
     }
@@ -227,6 +239,7 @@ DeclaratorChunk DeclaratorChunk::getFunction(bool hasProto,
   case EST_Dynamic:
     // new[] an exception array if needed
     if (NumExceptions) {
+      ++NumHeapExceptionLists;
       I.Fun.NumExceptions = NumExceptions;
       I.Fun.Exceptions = new DeclaratorChunk::TypeAndRange[NumExceptions];
       for (unsigned i = 0; i != NumExceptions; ++i) {
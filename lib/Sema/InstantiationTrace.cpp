@@ -0,0 +1,88 @@
+//===--- InstantiationTrace.cpp - Template instantiation profiling --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the InstantiationTrace class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Sema/InstantiationTrace.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+using namespace clang;
+
+InstantiationTrace::InstantiationTrace(ASTContext &Context, raw_ostream *OS)
+  : Context(Context), OS(OS), TraceStart(0) {
+  TraceStart = now();
+}
+
+InstantiationTrace::~InstantiationTrace() {
+  if (OS) {
+    write(*OS);
+    delete OS;
+  }
+}
+
+double InstantiationTrace::now() const {
+  return llvm::TimeRecord::getCurrentTime(/*Start=*/true).getWallTime();
+}
+
+void InstantiationTrace::begin(StringRef Name, const Decl *Entity) {
+  Event E;
+  E.Name = Name;
+  if (const NamedDecl *ND = dyn_cast_or_null<NamedDecl>(Entity)) {
+    llvm::raw_string_ostream Detail(E.Detail);
+    ND->getNameForDiagnostic(Detail, Context.getPrintingPolicy(),
+                             /*Qualified=*/true);
+  }
+  E.Start = now();
+  E.Duration = 0;
+  E.StartBytes = Context.getASTAllocatedMemory();
+  E.Bytes = 0;
+  Open.push_back(E);
+}
+
+void InstantiationTrace::end() {
+  assert(!Open.empty() && "no open instantiation event");
+  Event E = Open.pop_back_val();
+  E.Duration = now() - E.Start;
+  E.Bytes = Context.getASTAllocatedMemory() - E.StartBytes;
+  Events.push_back(E);
+}
+
+static void writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (unsigned I = 0, N = Str.size(); I != N; ++I) {
+    unsigned char C = Str[I];
+    if (C == '"' || C == '\\')
+      OS << '\\' << C;
+    else if (C < 0x20)
+      OS << "\\u" << llvm::format("%04x", C);
+    else
+      OS << C;
+  }
+  OS << '"';
+}
+
+void InstantiationTrace::write(raw_ostream &OS) const {
+  OS << "{\"traceEvents\": [";
+  for (unsigned I = 0, N = Events.size(); I != N; ++I) {
+    const Event &E = Events[I];
+    OS << (I ? ",\n" : "\n") << "{\"pid\": 1, \"tid\": 0, \"ph\": \"X\", "
+       << "\"ts\": " << uint64_t((E.Start - TraceStart) * 1e6) << ", "
+       << "\"dur\": " << uint64_t(E.Duration * 1e6) << ", \"name\": ";
+    writeJSONString(OS, E.Name);
+    OS << ", \"args\": {\"detail\": ";
+    writeJSONString(OS, E.Detail);
+    OS << ", \"ast-bytes\": " << uint64_t(E.Bytes) << "}}";
+  }
+  OS << "\n]}\n";
+}
@@ -30,6 +30,7 @@
 #include "clang/Sema/CXXFieldCollector.h"
 #include "clang/Sema/DelayedDiagnostic.h"
 #include "clang/Sema/ExternalSemaSource.h"
+#include "clang/Sema/InstantiationTrace.h"
 #include "clang/Sema/MultiplexExternalSemaSource.h"
 #include "clang/Sema/ObjCMethodList.h"
 #include "clang/Sema/PrettyDeclStackTrace.h"
@@ -90,7 +91,9 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
     CodeSegStack(nullptr), CurInitSeg(nullptr), VisContext(nullptr),
     IsBuildingRecoveryCallExpr(false),
     ExprNeedsCleanups(false), LateTemplateParser(nullptr),
-    OpaqueParser(nullptr), IdResolver(pp), StdInitializerList(nullptr),
+    OpaqueParser(nullptr), RetainSkippedFunctionBodies(false),
+    SkippedBodyParser(nullptr), OpaqueSkippedBodyParser(nullptr),
+    IdResolver(pp), StdInitializerList(nullptr),
     CXXTypeInfoDecl(nullptr), MSVCGuidDecl(nullptr),
     NSNumberDecl(nullptr),
     NSStringDecl(nullptr), StringWithUTF8StringMethod(nullptr),
@@ -98,7 +101,9 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
     NSDictionaryDecl(nullptr), DictionaryWithObjectsMethod(nullptr),
     GlobalNewDeleteDeclared(false),
     TUKind(TUKind),
-    NumSFINAEErrors(0),
+    NumSFINAEErrors(0), NumStandardConversionCacheHits(0),
+    NumStandardConversionCacheMisses(0), SkipVTableDefinitions(false),
+    NumVTablesDefined(0), NumVTablesExternal(0), NumVTablesSkipped(0),
     AccessCheckingSFINAE(false), InNonInstantiationSFINAEContext(false),
     NonInstantiationEntries(0), ArgumentPackSubstitutionIndex(-1),
     CurrentInstantiationScope(nullptr), DisableTypoCorrection(false),
@@ -218,6 +223,7 @@ void Sema::Initialize() {
 
 Sema::~Sema() {
   llvm::DeleteContainerSeconds(LateParsedTemplateMap);
+  llvm::DeleteContainerSeconds(SkippedFunctionBodies);
   if (PackContext) FreePackedContext();
   if (VisContext) FreeVisContext();
   // Kill all the active scopes.
@@ -297,6 +303,13 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumStandardConversionCacheHits << "/"
+               << (NumStandardConversionCacheHits +
+                   NumStandardConversionCacheMisses)
+               << " arithmetic conversion lookups found in the cache.\n";
+  llvm::errs() << NumVTablesDefined << " vtables defined, "
+               << NumVTablesExternal << " left to other translation units, "
+               << NumVTablesSkipped << " skipped.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -663,6 +676,13 @@ void Sema::ActOnEndOfTranslationUnit() {
       UnusedFileScopedDecls.end());
 
   if (TUKind == TU_Prefix) {
+    // Instantiating here lets every user of the PCH deserialize the
+    // instantiated definitions instead of substituting them again. Names
+    // declared after the PCH are then not visible to these instantiations,
+    // which is why this is opt-in.
+    if (LangOpts.PCHInstantiateTemplates)
+      PerformPendingInstantiations();
+
     // Translation unit prefixes don't need any of the checking below.
     TUScope = nullptr;
     return;
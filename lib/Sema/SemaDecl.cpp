@@ -10076,6 +10076,43 @@ Decl *Sema::ActOnSkippedFunctionBody(Decl *Decl) {
   return ActOnFinishFunctionBody(Decl, nullptr);
 }
 
+void Sema::MarkAsSkippedFunctionBody(Decl *D, CachedTokens &Toks) {
+  if (!RetainSkippedFunctionBodies || !D)
+    return;
+
+  // Templates are instantiated from their pattern, so a body parsed later
+  // would not reach the instantiations that were already formed.
+  FunctionDecl *FD = dyn_cast<FunctionDecl>(D);
+  if (!FD || FD->isDependentContext() || !FD->hasSkippedBody())
+    return;
+
+  LateParsedTemplate *&LPT = SkippedFunctionBodies[FD];
+  if (!LPT)
+    LPT = new LateParsedTemplate;
+
+  // Take tokens to avoid allocations
+  LPT->Toks.swap(Toks);
+  LPT->D = FD;
+}
+
+bool Sema::ParseSkippedFunctionBody(FunctionDecl *FD) {
+  if (!SkippedBodyParser || !FD)
+    return false;
+
+  for (auto *Redecl : FD->redecls()) {
+    LateParsedTemplate *LPT = SkippedFunctionBodies.lookup(Redecl);
+    if (!LPT || !LPT->D)
+      continue;
+
+    SkippedBodyParser(OpaqueSkippedBodyParser, *LPT);
+    // The token stream may still be referenced by the lexer, so keep the
+    // tokens alive and only mark the entry as parsed.
+    LPT->D = nullptr;
+    return Redecl->hasBody();
+  }
+  return false;
+}
+
 Decl *Sema::ActOnFinishFunctionBody(Decl *D, Stmt *BodyArg) {
   return ActOnFinishFunctionBody(D, BodyArg, false);
 }
@@ -1203,6 +1203,16 @@ static void handleNonNullAttrParameter(Sema &S, ParmVarDecl *D,
                          Attr.getAttributeSpellingListIndex()));
 }
 
+static void handleNoEscapeAttr(Sema &S, Decl *D, const AttributeList &Attr) {
+  ParmVarDecl *PVD = cast<ParmVarDecl>(D);
+  if (!attrNonNullArgCheck(S, PVD->getType(), Attr, PVD->getSourceRange()))
+    return;
+
+  D->addAttr(::new (S.Context)
+             NoEscapeAttr(Attr.getRange(), S.Context,
+                          Attr.getAttributeSpellingListIndex()));
+}
+
 static void handleReturnsNonNullAttr(Sema &S, Decl *D,
                                      const AttributeList &Attr) {
   QualType ResultType = getFunctionOrMethodResultType(D);
@@ -1444,6 +1454,58 @@ static void handleMallocAttr(Sema &S, Decl *D, const AttributeList &Attr) {
   S.Diag(Attr.getLoc(), diag::warn_attribute_malloc_pointer_only);
 }
 
+/// \brief Check that argument \p AttrArgNum of an alloc_size attribute names
+/// an integer parameter of \p D, and return its 1-based index (not counting
+/// an implicit 'this') in \p ParamIdx.
+static bool checkAllocSizeParamIndex(Sema &S, const Decl *D,
+                                     const AttributeList &Attr,
+                                     unsigned AttrArgNum, unsigned &ParamIdx) {
+  const Expr *IdxExpr = Attr.getArgAsExpr(AttrArgNum - 1);
+  uint64_t Idx;
+  if (!checkFunctionOrMethodParameterIndex(S, D, Attr, AttrArgNum, IdxExpr,
+                                           Idx))
+    return false;
+
+  QualType ParamTy = getFunctionOrMethodParamType(D, Idx);
+  if (!ParamTy->isDependentType() && !ParamTy->isIntegerType()) {
+    S.Diag(IdxExpr->getLocStart(), diag::err_attribute_integers_only)
+      << Attr.getName() << IdxExpr->getSourceRange();
+    return false;
+  }
+
+  ParamIdx = Idx + 1;
+  return true;
+}
+
+static void handleAllocSizeAttr(Sema &S, Decl *D, const AttributeList &Attr) {
+  if (!hasFunctionProto(D)) {
+    S.Diag(Attr.getLoc(), diag::err_attribute_wrong_decl_type)
+      << Attr.getName() << ExpectedFunction;
+    return;
+  }
+
+  QualType RetTy = getFunctionOrMethodResultType(D);
+  if (!RetTy->isDependentType() && !RetTy->isPointerType()) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_return_pointers_only)
+      << Attr.getName() << Attr.getRange();
+    return;
+  }
+
+  unsigned ElemSizeParam;
+  if (!checkAllocSizeParamIndex(S, D, Attr, 1, ElemSizeParam))
+    return;
+
+  unsigned NumElemsParam = 0;
+  if (Attr.getNumArgs() > 1 &&
+      !checkAllocSizeParamIndex(S, D, Attr, 2, NumElemsParam))
+    return;
+
+  D->addAttr(::new (S.Context)
+             AllocSizeAttr(Attr.getRange(), S.Context, ElemSizeParam,
+                           NumElemsParam,
+                           Attr.getAttributeSpellingListIndex()));
+}
+
 static void handleCommonAttr(Sema &S, Decl *D, const AttributeList &Attr) {
   if (S.LangOpts.CPlusPlus) {
     S.Diag(Attr.getLoc(), diag::err_attribute_not_supported_in_lang)
@@ -4184,6 +4246,9 @@ static void ProcessDeclAttribute(Sema &S, Scope *scope, Decl *D,
   case AttributeList::AT_Malloc:
     handleMallocAttr(S, D, Attr);
     break;
+  case AttributeList::AT_AllocSize:
+    handleAllocSizeAttr(S, D, Attr);
+    break;
   case AttributeList::AT_MayAlias:
     handleSimpleAttribute<MayAliasAttr>(S, D, Attr);
     break;
@@ -4205,6 +4270,9 @@ static void ProcessDeclAttribute(Sema &S, Scope *scope, Decl *D,
   case AttributeList::AT_ReturnsNonNull:
     handleReturnsNonNullAttr(S, D, Attr);
     break;
+  case AttributeList::AT_NoEscape:
+    handleNoEscapeAttr(S, D, Attr);
+    break;
   case AttributeList::AT_Overloadable:
     handleSimpleAttribute<OverloadableAttr>(S, D, Attr);
     break;
@@ -12630,6 +12630,15 @@ bool Sema::DefineUsedVTables() {
     // if we are not providing an authoritative form of the vtable in this TU.
     // We may choose to emit it available_externally anyway.
     if (!DefineVTable) {
+      ++NumVTablesExternal;
+      MarkVirtualMemberExceptionSpecsNeeded(Loc, Class);
+      continue;
+    }
+
+    // Tools that don't generate code can skip computing the final overriders
+    // and defining or instantiating every virtual member.
+    if (SkipVTableDefinitions) {
+      ++NumVTablesSkipped;
       MarkVirtualMemberExceptionSpecsNeeded(Loc, Class);
       continue;
     }
@@ -12638,6 +12647,7 @@ bool Sema::DefineUsedVTables() {
     // that we can build a vtable. Then, tell the AST consumer that a
     // vtable for this class is required.
     DefinedAnything = true;
+    ++NumVTablesDefined;
     MarkVirtualMembersReferenced(Loc, Class);
     CXXRecordDecl *Canonical = cast<CXXRecordDecl>(Class->getCanonicalDecl());
     Consumer.HandleVTable(Class, VTablesUsed[Canonical]);
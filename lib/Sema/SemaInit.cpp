@@ -204,6 +204,21 @@ static void CheckStringInit(Expr *Str, QualType &DeclT, const ArrayType *AT,
 // Semantic checking for initializer lists.
 //===----------------------------------------------------------------------===//
 
+/// Check whether \p E is a numeric literal, possibly negated, whose type is
+/// already \p T. Copy-initializing a scalar of type \p T from such an
+/// expression involves no conversion and cannot fail, so the initializer list
+/// checker can use it as-is. Generated tables are made almost entirely of
+/// these.
+static bool isLiteralOfScalarType(ASTContext &Context, Expr *E, QualType T) {
+  if (!E->isRValue() || !Context.hasSameUnqualifiedType(E->getType(), T))
+    return false;
+  if (UnaryOperator *UO = dyn_cast<UnaryOperator>(E))
+    if (UO->getOpcode() == UO_Minus || UO->getOpcode() == UO_Plus)
+      E = UO->getSubExpr();
+  return isa<IntegerLiteral>(E) || isa<FloatingLiteral>(E) ||
+         isa<CharacterLiteral>(E);
+}
+
 /// @brief Semantic checking for initializer lists.
 ///
 /// The InitListChecker class contains a set of routines that each
@@ -1108,6 +1123,14 @@ void InitListChecker::CheckScalarType(const InitializedEntity &Entity,
     return;
   }
 
+  // Fast path: a literal of exactly the right type needs no conversion.
+  if (isLiteralOfScalarType(SemaRef.Context, expr, DeclType)) {
+    if (!VerifyOnly)
+      UpdateStructuredListElement(StructuredList, StructuredIndex, expr);
+    ++Index;
+    return;
+  }
+
   if (VerifyOnly) {
     if (!SemaRef.CanPerformCopyInitialization(Entity,expr))
       hadError = true;
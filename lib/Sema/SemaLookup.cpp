@@ -1594,6 +1594,14 @@ static bool HasOnlyStaticMembers(InputIterator First, InputIterator Last) {
 /// occurs as part of unqualified name lookup.
 ///
 /// \returns true if lookup succeeded, false if it failed.
+///
+/// FIXME: Results are not cached per (context, name, lookup kind). The
+/// direct lookup is already a single StoredDeclsMap probe. What is left,
+/// walking using-directives and base classes, depends on state that a cache
+/// would have to track: module visibility, lazily declared special members,
+/// newly added using-directives anywhere in the nominated set, and external
+/// sources that add names. None of these currently bumps a generation that
+/// Sema could check.
 bool Sema::LookupQualifiedName(LookupResult &R, DeclContext *LookupCtx,
                                bool InUnqualifiedLookup) {
   assert(LookupCtx && "Sema::LookupQualifiedName requires a lookup context");
@@ -4106,6 +4114,15 @@ static void checkCorrectionVisibility(Sema &SemaRef, TypoCorrection &TC) {
   }
 }
 
+/// \brief Determine whether this translation unit has used up the number of
+/// typo corrections allowed by -fspell-checking-limit.
+static bool isTypoCorrectionLimitReached(Sema &SemaRef) {
+  unsigned Limit =
+      SemaRef.getDiagnostics().getDiagnosticOptions().SpellCheckingLimit;
+  return Limit && SemaRef.TyposCorrected +
+                      SemaRef.UnqualifiedTyposCorrected.size() >= Limit;
+}
+
 /// \brief Try to "correct" a typo in the source code by finding
 /// visible declarations whose names are similar to the name that was
 /// present in the source code.
@@ -4232,7 +4249,7 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
     // Provide a stop gap for files that are just seriously broken.  Trying
     // to correct all typos can turn into a HUGE performance penalty, causing
     // some files to take minutes to get rejected by the parser.
-    if (TyposCorrected + UnqualifiedTyposCorrected.size() >= 20)
+    if (isTypoCorrectionLimitReached(*this))
       return TypoCorrection();
     ++TyposCorrected;
 
@@ -4266,7 +4283,7 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
       // Provide a stop gap for files that are just seriously broken.  Trying
       // to correct all typos can turn into a HUGE performance penalty, causing
       // some files to take minutes to get rejected by the parser.
-      if (TyposCorrected + UnqualifiedTyposCorrected.size() >= 20)
+      if (isTypoCorrectionLimitReached(*this))
         return TypoCorrection();
     }
   }
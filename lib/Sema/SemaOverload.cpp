@@ -74,6 +74,12 @@ static bool IsStandardConversion(Sema &S, Expr* From, QualType ToType,
                                  bool CStyle,
                                  bool AllowObjCWritebackConversion);
 
+static bool IsCachedStandardConversion(Sema &S, Expr *From, QualType ToType,
+                                       bool InOverloadResolution,
+                                       StandardConversionSequence &SCS,
+                                       bool CStyle,
+                                       bool AllowObjCWritebackConversion);
+
 static bool IsTransparentUnionStandardConversion(Sema &S, Expr* From, 
                                                  QualType &ToType,
                                                  bool InOverloadResolution,
@@ -1215,8 +1221,9 @@ TryImplicitConversion(Sema &S, Expr *From, QualType ToType,
                       bool AllowObjCWritebackConversion,
                       bool AllowObjCConversionOnExplicit) {
   ImplicitConversionSequence ICS;
-  if (IsStandardConversion(S, From, ToType, InOverloadResolution,
-                           ICS.Standard, CStyle, AllowObjCWritebackConversion)){
+  if (IsCachedStandardConversion(S, From, ToType, InOverloadResolution,
+                                 ICS.Standard, CStyle,
+                                 AllowObjCWritebackConversion)) {
     ICS.setStandard();
     return ICS;
   }
@@ -1695,6 +1702,63 @@ static bool IsStandardConversion(Sema &S, Expr* From, QualType ToType,
   return true;
 }
   
+/// \brief Like IsStandardConversion, but reuse the result for conversions
+/// between builtin arithmetic types in C++.
+///
+/// Such a conversion depends only on the two types, on whether \p From is a
+/// glvalue, and on the flags; bit-fields are the one exception, since they
+/// can promote differently, and are never cached.
+static bool IsCachedStandardConversion(Sema &S, Expr *From, QualType ToType,
+                                       bool InOverloadResolution,
+                                       StandardConversionSequence &SCS,
+                                       bool CStyle,
+                                       bool AllowObjCWritebackConversion) {
+  QualType CanonFrom = S.Context.getCanonicalType(From->getType());
+  QualType CanonTo = S.Context.getCanonicalType(ToType);
+  const BuiltinType *FromBT = dyn_cast<BuiltinType>(CanonFrom);
+  const BuiltinType *ToBT = dyn_cast<BuiltinType>(CanonTo);
+  if (!S.getLangOpts().CPlusPlus || !FromBT || !ToBT ||
+      !(FromBT->isInteger() || FromBT->isFloatingPoint()) ||
+      !(ToBT->isInteger() || ToBT->isFloatingPoint()) ||
+      From->getSourceBitField())
+    return IsStandardConversion(S, From, ToType, InOverloadResolution, SCS,
+                                CStyle, AllowObjCWritebackConversion);
+
+  unsigned Flags = From->isGLValue() | (InOverloadResolution << 1) |
+                   (CStyle << 2);
+  Sema::StandardConversionKey Key(
+      std::make_pair(CanonFrom.getAsOpaquePtr(), CanonTo.getAsOpaquePtr()),
+      Flags);
+  llvm::DenseMap<Sema::StandardConversionKey,
+                 StandardConversionSequence *>::iterator Known =
+      S.StandardConversionCache.find(Key);
+  if (Known != S.StandardConversionCache.end()) {
+    ++S.NumStandardConversionCacheHits;
+    SCS = *Known->second;
+    // Keep the type sugar of this query for diagnostics.
+    SCS.setFromType(From->getType());
+    if (S.Context.hasSameType(SCS.getToType(2), ToType))
+      SCS.setToType(2, ToType);
+    return true;
+  }
+
+  ++S.NumStandardConversionCacheMisses;
+  if (!IsStandardConversion(S, From, ToType, InOverloadResolution, SCS,
+                            CStyle, AllowObjCWritebackConversion))
+    return false;
+
+  // Only store canonical types, so that the type sugar of this query can't
+  // leak into the results of later ones.
+  StandardConversionSequence *Cached =
+      S.BumpAlloc.Allocate<StandardConversionSequence>();
+  new (Cached) StandardConversionSequence(SCS);
+  Cached->setFromType(S.Context.getCanonicalType(SCS.getFromType()));
+  for (unsigned I = 0; I != 3; ++I)
+    Cached->setToType(I, S.Context.getCanonicalType(SCS.getToType(I)));
+  S.StandardConversionCache[Key] = Cached;
+  return true;
+}
+
 static bool
 IsTransparentUnionStandardConversion(Sema &S, Expr* From, 
                                      QualType &ToType,
@@ -5597,8 +5661,27 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
       return;
   }
 
-  // Add this candidate
-  OverloadCandidate &Candidate = CandidateSet.addCandidate(Args.size());
+  unsigned NumParams = Proto->getNumParams();
+
+  // (C++ 13.3.2p2): A candidate function having fewer than m
+  // parameters is viable only if it has an ellipsis in its parameter
+  // list (8.3.5).
+  bool TooManyArgs =
+      (Args.size() + (PartialOverloading && Args.size())) > NumParams &&
+      !Proto->isVariadic();
+
+  // (C++ 13.3.2p2): A candidate function having more than m parameters
+  // is viable only if the (m+1)st parameter has a default argument
+  // (8.3.6). For the purposes of overload resolution, the
+  // parameter list is truncated on the right, so that there are
+  // exactly m parameters.
+  bool TooFewArgs = !TooManyArgs && !PartialOverloading &&
+                    Args.size() < Function->getMinRequiredArguments();
+
+  // Add this candidate. A candidate that is ruled out by its arity never
+  // looks at its conversion sequences, so don't allocate any for it.
+  OverloadCandidate &Candidate = CandidateSet.addCandidate(
+      TooManyArgs || TooFewArgs ? 0 : Args.size());
   Candidate.FoundDecl = FoundDecl;
   Candidate.Function = Function;
   Candidate.Viable = true;
@@ -5606,25 +5689,13 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
   Candidate.IgnoreObjectArgument = false;
   Candidate.ExplicitCallArguments = Args.size();
 
-  unsigned NumParams = Proto->getNumParams();
-
-  // (C++ 13.3.2p2): A candidate function having fewer than m
-  // parameters is viable only if it has an ellipsis in its parameter
-  // list (8.3.5).
-  if ((Args.size() + (PartialOverloading && Args.size())) > NumParams &&
-      !Proto->isVariadic()) {
+  if (TooManyArgs) {
     Candidate.Viable = false;
     Candidate.FailureKind = ovl_fail_too_many_arguments;
     return;
   }
 
-  // (C++ 13.3.2p2): A candidate function having more than m parameters
-  // is viable only if the (m+1)st parameter has a default argument
-  // (8.3.6). For the purposes of overload resolution, the
-  // parameter list is truncated on the right, so that there are
-  // exactly m parameters.
-  unsigned MinRequiredArgs = Function->getMinRequiredArguments();
-  if (Args.size() < MinRequiredArgs && !PartialOverloading) {
+  if (TooFewArgs) {
     // Not enough arguments.
     Candidate.Viable = false;
     Candidate.FailureKind = ovl_fail_too_few_arguments;
@@ -5842,32 +5913,38 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
   // Overload resolution is always an unevaluated context.
   EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
 
-  // Add this candidate
-  OverloadCandidate &Candidate = CandidateSet.addCandidate(Args.size() + 1);
-  Candidate.FoundDecl = FoundDecl;
-  Candidate.Function = Method;
-  Candidate.IsSurrogate = false;
-  Candidate.IgnoreObjectArgument = false;
-  Candidate.ExplicitCallArguments = Args.size();
-
   unsigned NumParams = Proto->getNumParams();
 
   // (C++ 13.3.2p2): A candidate function having fewer than m
   // parameters is viable only if it has an ellipsis in its parameter
   // list (8.3.5).
-  if (Args.size() > NumParams && !Proto->isVariadic()) {
-    Candidate.Viable = false;
-    Candidate.FailureKind = ovl_fail_too_many_arguments;
-    return;
-  }
+  bool TooManyArgs = Args.size() > NumParams && !Proto->isVariadic();
 
   // (C++ 13.3.2p2): A candidate function having more than m parameters
   // is viable only if the (m+1)st parameter has a default argument
   // (8.3.6). For the purposes of overload resolution, the
   // parameter list is truncated on the right, so that there are
   // exactly m parameters.
-  unsigned MinRequiredArgs = Method->getMinRequiredArguments();
-  if (Args.size() < MinRequiredArgs) {
+  bool TooFewArgs =
+      !TooManyArgs && Args.size() < Method->getMinRequiredArguments();
+
+  // Add this candidate. As in AddOverloadCandidate, arity failures get no
+  // conversion sequences.
+  OverloadCandidate &Candidate = CandidateSet.addCandidate(
+      TooManyArgs || TooFewArgs ? 0 : Args.size() + 1);
+  Candidate.FoundDecl = FoundDecl;
+  Candidate.Function = Method;
+  Candidate.IsSurrogate = false;
+  Candidate.IgnoreObjectArgument = false;
+  Candidate.ExplicitCallArguments = Args.size();
+
+  if (TooManyArgs) {
+    Candidate.Viable = false;
+    Candidate.FailureKind = ovl_fail_too_many_arguments;
+    return;
+  }
+
+  if (TooFewArgs) {
     // Not enough arguments.
     Candidate.Viable = false;
     Candidate.FailureKind = ovl_fail_too_few_arguments;
@@ -20,6 +20,7 @@
 #include "clang/Basic/LangOptions.h"
 #include "clang/Sema/DeclSpec.h"
 #include "clang/Sema/Initialization.h"
+#include "clang/Sema/InstantiationTrace.h"
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
@@ -200,6 +201,31 @@ bool Sema::ActiveTemplateInstantiation::isInstantiationRecord() const {
   llvm_unreachable("Invalid InstantiationKind!");
 }
 
+/// \brief The event name used for \p Kind in an instantiation trace.
+static const char *
+getTraceEventName(Sema::ActiveTemplateInstantiation::InstantiationKind Kind) {
+  switch (Kind) {
+  case Sema::ActiveTemplateInstantiation::TemplateInstantiation:
+    return "TemplateInstantiation";
+  case Sema::ActiveTemplateInstantiation::DefaultTemplateArgumentInstantiation:
+    return "DefaultTemplateArgumentInstantiation";
+  case Sema::ActiveTemplateInstantiation::DefaultFunctionArgumentInstantiation:
+    return "DefaultFunctionArgumentInstantiation";
+  case Sema::ActiveTemplateInstantiation::ExplicitTemplateArgumentSubstitution:
+    return "ExplicitTemplateArgumentSubstitution";
+  case Sema::ActiveTemplateInstantiation::DeducedTemplateArgumentSubstitution:
+    return "DeducedTemplateArgumentSubstitution";
+  case Sema::ActiveTemplateInstantiation::PriorTemplateArgumentSubstitution:
+    return "PriorTemplateArgumentSubstitution";
+  case Sema::ActiveTemplateInstantiation::DefaultTemplateArgumentChecking:
+    return "DefaultTemplateArgumentChecking";
+  case Sema::ActiveTemplateInstantiation::ExceptionSpecInstantiation:
+    return "ExceptionSpecInstantiation";
+  }
+
+  llvm_unreachable("Invalid InstantiationKind!");
+}
+
 void Sema::InstantiatingTemplate::Initialize(
     ActiveTemplateInstantiation::InstantiationKind Kind,
     SourceLocation PointOfInstantiation, SourceRange InstantiationRange,
@@ -222,6 +248,8 @@ void Sema::InstantiatingTemplate::Initialize(
     SemaRef.ActiveTemplateInstantiations.push_back(Inst);
     if (!Inst.isInstantiationRecord())
       ++SemaRef.NonInstantiationEntries;
+    if (SemaRef.InstTrace)
+      SemaRef.InstTrace->begin(getTraceEventName(Kind), Entity);
   }
 }
 
@@ -364,6 +392,8 @@ void Sema::InstantiatingTemplate::Clear() {
       SemaRef.ActiveTemplateInstantiationLookupModules.pop_back();
     }
 
+    if (SemaRef.InstTrace)
+      SemaRef.InstTrace->end();
     SemaRef.ActiveTemplateInstantiations.pop_back();
     Invalid = true;
   }
@@ -21,7 +21,10 @@
 namespace clang {
 
 class TypeLocBuilder {
-  enum { InlineCapacity = 8 * sizeof(SourceLocation) };
+  /// Enough for the location data of most function and template
+  /// specialization types, which TreeTransform rebuilds constantly during
+  /// template instantiation, without going to the heap.
+  enum { InlineCapacity = 32 * sizeof(SourceLocation) };
 
   /// The underlying location-data buffer.  Data grows from the end
   /// of the buffer backwards.
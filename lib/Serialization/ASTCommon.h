@@ -80,6 +80,42 @@ const DeclContext *getDefinitiveDeclContext(const DeclContext *DC);
 /// \brief Determine whether the given declaration kind is redeclarable.
 bool isRedeclarableDeclKind(unsigned Kind);
 
+/// \brief Encode a raw source location for an SM_SLOC_EXPANSION_ENTRY record.
+///
+/// The macro bit is the top bit of a raw location, which would make every
+/// macro location cost a full five bytes as a VBR.  Rotating it down to the
+/// bottom bit keeps small offsets small regardless of their kind.
+inline uint64_t encodeSLocEntryLocation(unsigned Raw) {
+  return (Raw << 1) | (Raw >> 31);
+}
+
+/// \brief Decode a location encoded by \c encodeSLocEntryLocation.
+inline unsigned decodeSLocEntryLocation(uint64_t Encoded) {
+  unsigned Rotated = unsigned(Encoded);
+  return (Rotated >> 1) | (Rotated << 31);
+}
+
+/// \brief Encode the end of a macro expansion range relative to its start,
+/// which it is almost always close to.  Macro argument expansions have no end
+/// location and are encoded as 0.
+inline uint64_t encodeSLocEntryEnd(unsigned RawStart, unsigned RawEnd) {
+  if (!RawEnd)
+    return 0;
+  int64_t Delta = int64_t(encodeSLocEntryLocation(RawEnd)) -
+                  int64_t(encodeSLocEntryLocation(RawStart));
+  // Zig-zag encode the delta so that small negative values stay small.
+  return ((uint64_t(Delta) << 1) ^ uint64_t(Delta >> 63)) + 1;
+}
+
+/// \brief Decode an end location encoded by \c encodeSLocEntryEnd.
+inline unsigned decodeSLocEntryEnd(unsigned RawStart, uint64_t Encoded) {
+  if (!Encoded)
+    return 0;
+  uint64_t ZigZag = Encoded - 1;
+  int64_t Delta = int64_t(ZigZag >> 1) ^ -int64_t(ZigZag & 1);
+  return decodeSLocEntryLocation(encodeSLocEntryLocation(RawStart) + Delta);
+}
+
 } // namespace serialization
 
 } // namespace clang
@@ -1261,10 +1261,14 @@ bool ASTReader::ReadSLocEntry(int ID) {
   }
 
   case SM_SLOC_EXPANSION_ENTRY: {
-    SourceLocation SpellingLoc = ReadSourceLocation(*F, Record[1]);
+    unsigned RawStart = decodeSLocEntryLocation(Record[2]);
+    SourceLocation SpellingLoc =
+        ReadSourceLocation(*F, decodeSLocEntryLocation(Record[1]));
     SourceMgr.createExpansionLoc(SpellingLoc,
-                                     ReadSourceLocation(*F, Record[2]),
-                                     ReadSourceLocation(*F, Record[3]),
+                                     ReadSourceLocation(*F, RawStart),
+                                     ReadSourceLocation(*F,
+                                         decodeSLocEntryEnd(RawStart,
+                                                            Record[3])),
                                      Record[4],
                                      ID,
                                      BaseOffset + Record[0]);
@@ -3481,6 +3485,20 @@ ASTReader::ASTReadResult ASTReader::ReadAST(const std::string &FileName,
   // Defer any pending actions until we get to the end of reading the AST file.
   Deserializing AnASTFile(this);
 
+  // If this module file has already been loaded, typically as a dependency of
+  // an earlier import, there is nothing new to read. Just record the direct
+  // import; bumping the generation and marking every identifier out of date
+  // would make each lazily-completed redeclaration chain and identifier
+  // consult all of the loaded modules again, for no benefit.
+  if (Type == MK_Module && ModuleMgr.lookup(FileName)) {
+    SmallVector<ImportedModule, 1> Loaded;
+    ASTReadResult Result = ReadASTCore(FileName, Type, ImportLoc,
+                                       /*ImportedBy=*/nullptr, Loaded, 0, 0,
+                                       ClientLoadCapabilities);
+    assert(Loaded.empty() && "reloaded an already-loaded module file");
+    return Result;
+  }
+
   // Bump the generation number.
   unsigned PreviousGeneration = incrementGeneration(Context);
 
@@ -6213,6 +6231,8 @@ serialization::DeclID ASTReader::ReadDeclID(ModuleFile &F,
 /// source each time it is called, and is meant to be used via a
 /// LazyOffsetPtr (which is used by Decls for the body of functions, etc).
 Stmt *ASTReader::GetExternalDeclStmt(uint64_t Offset) {
+  ++NumLazyBodiesLoaded;
+
   // Switch case IDs are per Decl.
   ClearSwitchCaseIDs();
 
@@ -6377,11 +6397,16 @@ namespace {
     SmallVectorImpl<NamedDecl *> &Decls;
 
   public:
+    /// \brief The number of module lookup tables probed, and the number of
+    /// those which contained the name.
+    unsigned NumTableLookups, NumTableHits;
+
     DeclContextNameLookupVisitor(ASTReader &Reader, 
                                  SmallVectorImpl<const DeclContext *> &Contexts, 
                                  DeclarationName Name,
                                  SmallVectorImpl<NamedDecl *> &Decls)
-      : Reader(Reader), Contexts(Contexts), Name(Name), Decls(Decls) { }
+      : Reader(Reader), Contexts(Contexts), Name(Name), Decls(Decls),
+        NumTableLookups(0), NumTableHits(0) { }
 
     static bool visit(ModuleFile &M, void *UserData) {
       DeclContextNameLookupVisitor *This
@@ -6406,10 +6431,12 @@ namespace {
       // Look for this name within this module.
       ASTDeclContextNameLookupTable *LookupTable =
         Info->second.NameLookupTableData;
+      ++This->NumTableLookups;
       ASTDeclContextNameLookupTable::iterator Pos
         = LookupTable->find(This->Name);
       if (Pos == LookupTable->end())
         return false;
+      ++This->NumTableHits;
 
       bool FoundAnything = false;
       ASTDeclContextNameLookupTrait::data_type Data = *Pos;
@@ -6500,6 +6527,8 @@ ASTReader::FindExternalVisibleDeclsByName(const DeclContext *DC,
     ModuleMgr.visit(&DeclContextNameLookupVisitor::visit, &Visitor);
   }
   ++NumVisibleDeclContextsRead;
+  NumNameLookupTableLookups += Visitor.NumTableLookups;
+  NumNameLookupTableHits += Visitor.NumTableHits;
   SetExternalVisibleDeclsForName(DC, Name, Decls);
   return !Decls.empty();
 }
@@ -6702,6 +6731,10 @@ void ASTReader::PrintStats() {
     std::fprintf(stderr, "  %u/%u statements read (%f%%)\n",
                  NumStatementsRead, TotalNumStatements,
                  ((float)NumStatementsRead/TotalNumStatements * 100));
+  if (NumLazyBodies)
+    std::fprintf(stderr, "  %u/%u function bodies read (%f%%)\n",
+                 NumLazyBodiesLoaded, NumLazyBodies,
+                 ((float)NumLazyBodiesLoaded/NumLazyBodies * 100));
   if (TotalNumMacros)
     std::fprintf(stderr, "  %u/%u macros read (%f%%)\n",
                  NumMacrosRead, TotalNumMacros,
@@ -6734,6 +6767,13 @@ void ASTReader::PrintStats() {
                   * 100.0));
   }
 
+  if (NumNameLookupTableLookups) {
+    std::fprintf(stderr, "  %u/%u name lookup table lookups succeeded (%f%%)\n",
+                 NumNameLookupTableHits, NumNameLookupTableLookups,
+                 ((float)NumNameLookupTableHits/NumNameLookupTableLookups
+                  * 100.0));
+  }
+
   if (NumIdentifierLookupHits) {
     std::fprintf(stderr,
                  "  %u / %u identifier table lookups succeeded (%f%%)\n",
@@ -7024,8 +7064,20 @@ void ASTReader::ReadMethodPool(Selector Sel) {
   unsigned &Generation = SelectorGeneration[Sel];
   unsigned PriorGeneration = Generation;
   Generation = getGeneration();
-  
+
+  // If no module files have been loaded since we last looked for this
+  // selector, every method pool has already been searched, whether or not
+  // anything was found, so don't bother walking the module graph again.
+  if (PriorGeneration == Generation)
+    return;
+
   // Search for methods defined with this selector.
+  //
+  // FIXME: Unlike identifier lookups, this cannot be narrowed with the global
+  // module index, which only records identifiers that name something. The
+  // pieces of a selector need not, so every module's method pool is probed.
+  // Indexing selectors would mean decoding each module's METHOD_POOL keys,
+  // whose identifier IDs are local to that module, when building the index.
   ++NumMethodPoolLookups;
   ReadMethodPoolVisitor Visitor(*this, Sel, PriorGeneration);
   ModuleMgr.visit(&ReadMethodPoolVisitor::visit, &Visitor);
@@ -8260,14 +8312,18 @@ void ASTReader::finishPendingActions() {
     if (FunctionDecl *FD = dyn_cast<FunctionDecl>(PB->first)) {
       // FIXME: Check for =delete/=default?
       // FIXME: Complain about ODR violations here?
-      if (!getContext().getLangOpts().Modules || !FD->hasBody())
+      if (!getContext().getLangOpts().Modules || !FD->hasBody()) {
         FD->setLazyBody(PB->second);
+        ++NumLazyBodies;
+      }
       continue;
     }
 
     ObjCMethodDecl *MD = cast<ObjCMethodDecl>(PB->first);
-    if (!getContext().getLangOpts().Modules || !MD->hasBody())
+    if (!getContext().getLangOpts().Modules || !MD->hasBody()) {
       MD->setLazyBody(PB->second);
+      ++NumLazyBodies;
+    }
   }
   PendingBodies.clear();
 
@@ -8360,11 +8416,13 @@ ASTReader::ASTReader(Preprocessor &PP, ASTContext &Context, StringRef isysroot,
       UseGlobalIndex(UseGlobalIndex), TriedLoadingGlobalIndex(false),
       CurrSwitchCaseStmts(&SwitchCaseStmts),
       NumSLocEntriesRead(0), TotalNumSLocEntries(0), NumStatementsRead(0),
-      TotalNumStatements(0), NumMacrosRead(0), TotalNumMacros(0),
+      TotalNumStatements(0), NumLazyBodies(0), NumLazyBodiesLoaded(0),
+      NumMacrosRead(0), TotalNumMacros(0),
       NumIdentifierLookups(0), NumIdentifierLookupHits(0), NumSelectorsRead(0),
       NumMethodPoolEntriesRead(0), NumMethodPoolLookups(0),
       NumMethodPoolHits(0), NumMethodPoolTableLookups(0),
-      NumMethodPoolTableHits(0), TotalNumMethodPoolEntries(0),
+      NumMethodPoolTableHits(0), NumNameLookupTableLookups(0),
+      NumNameLookupTableHits(0), TotalNumMethodPoolEntries(0),
       NumLexicalDeclContextsRead(0), TotalLexicalDeclContexts(0),
       NumVisibleDeclContextsRead(0), TotalVisibleDeclContexts(0),
       TotalModulesSizeInBits(0), NumCurrentElementsDeserializing(0),
@@ -1457,7 +1457,7 @@ static unsigned CreateSLocExpansionAbbrev(llvm::BitstreamWriter &Stream) {
   Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8)); // Offset
   Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8)); // Spelling location
   Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8)); // Start location
-  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8)); // End location
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6)); // End, as a delta
   Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6)); // Token length
   return Stream.EmitAbbrev(Abbrev);
 }
@@ -1760,10 +1760,14 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
     } else {
       // The source location entry is a macro expansion.
       const SrcMgr::ExpansionInfo &Expansion = SLoc->getExpansion();
-      Record.push_back(Expansion.getSpellingLoc().getRawEncoding());
-      Record.push_back(Expansion.getExpansionLocStart().getRawEncoding());
-      Record.push_back(Expansion.isMacroArgExpansion() ? 0
-                             : Expansion.getExpansionLocEnd().getRawEncoding());
+      unsigned RawStart = Expansion.getExpansionLocStart().getRawEncoding();
+      Record.push_back(
+          encodeSLocEntryLocation(Expansion.getSpellingLoc().getRawEncoding()));
+      Record.push_back(encodeSLocEntryLocation(RawStart));
+      Record.push_back(encodeSLocEntryEnd(
+          RawStart, Expansion.isMacroArgExpansion()
+                        ? 0
+                        : Expansion.getExpansionLocEnd().getRawEncoding()));
 
       // Compute the token length for this macro expansion.
       unsigned NextOffset = SourceMgr.getNextLocalOffset();
@@ -4044,6 +4048,12 @@ static void AddLazyVectorDecls(ASTWriter &Writer, Vector &Vec,
   }
 }
 
+// FIXME: Everything here is written serially into a single bitstream. The
+// blocks are not independent enough to split across threads: writing a decl
+// or type assigns IDs to (and queues) every decl and type it references, the
+// identifier and decl-context tables are only complete once all decls have
+// been written, and the offsets tables record absolute bit positions in the
+// one stream.
 void ASTWriter::WriteASTCore(Sema &SemaRef,
                              StringRef isysroot,
                              const std::string &OutputFile, 
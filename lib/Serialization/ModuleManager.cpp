@@ -95,6 +95,10 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
       if (!FileMgr.getNoncachedStatValue(TimestampFilename, Status))
         New->InputFilesValidationTimestamp =
             Status.getLastModificationTime().toEpochTime();
+    } else if (New->Kind == MK_PCH && Entry) {
+      // A precompiled header's inputs were all read when it was written, so
+      // the file's own modification time serves as its validation timestamp.
+      New->InputFilesValidationTimestamp = Entry->getModificationTime();
     }
 
     // Load the contents of the module
@@ -65,6 +65,21 @@ IPAKind AnalyzerOptions::getIPAMode() {
   return IPAMode;
 }
 
+ExplorationStrategyKind AnalyzerOptions::getExplorationStrategy() {
+  if (ExplorationStrategy == ESK_NotSet) {
+    StringRef StratStr(
+        Config.GetOrCreateValue("exploration-strategy", "dfs").getValue());
+    // Fall back to the default rather than fail on an unknown strategy.
+    ExplorationStrategy = llvm::StringSwitch<ExplorationStrategyKind>(StratStr)
+      .Case("dfs", ESK_DFS)
+      .Case("bfs", ESK_BFS)
+      .Case("bfs-block-dfs-contents", ESK_BFSBlockDFSContents)
+      .Case("unexplored-first", ESK_UnexploredFirst)
+      .Default(ESK_DFS);
+  }
+  return ExplorationStrategy;
+}
+
 bool
 AnalyzerOptions::mayInlineCXXMemberFunction(CXXInlineableMemberKind K) {
   if (getIPAMode() < IPAK_Inlining)
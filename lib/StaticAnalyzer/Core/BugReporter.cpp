@@ -3403,6 +3403,10 @@ void BugReporter::FlushReport(BugReportEquivClass& EQ) {
   SmallVector<BugReport*, 10> bugReports;
   BugReport *exampleReport = FindReportInEquivalenceClass(EQ, bugReports);
   if (exampleReport) {
+    // FIXME: The path is trimmed and the visitors are run once per consumer,
+    // even for consumers that share a generation scheme. Generating it once
+    // per scheme needs a way to copy a PathDiagnostic, as each consumer takes
+    // ownership of the one it is given.
     for (PathDiagnosticConsumer *PDC : getPathDiagnosticConsumers()) {
       FlushReport(exampleReport, *PDC, bugReports);
     }
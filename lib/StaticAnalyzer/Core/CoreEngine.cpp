@@ -18,6 +18,7 @@
 #include "clang/StaticAnalyzer/Core/PathSensitive/AnalysisManager.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExprEngine.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Casting.h"
 
@@ -156,10 +157,94 @@ WorkList* WorkList::makeBFSBlockDFSContents() {
   return new BFSBlockDFSContents();
 }
 
+namespace {
+  /// A depth-first worklist that gives priority to paths entering basic blocks
+  /// which have not been reached yet in the same stack frame. With a limited
+  /// node budget this covers more of a function than plain DFS, which can
+  /// spend the whole budget on the paths through its first few branches.
+  class UnexploredFirstStack : public WorkList {
+    /// Nodes that lead to blocks not reached before.
+    SmallVector<WorkListUnit, 20> StackUnexplored;
+    /// All other nodes.
+    SmallVector<WorkListUnit, 20> StackOthers;
+
+    typedef std::pair<unsigned, const StackFrameContext *> LocIdentifier;
+    llvm::DenseSet<LocIdentifier> Reachable;
+
+  public:
+    bool hasWork() const override {
+      return !StackUnexplored.empty() || !StackOthers.empty();
+    }
+
+    void enqueue(const WorkListUnit &U) override {
+      const ExplodedNode *N = U.getNode();
+      Optional<BlockEntrance> BE = N->getLocation().getAs<BlockEntrance>();
+      if (!BE) {
+        // Keep processing the contents of the block we are in.
+        StackUnexplored.push_back(U);
+        return;
+      }
+      LocIdentifier LocId(BE->getBlock()->getBlockID(),
+                          N->getLocationContext()->getCurrentStackFrame());
+      if (Reachable.insert(LocId).second)
+        StackUnexplored.push_back(U);
+      else
+        StackOthers.push_back(U);
+    }
+
+    WorkListUnit dequeue() override {
+      if (!StackUnexplored.empty()) {
+        WorkListUnit U = StackUnexplored.back();
+        StackUnexplored.pop_back();
+        return U;
+      }
+      assert(!StackOthers.empty());
+      WorkListUnit U = StackOthers.back();
+      StackOthers.pop_back();
+      return U;
+    }
+
+    bool visitItemsInWorkList(Visitor &V) override {
+      for (SmallVectorImpl<WorkListUnit>::iterator
+           I = StackUnexplored.begin(), E = StackUnexplored.end();
+           I != E; ++I) {
+        if (V.visit(*I))
+          return true;
+      }
+      for (SmallVectorImpl<WorkListUnit>::iterator
+           I = StackOthers.begin(), E = StackOthers.end(); I != E; ++I) {
+        if (V.visit(*I))
+          return true;
+      }
+      return false;
+    }
+  };
+} // end anonymous namespace
+
+WorkList *WorkList::makeUnexploredFirst() {
+  return new UnexploredFirstStack();
+}
+
 //===----------------------------------------------------------------------===//
 // Core analysis engine.
 //===----------------------------------------------------------------------===//
 
+WorkList *CoreEngine::generateWorkList(AnalyzerOptions &Opts) {
+  switch (Opts.getExplorationStrategy()) {
+  case ESK_DFS:
+    return WorkList::makeDFS();
+  case ESK_BFS:
+    return WorkList::makeBFS();
+  case ESK_BFSBlockDFSContents:
+    return WorkList::makeBFSBlockDFSContents();
+  case ESK_UnexploredFirst:
+    return WorkList::makeUnexploredFirst();
+  case ESK_NotSet:
+    break;
+  }
+  return WorkList::makeDFS();
+}
+
 /// ExecuteWorkList - Run the worklist algorithm for a maximum number of steps.
 bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
                                    ProgramStateRef InitState) {
@@ -26,6 +26,10 @@
 using namespace clang;
 using namespace ento;
 
+#define DEBUG_TYPE "ExplodedGraph"
+
+STATISTIC(NumReclaimedNodes, "The # of exploded graph nodes reclaimed.");
+
 //===----------------------------------------------------------------------===//
 // Node auditing.
 //===----------------------------------------------------------------------===//
@@ -192,8 +196,10 @@ void ExplodedGraph::reclaimRecentlyAllocatedNodes() {
   for (NodeVector::iterator it = ChangedNodes.begin(), et = ChangedNodes.end();
        it != et; ++it) {
     ExplodedNode *node = *it;
-    if (shouldCollect(node))
+    if (shouldCollect(node)) {
       collectNode(node);
+      ++NumReclaimedNodes;
+    }
   }
   ChangedNodes.clear();
 }
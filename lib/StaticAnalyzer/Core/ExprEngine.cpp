@@ -63,7 +63,7 @@ ExprEngine::ExprEngine(AnalysisManager &mgr, bool gcEnabled,
                        InliningModes HowToInlineIn)
   : AMgr(mgr),
     AnalysisDeclContexts(mgr.getAnalysisDeclContextManager()),
-    Engine(*this, FS),
+    Engine(*this, FS, mgr.getAnalyzerOptions()),
     G(Engine.getGraph()),
     StateMgr(getContext(), mgr.getStoreManagerCreator(),
              mgr.getConstraintManagerCreator(), G.getAllocator(),
@@ -344,6 +344,12 @@ void ExprEngine::removeDead(ExplodedNode *Pred, ExplodedNodeSet &Out,
     assert(DiagnosticStmt && "Required for clearing a LocationContext");
   }
 
+  // FIXME: Each call recomputes liveness over the whole environment, store
+  // and constraints of the state. An incremental scheme that only revisits
+  // bindings changed since the last purge would need the Environment and
+  // RegionStore to track those changes, and the reaper's answer also depends
+  // on the current statement through LiveVariables, so nothing can be reused
+  // across purge points as things stand.
   NumRemoveDeadBindings++;
   ProgramStateRef CleanedState = Pred->getState();
 
@@ -281,6 +281,18 @@ REGISTER_TRAIT_WITH_PROGRAMSTATE(ConstraintRange,
                                  CLANG_ENTO_PROGRAMSTATE_MAP(SymbolRef,
                                                              RangeSet))
 
+/// Returns \p St with \p Sym constrained to \p New, or null if \p New is
+/// empty. Reuses \p St when the assumption did not narrow the constraint.
+static ProgramStateRef setConstraint(ProgramStateRef St, SymbolRef Sym,
+                                     const RangeSet &New) {
+  if (New.isEmpty())
+    return nullptr;
+  if (const RangeSet *Old = St->get<ConstraintRange>(Sym))
+    if (*Old == New)
+      return St;
+  return St->set<ConstraintRange>(Sym, New);
+}
+
 namespace {
 class RangeConstraintManager : public SimpleConstraintManager{
   RangeSet GetRange(ProgramStateRef state, SymbolRef sym);
@@ -432,7 +444,7 @@ RangeConstraintManager::assumeSymNE(ProgramStateRef St, SymbolRef Sym,
   // [Int-Adjustment+1, Int-Adjustment-1]
   // Notice that the lower bound is greater than the upper bound.
   RangeSet New = GetRange(St, Sym).Intersect(getBasicVals(), F, Upper, Lower);
-  return New.isEmpty() ? nullptr : St->set<ConstraintRange>(Sym, New);
+  return setConstraint(St, Sym, New);
 }
 
 ProgramStateRef 
@@ -447,7 +459,7 @@ RangeConstraintManager::assumeSymEQ(ProgramStateRef St, SymbolRef Sym,
   // [Int-Adjustment, Int-Adjustment]
   llvm::APSInt AdjInt = AdjustmentType.convert(Int) - Adjustment;
   RangeSet New = GetRange(St, Sym).Intersect(getBasicVals(), F, AdjInt, AdjInt);
-  return New.isEmpty() ? nullptr : St->set<ConstraintRange>(Sym, New);
+  return setConstraint(St, Sym, New);
 }
 
 ProgramStateRef 
@@ -476,7 +488,7 @@ RangeConstraintManager::assumeSymLT(ProgramStateRef St, SymbolRef Sym,
   --Upper;
 
   RangeSet New = GetRange(St, Sym).Intersect(getBasicVals(), F, Lower, Upper);
-  return New.isEmpty() ? nullptr : St->set<ConstraintRange>(Sym, New);
+  return setConstraint(St, Sym, New);
 }
 
 ProgramStateRef 
@@ -505,7 +517,7 @@ RangeConstraintManager::assumeSymGT(ProgramStateRef St, SymbolRef Sym,
   ++Lower;
 
   RangeSet New = GetRange(St, Sym).Intersect(getBasicVals(), F, Lower, Upper);
-  return New.isEmpty() ? nullptr : St->set<ConstraintRange>(Sym, New);
+  return setConstraint(St, Sym, New);
 }
 
 ProgramStateRef 
@@ -534,7 +546,7 @@ RangeConstraintManager::assumeSymGE(ProgramStateRef St, SymbolRef Sym,
   llvm::APSInt Upper = Max-Adjustment;
 
   RangeSet New = GetRange(St, Sym).Intersect(getBasicVals(), F, Lower, Upper);
-  return New.isEmpty() ? nullptr : St->set<ConstraintRange>(Sym, New);
+  return setConstraint(St, Sym, New);
 }
 
 ProgramStateRef 
@@ -563,7 +575,7 @@ RangeConstraintManager::assumeSymLE(ProgramStateRef St, SymbolRef Sym,
   llvm::APSInt Upper = ComparisonVal-Adjustment;
 
   RangeSet New = GetRange(St, Sym).Intersect(getBasicVals(), F, Lower, Upper);
-  return New.isEmpty() ? nullptr : St->set<ConstraintRange>(Sym, New);
+  return setConstraint(St, Sym, New);
 }
 
 //===------------------------------------------------------------------------===
@@ -245,6 +245,14 @@ RegionBindingsRef RegionBindingsRef::addBinding(BindingKey K, SVal V) const {
   const MemRegion *Base = K.getBaseRegion();
 
   const ClusterBindings *ExistingCluster = lookup(Base);
+
+  // Rebinding a key to the value it already has leaves the store unchanged;
+  // don't rebuild the paths to it in both levels of the map.
+  if (ExistingCluster)
+    if (const SVal *ExistingVal = ExistingCluster->lookup(K))
+      if (*ExistingVal == V)
+        return *this;
+
   ClusterBindings Cluster = (ExistingCluster ? *ExistingCluster
                              : CBFactory.getEmptyMap());
 
@@ -274,7 +282,7 @@ const SVal *RegionBindingsRef::lookup(const MemRegion *R,
 RegionBindingsRef RegionBindingsRef::removeBinding(BindingKey K) {
   const MemRegion *Base = K.getBaseRegion();
   const ClusterBindings *Cluster = lookup(Base);
-  if (!Cluster)
+  if (!Cluster || !Cluster->lookup(K))
     return *this;
 
   ClusterBindings NewCluster = CBFactory.remove(*Cluster, K);
@@ -61,6 +61,9 @@ STATISTIC(NumBlocksInAnalyzedFunctions,
                       "The # of basic blocks in the analyzed functions.");
 STATISTIC(PercentReachableBlocks, "The % of reachable basic blocks.");
 STATISTIC(MaxCFGSize, "The maximum number of basic blocks in a function.");
+STATISTIC(MaxExplodedGraphMemory,
+          "The maximum # of bytes allocated for the exploded graph and the "
+          "program states of a function.");
 
 //===----------------------------------------------------------------------===//
 // Special PathDiagnosticConsumers.
@@ -466,6 +469,13 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
   // inlined functions. The topological order allows the "do not reanalyze
   // previously inlined function" performance heuristic to be triggered more
   // often.
+  //
+  // FIXME: Top-level functions are analyzed one at a time. Analyzing them
+  // concurrently would need more than per-thread ExprEngines: the ASTContext,
+  // the AnalysisDeclContextManager's CFG and ParentMap caches, lazy PCH
+  // deserialization and the PathDiagnosticConsumers are all shared and not
+  // thread-safe, and the Visited set above makes the result depend on the
+  // order in which functions are processed.
   SetOfConstDecls Visited;
   SetOfConstDecls VisitedAsTopLevel;
   llvm::ReversePostOrderTraversal<clang::CallGraph*> RPOT(&CG);
@@ -602,6 +612,11 @@ void AnalysisConsumer::HandleCode(Decl *D, AnalysisMode Mode,
   if (Mode == AM_None)
     return;
 
+  // FIXME: Every function is analyzed from scratch on each run. Replaying the
+  // results of an unchanged function would need a persistent form of
+  // PathDiagnostics, and a key covering not only its body but everything its
+  // analysis can observe: inlined callees, declarations of called functions,
+  // globals, checker options and the target.
   DisplayFunction(D, Mode, IMode);
   CFG *DeclCFG = Mgr->getCFG(D);
   if (DeclCFG) {
@@ -651,6 +666,10 @@ void AnalysisConsumer::ActionExprEngine(Decl *D, bool ObjCGCEnabled,
   Eng.ExecuteWorkList(Mgr->getAnalysisDeclContextManager().getStackFrame(D),
                       Mgr->options.getMaxNodesPerTopLevelFunction());
 
+  uint64_t GraphMemory = Eng.getGraph().getAllocator().getTotalMemory();
+  MaxExplodedGraphMemory =
+      std::max(GraphMemory, static_cast<uint64_t>(MaxExplodedGraphMemory));
+
   // Release the auditor (if any) so that it doesn't monitor the graph
   // created BugReporter.
   ExplodedNode::SetAuditor(nullptr);
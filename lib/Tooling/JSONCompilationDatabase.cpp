@@ -174,6 +174,17 @@ JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
   SmallString<128> NativeFilePath;
   llvm::sys::path::native(FilePath, NativeFilePath);
 
+  std::vector<CompileCommand> Commands;
+
+  // Most queries name a file exactly as the database does; answer those
+  // without the trie's equivalence checks, which may stat files.
+  llvm::StringMap< std::vector<CompileCommandRef> >::const_iterator
+    ExactI = IndexByFile.find(NativeFilePath);
+  if (ExactI != IndexByFile.end()) {
+    getCommands(ExactI->getValue(), Commands);
+    return Commands;
+  }
+
   std::string Error;
   llvm::raw_string_ostream ES(Error);
   StringRef Match = MatchTrie.findEquivalent(NativeFilePath.str(), ES);
@@ -183,7 +194,6 @@ JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
     CommandsRefI = IndexByFile.find(Match);
   if (CommandsRefI == IndexByFile.end())
     return std::vector<CompileCommand>();
-  std::vector<CompileCommand> Commands;
   getCommands(CommandsRefI->getValue(), Commands);
   return Commands;
 }
@@ -191,6 +201,7 @@ JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
 std::vector<std::string>
 JSONCompilationDatabase::getAllFiles() const {
   std::vector<std::string> Result;
+  Result.reserve(IndexByFile.size());
 
   llvm::StringMap< std::vector<CompileCommandRef> >::const_iterator
     CommandsRefI = IndexByFile.begin();
@@ -206,6 +217,7 @@ JSONCompilationDatabase::getAllFiles() const {
 std::vector<CompileCommand>
 JSONCompilationDatabase::getAllCompileCommands() const {
   std::vector<CompileCommand> Commands;
+  Commands.reserve(NumCommands);
   for (llvm::StringMap< std::vector<CompileCommandRef> >::const_iterator
         CommandsRefI = IndexByFile.begin(), CommandsRefEnd = IndexByFile.end();
       CommandsRefI != CommandsRefEnd; ++CommandsRefI) {
@@ -275,11 +287,12 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
         return false;
       }
       SmallString<8> KeyStorage;
-      if (KeyString->getValue(KeyStorage) == "directory") {
+      StringRef KeyValue = KeyString->getValue(KeyStorage);
+      if (KeyValue == "directory") {
         Directory = ValueString;
-      } else if (KeyString->getValue(KeyStorage) == "command") {
+      } else if (KeyValue == "command") {
         Command = ValueString;
-      } else if (KeyString->getValue(KeyStorage) == "file") {
+      } else if (KeyValue == "file") {
         File = ValueString;
       } else {
         ErrorMessage = ("Unknown key: \"" +
@@ -313,6 +326,7 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
     }
     IndexByFile[NativeFilePath].push_back(
         CompileCommandRef(Directory, Command));
+    ++NumCommands;
     MatchTrie.insert(NativeFilePath.str());
   }
   return true;
@@ -173,7 +173,48 @@ bool applyAllReplacements(const std::vector<Replacement> &Replaces,
   return Result;
 }
 
+/// \brief Applies \p Replaces to \p Code by splicing the untouched pieces of
+/// \p Code and the replacement texts into a single string.
+///
+/// Returns false without touching \p Result if the replacements overlap, which
+/// needs the offset remapping of a RewriteBuffer to reproduce. A replacement
+/// that reaches past the end of \p Code leaves \p Result empty.
+static bool spliceReplacements(StringRef Code, const Replacements &Replaces,
+                               std::string &Result) {
+  unsigned Pos = 0;
+  size_t ResultSize = Code.size();
+  for (Replacements::const_iterator I = Replaces.begin(), E = Replaces.end();
+       I != E; ++I) {
+    if (I->getOffset() < Pos)
+      return false;
+    if (I->getOffset() + I->getLength() > Code.size()) {
+      Result.clear();
+      return true;
+    }
+    Pos = I->getOffset() + I->getLength();
+    ResultSize += I->getReplacementText().size() - I->getLength();
+  }
+  Result.clear();
+  Result.reserve(ResultSize);
+  Pos = 0;
+  for (Replacements::const_iterator I = Replaces.begin(), E = Replaces.end();
+       I != E; ++I) {
+    Result.append(Code.data() + Pos, I->getOffset() - Pos);
+    Result.append(I->getReplacementText().data(),
+                  I->getReplacementText().size());
+    Pos = I->getOffset() + I->getLength();
+  }
+  Result.append(Code.data() + Pos, Code.size() - Pos);
+  return true;
+}
+
 std::string applyAllReplacements(StringRef Code, const Replacements &Replaces) {
+  // Sorted, non-overlapping replacements, as produced by clang-format, do not
+  // need a SourceManager and Rewriter to be set up.
+  std::string Spliced;
+  if (spliceReplacements(Code, Replaces, Spliced))
+    return Spliced;
+
   FileManager Files((FileSystemOptions()));
   DiagnosticsEngine Diagnostics(
       IntrusiveRefCntPtr<DiagnosticIDs>(new DiagnosticIDs),
@@ -352,6 +352,11 @@ int ClangTool::run(ToolAction *Action) {
     DEBUG({
       llvm::dbgs() << "Processing: " << Command.first << ".\n";
     });
+    // FIXME: Every file is parsed from scratch, even when many of them start
+    // with the same includes. A shared preamble would need ASTUnit's preamble
+    // bookkeeping: which prefix of the main file it covers, and how to check
+    // that the headers and flags still match. Commands that already pass
+    // -include-pch reuse that PCH here as they would in the build.
     ToolInvocation Invocation(std::move(CommandLine), Action, Files.get());
     Invocation.setDiagnosticConsumer(DiagConsumer);
     for (const auto &MappedFile : MappedFileContents) {
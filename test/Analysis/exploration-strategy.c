@@ -0,0 +1,66 @@
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-nodes=5000 -analyzer-config exploration-strategy=dfs -DDFS -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-nodes=5000 -analyzer-config exploration-strategy=bfs -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-nodes=5000 -analyzer-config exploration-strategy=bfs-block-dfs-contents -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-nodes=5000 -analyzer-config exploration-strategy=unexplored-first -verify %s
+
+// An unknown strategy falls back to dfs.
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-nodes=5000 -analyzer-config exploration-strategy=unknown -DDFS -verify %s
+
+// The false branch of each condition is explored first. DFS then spends the
+// whole budget on the 2^16 paths through the conditions on x, and never
+// comes back to the dereferences. The other strategies reach them early.
+
+#ifdef DFS
+// expected-no-diagnostics
+#endif
+
+int test(int a, int b, int x0, int x1, int x2, int x3,
+         int x4, int x5, int x6, int x7,
+         int x8, int x9, int x10, int x11,
+         int x12, int x13, int x14, int x15) {
+  int *p = 0;
+  int s = 0;
+  if (a)
+    s += *p;
+#ifndef DFS
+  // expected-warning@-2 {{Dereference of null pointer}}
+#endif
+  if (b)
+    s -= *p;
+#ifndef DFS
+  // expected-warning@-2 {{Dereference of null pointer}}
+#endif
+  if (x0)
+    s += 1;
+  if (x1)
+    s += 2;
+  if (x2)
+    s += 3;
+  if (x3)
+    s += 4;
+  if (x4)
+    s += 5;
+  if (x5)
+    s += 6;
+  if (x6)
+    s += 7;
+  if (x7)
+    s += 8;
+  if (x8)
+    s += 9;
+  if (x9)
+    s += 10;
+  if (x10)
+    s += 11;
+  if (x11)
+    s += 12;
+  if (x12)
+    s += 13;
+  if (x13)
+    s += 14;
+  if (x14)
+    s += 15;
+  if (x15)
+    s += 16;
+  return s;
+}
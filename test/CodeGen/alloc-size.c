@@ -0,0 +1,54 @@
+// RUN: %clang_cc1 -triple x86_64-apple-darwin -emit-llvm -o - %s | FileCheck %s
+
+typedef __SIZE_TYPE__ size_t;
+
+void *my_malloc(size_t) __attribute__((alloc_size(1)));
+void *my_calloc(size_t, size_t) __attribute__((alloc_size(1, 2)));
+
+// CHECK-LABEL: @test1
+size_t test1(void) {
+  // CHECK: call i8* @my_malloc(i64 16)
+  // CHECK: ret i64 16
+  void *const p = my_malloc(16);
+  return __builtin_object_size(p, 0);
+}
+
+// CHECK-LABEL: @test2
+size_t test2(void) {
+  // CHECK: call i8* @my_calloc(i64 5, i64 8)
+  // CHECK: ret i64 40
+  char *const p = (char *)my_calloc(5, 8);
+  return __builtin_object_size(p, 1);
+}
+
+// CHECK-LABEL: @test3
+size_t test3(size_t n) {
+  // With a non-constant size the object size is unknown.
+  // CHECK: call i64 @llvm.objectsize.i64
+  void *const p = my_malloc(n);
+  return __builtin_object_size(p, 0);
+}
+
+// CHECK-LABEL: @test4
+size_t test4(void) {
+  // A pointer that can be changed after its initialization is not followed.
+  // CHECK: call i64 @llvm.objectsize.i64
+  void *p = my_malloc(16);
+  return __builtin_object_size(p, 0);
+}
+
+// CHECK-LABEL: @test5
+size_t test5(void) {
+  // An operand with side-effects is not evaluated, and its size is unknown:
+  // (size_t)-1 for types 0 and 1, and 0 for types 2 and 3.
+  // CHECK-NOT: call
+  // CHECK: ret i64 -1
+  return __builtin_object_size(my_malloc(16), 0);
+}
+
+// CHECK-LABEL: @test6
+size_t test6(void) {
+  // CHECK-NOT: call
+  // CHECK: ret i64 0
+  return __builtin_object_size(my_malloc(16), 2);
+}
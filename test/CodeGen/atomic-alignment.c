@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -emit-llvm -o - %s -Watomic-alignment -verify | FileCheck %s
+
+typedef struct {
+  void *ptr;
+  long tag;
+} TaggedPtr;
+
+TaggedPtr Aligned __attribute__((aligned(16)));
+TaggedPtr Unaligned;
+
+// CHECK-LABEL: define void @load_aligned
+void load_aligned(TaggedPtr *out) {
+  // The object is 16-byte aligned even though its type is not.
+  // CHECK: load atomic i128* {{.*}} seq_cst, align 16
+  // CHECK-NOT: @__atomic_load
+  __atomic_load(&Aligned, out, __ATOMIC_SEQ_CST);
+}
+
+// CHECK-LABEL: define void @load_unaligned
+void load_unaligned(TaggedPtr *out) {
+  // CHECK: call void @__atomic_load(i64 16,
+  __atomic_load(&Unaligned, out, __ATOMIC_SEQ_CST); // expected-warning {{misaligned or large atomic operation on a 16-byte object is lowered to a library call}}
+}
@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -fblocks -emit-llvm -o - %s | FileCheck %s
+
+// CHECK: define void @f0(i32* nocapture %p)
+void f0(int *p __attribute__((noescape))) {
+  *p = 0;
+}
+
+void apply(void (^b)(void) __attribute__((noescape)));
+
+// The attribute is inherited from the earlier declaration.
+// CHECK: define void @apply(void ()* nocapture %b)
+void apply(void (^b)(void)) {
+  b();
+}
+
+// CHECK: define void @f1(i32* %p)
+void f1(int *p) {
+  *p = 0;
+}
+
+// Calls to a function that is only declared get the attribute too, on the
+// declaration and at the call site.
+void declared(int *p __attribute__((noescape)), int *q);
+
+// CHECK-LABEL: define void @call_declared(
+// CHECK: call void @declared(i32* nocapture %{{.*}}, i32* %{{.*}})
+void call_declared(int *p, int *q) {
+  declared(p, q);
+}
+
+// CHECK: declare void @declared(i32* nocapture, i32*)
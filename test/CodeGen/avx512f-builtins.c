@@ -28,3 +28,37 @@ __m512 test_mm512_rsqrt14_ps(__m512 a)
   // CHECK: @llvm.x86.avx512.rsqrt14.ps.512
   return _mm512_rsqrt14_ps(a);
 }
+
+__m512 test_mm512_i32gather_ps(__m512i idx, float const *p)
+{
+  // CHECK: @llvm.x86.avx512.gather.dps.512
+  return _mm512_i32gather_ps(idx, p, 4);
+}
+
+__m512d test_mm512_mask_i32gather_pd(__m512d src, __mmask8 m, __m256i idx,
+                                     double const *p)
+{
+  // CHECK: @llvm.x86.avx512.gather.dpd.512
+  return _mm512_mask_i32gather_pd(src, m, idx, p, 8);
+}
+
+__m512i test_mm512_i64gather_epi64(__m512i idx, long long const *p)
+{
+  // CHECK: @llvm.x86.avx512.gather.qpq.512
+  return _mm512_i64gather_epi64(idx, p, 8);
+}
+
+void test_mm512_mask_i32scatter_epi32(int *p, __mmask16 m, __m512i idx,
+                                      __m512i v)
+{
+  // CHECK: @llvm.x86.avx512.scatter.dpi.512
+  _mm512_mask_i32scatter_epi32(p, m, idx, v, 4);
+}
+
+__mmask16 test_mm512_kandn(__mmask16 a, __mmask16 b)
+{
+  // CHECK-LABEL: @test_mm512_kandn
+  // CHECK: xor i32 %{{.*}}, -1
+  // CHECK: and i32
+  return _mm512_kandn(a, b);
+}
@@ -0,0 +1,20 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -emit-llvm -o - %s | FileCheck %s
+
+int get_offset(void);
+
+// CHECK-LABEL: @test1
+int test1(int *a) {
+// CHECK: [[PTR:%.+]] = bitcast i32* %{{.+}} to i8*
+// CHECK: [[RES:%.+]] = bitcast i8* [[PTR]] to i32*
+// CHECK: store i32* [[RES]], i32** [[A_ADDR:%.+]]
+  a = __builtin_assume_aligned(a, 32);
+  return a[0];
+}
+
+// The offset is evaluated for its side effects.
+// CHECK-LABEL: @test2
+int test2(int *a) {
+// CHECK: call i32 @get_offset()
+  a = __builtin_assume_aligned(a, 32, get_offset());
+  return a[0];
+}
@@ -301,3 +301,16 @@ void test17(void) {
   char valC;
   char16 destVal = valC ? valA : valB;
 }
+
+// Swizzles of rvalue vectors are done in registers.
+// CHECK-LABEL: @test_rvalue_swizzle
+// CHECK: fadd <4 x float>
+// CHECK-NOT: store <4 x float>
+// CHECK: extractelement <4 x float>
+// CHECK: fadd <4 x float>
+// CHECK-NOT: store <4 x float>
+// CHECK: shufflevector <4 x float> {{.*}}, <2 x i32> <i32 3, i32 0>
+float2 test_rvalue_swizzle(float4 a, float4 b, float *out) {
+  *out = (a + b).z;
+  return (a + b).wx;
+}
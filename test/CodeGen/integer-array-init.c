@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -emit-llvm -o - -x c++ %s | FileCheck %s
+
+// Integer arrays are emitted directly as data arrays; check that the values,
+// including sign-extended ones and the implicit zero filler, are preserved.
+
+// CHECK: @c = global [4 x i8] c"\01\02\FF\00"
+char c[4] = {1, 2, -1};
+// CHECK: @s = global [3 x i16] [i16 1, i16 -2, i16 0]
+short s[3] = {1, -2};
+// CHECK: @z = global [2 x i32] zeroinitializer
+int z[2] = {0, 0};
+// CHECK: @l = global [2 x i64] [i64 1, i64 1099511627776]
+long long l[2] = {1, 1LL << 40};
+
+enum E { A = 5, B };
+// CHECK: @e = global [3 x i32] [i32 5, i32 6, i32 0]
+enum E e[3] = {A, B};
+
+// Elements that aren't plain integers still take the general path.
+int x;
+// CHECK: @addr = global [2 x i64] [i64 ptrtoint (i32* @x to i64), i64 1]
+long addr[2] = {(long)&x, 1};
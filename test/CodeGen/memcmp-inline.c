@@ -0,0 +1,47 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -O1 -disable-llvm-optzns -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -emit-llvm -o - %s | FileCheck -check-prefix=CALL %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -O1 -disable-llvm-optzns -fsanitize=address -emit-llvm -o - %s | FileCheck -check-prefix=CALL %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -O1 -disable-llvm-optzns -fsanitize=memory -emit-llvm -o - %s | FileCheck -check-prefix=CALL %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -O1 -disable-llvm-optzns -fsanitize=thread -emit-llvm -o - %s | FileCheck -check-prefix=CALL %s
+
+typedef __SIZE_TYPE__ size_t;
+int memcmp(const void *, const void *, size_t);
+
+// CHECK-LABEL: define i32 @eq16(
+// CHECK-NOT: call i32 @memcmp
+// CHECK: load i64* {{.*}}, align 1
+// CHECK: load i64* {{.*}}, align 1
+// CHECK: xor i64
+// CHECK: load i64* {{.*}}, align 1
+// CHECK: load i64* {{.*}}, align 1
+// CHECK: xor i64
+// CHECK: or i64
+// CHECK: icmp eq i64 {{.*}}, 0
+// CHECK: ret i32
+// CALL-LABEL: define i32 @eq16(
+// CALL: call i32 @memcmp
+int eq16(const void *a, const void *b) {
+  return memcmp(a, b, 16) == 0;
+}
+
+// CHECK-LABEL: define i32 @ne3(
+// CHECK-NOT: call i32 @memcmp
+// CHECK: load i16* {{.*}}, align 1
+// CHECK: load i8* {{.*}}, align 1
+// CHECK: icmp ne i64 {{.*}}, 0
+int ne3(const char *a, const char *b) {
+  return 0 != __builtin_memcmp(a, b, 3);
+}
+
+// Ordering comparisons and large sizes still call memcmp.
+// CHECK-LABEL: define i32 @lt8(
+// CHECK: call i32 @memcmp
+int lt8(const void *a, const void *b) {
+  return memcmp(a, b, 8) < 0;
+}
+
+// CHECK-LABEL: define i32 @eq64(
+// CHECK: call i32 @memcmp
+int eq64(const void *a, const void *b) {
+  return memcmp(a, b, 64) == 0;
+}
@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -emit-llvm -o - %s | FileCheck %s
+
+struct TaggedPtr {
+  void *ptr;
+  long tag;
+};
+
+TaggedPtr Unaligned;
+
+// The alignment attribute applies to the reference, not to the object it is
+// bound to, so this must still use the library call.
+// CHECK-LABEL: define void @_Z16load_through_refP9TaggedPtr
+void load_through_ref(TaggedPtr *out) {
+  TaggedPtr &r __attribute__((aligned(16))) = Unaligned;
+  // CHECK: call void @__atomic_load(i64 16,
+  __atomic_load(&r, out, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,10 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -emit-llvm -o - %s | FileCheck %s
+
+// Copying a bool should store the loaded byte without a trunc/zext round trip.
+// CHECK-LABEL: define void @_Z4copyPbS_
+// CHECK: [[V:%.*]] = load i8* %
+// CHECK-NOT: zext
+// CHECK: store i8 [[V]], i8* %
+void copy(bool *a, bool *b) {
+  *a = *b;
+}
@@ -487,4 +487,17 @@ namespace CopyValueRepresentation {
   }
 }
 
+struct ThisAccess {
+  int x;
+  int get();
+};
+
+// 'this' has already been checked by the caller; don't null-check it again.
+// CHECK-LABEL: define i32 @_ZN10ThisAccess3getEv
+int ThisAccess::get() {
+  // CHECK-NOT: icmp ne {{.*}}, null
+  // CHECK: ret i32
+  return x;
+}
+
 // CHECK: attributes [[NR_NUW]] = { noreturn nounwind }
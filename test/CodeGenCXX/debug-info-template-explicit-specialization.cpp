@@ -91,3 +91,14 @@ struct j {
 extern template class j<int>;
 j<int> jj;
 // CHECK: ; [ DW_TAG_structure_type ] [j<int, int>]
+
+template <typename T>
+struct k {
+  void f() {}
+};
+extern template class k<int>;
+k<int> *kp;
+k<int> ki;
+// Requiring the complete type after a forward declaration was emitted should
+// not force the definition either.
+// CHECK: ; [ DW_TAG_structure_type ] [k<int>] {{.*}} [decl]
@@ -0,0 +1,38 @@
+// RUN: %clang_cc1 %s -triple x86_64-unknown-linux -O1 -disable-llvm-optzns -emit-llvm -o - | FileCheck %s
+// RUN: %clang_cc1 %s -triple x86_64-unknown-linux -emit-llvm -o - | FileCheck --check-prefix=O0 %s
+
+struct Big {
+  Big();
+  ~Big();
+  char buffer[64];
+};
+
+void use(const Big &);
+
+// Full-expression temporaries get lifetime markers, and the end marker comes
+// after the temporary's destructor.
+// CHECK-LABEL: define void @_Z4testv
+// CHECK: [[TMP:%.+]] = alloca %struct.Big
+// CHECK: [[CAST:%.+]] = bitcast %struct.Big* [[TMP]] to i8*
+// CHECK: call void @llvm.lifetime.start(i64 64, i8* [[CAST]])
+// CHECK: call void @_ZN3BigC1Ev(%struct.Big* [[TMP]])
+// CHECK: call void @_Z3useRK3Big(%struct.Big* {{.*}}[[TMP]])
+// CHECK: call void @_ZN3BigD1Ev(%struct.Big* [[TMP]])
+// CHECK: [[CAST2:%.+]] = bitcast %struct.Big* [[TMP]] to i8*
+// CHECK: call void @llvm.lifetime.end(i64 64, i8* [[CAST2]])
+// CHECK: ret void
+
+// O0-NOT: @llvm.lifetime.start
+void test() {
+  use(Big());
+}
+
+// Lifetime-extended temporaries live as long as the reference, so they are
+// not marked as full-expression temporaries.
+// CHECK-LABEL: define void @_Z8extendedv
+// CHECK-NOT: @llvm.lifetime.start
+// CHECK: ret void
+void extended() {
+  const Big &b = Big();
+  use(b);
+}
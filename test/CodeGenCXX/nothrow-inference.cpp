@@ -0,0 +1,63 @@
+// RUN: %clang_cc1 -std=c++11 -triple x86_64-linux-gnu -fcxx-exceptions -fexceptions -emit-llvm -o - %s | FileCheck %s
+
+// Calls to functions defined in this TU whose bodies can't throw don't need
+// landing pads.
+
+struct S { ~S(); };
+
+int leaf(int x) { return x * 2; }
+int calls_leaf(int x) { return leaf(x) + 1; }
+
+void may_throw();
+int calls_unknown(int x) { may_throw(); return x; }
+
+int with_local(int x) { S s; return x; }
+
+int recursive(int x) { return x ? recursive(x - 1) : 0; }
+
+int throws(int x) {
+  if (x)
+    throw x;
+  return 0;
+}
+
+// Implicit code is checked too.
+struct Range { int *begin(); int *end(); };
+int range_for(Range &r) {
+  int n = 0;
+  for (int i : r)
+    n += i;
+  return n;
+}
+
+struct Thrower { Thrower(); };
+struct Agg { int a; Thrower t; };
+int omitted_member(int x) { Agg g = { x }; return g.a; }
+
+int make();
+thread_local int tls = make();
+int reads_tls() { return tls; }
+
+// CHECK-LABEL: define void @_Z4testv()
+void test() {
+  S s;
+  // CHECK: call i32 @_Z4leafi(i32 1)
+  leaf(1);
+  // CHECK: call i32 @_Z10calls_leafi(i32 2)
+  calls_leaf(2);
+  // CHECK: invoke i32 @_Z13calls_unknowni(i32 3)
+  calls_unknown(3);
+  // CHECK: invoke i32 @_Z10with_locali(i32 4)
+  with_local(4);
+  // CHECK: invoke i32 @_Z9recursivei(i32 5)
+  recursive(5);
+  // CHECK: invoke i32 @_Z6throwsi(i32 6)
+  throws(6);
+  // CHECK: invoke i32 @_Z9range_forR5Range(
+  Range r;
+  range_for(r);
+  // CHECK: invoke i32 @_Z14omitted_memberi(i32 7)
+  omitted_member(7);
+  // CHECK: invoke i32 @_Z9reads_tlsv()
+  reads_tls();
+}
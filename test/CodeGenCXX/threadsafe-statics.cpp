@@ -7,6 +7,7 @@ int f();
 // WITH-TSS: @_ZGVZ1gvE1a = internal global i64 0
 
 // WITH-TSS: define void @_Z1gv() [[NUW:#[0-9]+]]
+// WITH-TSS: br i1 %guard.uninitialized, label %init.check, label %init.end, !prof [[GUARD_PROF:![0-9]+]]
 // WITH-TSS: call i32 @__cxa_guard_acquire
 // WITH-TSS: call void @__cxa_guard_release
 // WITH-TSS: ret void
@@ -25,3 +26,5 @@ void g() {
 // WITH-TSS: attributes [[NUW]] = { nounwind{{.*}} }
 
 // NO-TSS: attributes [[NUW]] = { nounwind{{.*}} }
+
+// WITH-TSS: [[GUARD_PROF]] = metadata !{metadata !"branch_weights", i32 1, i32 1048575}
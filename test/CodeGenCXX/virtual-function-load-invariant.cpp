@@ -0,0 +1,20 @@
+// RUN: %clang_cc1 %s -triple x86_64-unknown-linux -O1 -disable-llvm-optzns -emit-llvm -o - | FileCheck %s
+// RUN: %clang_cc1 %s -triple x86_64-unknown-linux -emit-llvm -o - | FileCheck --check-prefix=CHECK-O0 %s
+
+struct A {
+  virtual void f();
+};
+
+// Loads of virtual function pointers out of the vtable are invariant.
+// CHECK-LABEL: define void @_Z4testP1Ai
+// CHECK: [[VFN:%.+]] = getelementptr inbounds void (%struct.A*)** %{{.*}}, i64 0
+// CHECK: load void (%struct.A*)** [[VFN]], !invariant.load [[EMPTY:!.+]]
+// CHECK: [[EMPTY]] = metadata !{}
+
+// CHECK-O0-LABEL: define void @_Z4testP1Ai
+// CHECK-O0-NOT: !invariant.load
+// CHECK-O0: ret void
+void test(A *a, int n) {
+  for (int i = 0; i < n; ++i)
+    a->f();
+}
@@ -243,3 +243,8 @@
 // CHECK-WCHAR1-NOT: -fshort-wchar
 // CHECK-WCHAR2: -fshort-wchar
 // CHECK-WCHAR2-NOT: -fno-short-wchar
+
+// RUN: %clang -### -S -fspell-checking-limit=5 %s 2>&1 | FileCheck -check-prefix=CHECK-SPELL-LIMIT %s
+// RUN: %clang -### -S %s 2>&1 | FileCheck -check-prefix=CHECK-NO-SPELL-LIMIT %s
+// CHECK-SPELL-LIMIT: "-fspell-checking-limit" "5"
+// CHECK-NO-SPELL-LIMIT-NOT: -fspell-checking-limit
@@ -0,0 +1,14 @@
+// RUN: %clang -### -fintegrated-cc1 -c %s 2>&1 | FileCheck %s
+// RUN: %clang -### -fno-integrated-cc1 -c %s 2>&1 | FileCheck %s
+// CHECK-NOT: argument unused during compilation
+// CHECK: "-cc1"
+
+// A lone -cc1 job runs in the driver process and gives the same result.
+// RUN: %clang -fintegrated-cc1 -fsyntax-only %s
+// RUN: not %clang -fintegrated-cc1 -fsyntax-only -DERROR %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=CHECK-ERROR %s
+// CHECK-ERROR: error: in-process error
+
+#ifdef ERROR
+#error in-process error
+#endif
@@ -19,3 +19,10 @@
 
 // RUN: %clang -fmodules-validate-system-headers -### %s 2>&1 | FileCheck -check-prefix=MODULES_VALIDATE_SYSTEM_HEADERS %s
 // MODULES_VALIDATE_SYSTEM_HEADERS: -fmodules-validate-system-headers
+
+// RUN: %clang -### %s 2>&1 | FileCheck -check-prefix=MODULES_LAZY_MODULE_MAPS_DEFAULT %s
+// MODULES_LAZY_MODULE_MAPS_DEFAULT-NOT: -fmodules-lazy-module-maps
+
+// RUN: %clang -fmodules-lazy-module-maps -### %s 2>&1 | FileCheck -check-prefix=MODULES_LAZY_MODULE_MAPS %s
+// MODULES_LAZY_MODULE_MAPS: "-cc1"
+// MODULES_LAZY_MODULE_MAPS: "-fmodules-lazy-module-maps"
@@ -0,0 +1,11 @@
+// RUN: %clang -### -parallel-jobs=4 -c %s %s 2>&1 | FileCheck %s
+// CHECK-NOT: argument unused during compilation
+
+// RUN: not %clang -### -parallel-jobs=0 -c %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=CHECK-INVALID %s
+// CHECK-INVALID: invalid integral value '0' in '-parallel-jobs=0'
+
+// Independent commands can run at once; the result is the same.
+// RUN: %clang -parallel-jobs=2 -fsyntax-only %s %s
+
+int x;
@@ -0,0 +1 @@
+int dependency_hash_x;
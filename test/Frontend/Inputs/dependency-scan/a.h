@@ -0,0 +1,5 @@
+#ifndef A_H
+#define A_H
+#define USE_B 1
+int a(void);
+#endif
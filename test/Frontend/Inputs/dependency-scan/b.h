@@ -0,0 +1,4 @@
+/* A directive-looking line inside a comment must not be handled:
+#include "not-here.h"
+*/
+const char *s = "#include \"not-here.h\"";
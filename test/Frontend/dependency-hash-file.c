@@ -0,0 +1,10 @@
+// RUN: %clang_cc1 -fsyntax-only -I %S/Inputs -dependency-hash-file %t.deps %s
+// RUN: FileCheck %s < %t.deps
+
+// CHECK: {{^[0-9a-f]{32}}} input {{.*}}dependency-hash-file.c
+// CHECK-NEXT: {{^}}d3089fdb1b244f5fdee6e3c430174c12 input {{.*}}Inputs{{/|\\}}dependency-hash.h
+// CHECK-NOT: input
+
+#include "dependency-hash.h"
+
+int y = dependency_hash_x;
@@ -0,0 +1,21 @@
+// RUN: %clang_cc1 -dependency-scan -I %S/Inputs/dependency-scan \
+// RUN:   -dependency-file - -MT dependency-scan.o %s | FileCheck %s
+
+// CHECK: dependency-scan.o:
+// CHECK: dependency-scan.c
+// CHECK: a.h
+// CHECK: b.h
+// CHECK-NOT: not-here.h
+// CHECK-NOT: c.h
+
+#include "a.h"
+#include "a.h"
+
+#define NOT_A_DIRECTIVE(x) x
+NOT_A_DIRECTIVE(int) f(void) { return 0; } # include "not-here.h"
+
+#if USE_B
+#include "b.h"
+#else
+#include "c.h"
+#endif
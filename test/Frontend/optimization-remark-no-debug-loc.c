@@ -0,0 +1,16 @@
+// This file tests -Rpass diagnostics for instructions that carry no debug
+// location at all. They are reported at the closing brace of the enclosing
+// function, without a note about an untranslatable location.
+
+// RUN: %clang_cc1 %s -Rpass=inline -emit-llvm-only -verify
+
+int foo(int x, int y) __attribute__((always_inline));
+int foo(int x, int y) { return x + y; }
+
+// The body of a nodebug function gets no debug locations, even though -Rpass
+// turns on location tracking.
+int bar(int j) __attribute__((nodebug));
+int bar(int j) {
+  return foo(j, j - 2);
+// expected-remark@+1 {{foo inlined into bar}}
+}
@@ -0,0 +1,5 @@
+// RUN: %clang_cc1 -fsyntax-only -print-memory-usage %s 2>&1 | FileCheck %s
+
+// CHECK: {"ast": {{[0-9]+}}, "ast_side_tables": {{[0-9]+}}, "identifiers": {{[0-9]+}}, "selectors": {{[0-9]+}}, "source_manager_content_cache": {{[0-9]+}}, "source_manager_data_structures": {{[0-9]+}}, "source_buffers_malloc": {{[0-9]+}}, "source_buffers_mmap": {{[0-9]+}}, "preprocessor": {{[0-9]+}}, "header_search": {{[0-9]+}}}
+
+int x;
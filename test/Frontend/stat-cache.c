@@ -0,0 +1,13 @@
+// RUN: rm -f %t.cache
+// RUN: %clang_cc1 -fsyntax-only -I %S -stat-cache %t.cache -stat-cache-epoch build-1 %s
+// RUN: FileCheck %s < %t.cache
+// RUN: %clang_cc1 -fsyntax-only -I %S -stat-cache %t.cache -stat-cache-epoch build-1 %s
+// RUN: FileCheck %s < %t.cache
+
+// CHECK: CLANG-STAT-CACHE-2 build-1
+// CHECK-DAG: f {{.*}}stat-cache-missing.h
+// CHECK-DAG: + {{[0-9 ]+}}{{.*}}stat-cache.c{{$}}
+
+#if __has_include("stat-cache-missing.h")
+#error the header should not be found
+#endif
@@ -0,0 +1,26 @@
+// RUN: %clang_cc1 -Eonly -trigraphs -verify %s
+
+// These comments are long enough to exercise the vectorized comment scanning
+// paths in the lexer; the interesting characters land at varying offsets.
+
+// A long line comment that runs on for well over sixteen bytes of text....\
+#error escaped newline continues the comment
+
+// A long line comment that runs on for well over sixteen bytes of text...??/
+#error trigraph escaped newline continues the comment
+
+// A long line comment that runs on for well over sixteen bytes of text \   
+#error whitespace before the newline
+// expected-warning@-2 {{backslash and newline separated by space}}
+
+/* A long block comment with slashes / that / do / not end it and stars * that
+   do not end it either ********************************************************
+   until the final one. */
+
+/****************************************************************************
+ * /* nested comment start expected-warning {{within block comment}}
+ ****************************************************************************/
+
+// A long line comment that runs on for well over sixteen bytes of text.....
+#error end
+// expected-error@-1 {{end}}
@@ -0,0 +1,17 @@
+// RUN: clang-benchmarks -scale=10 -iterations=1 -json | FileCheck %s
+// RUN: clang-benchmarks -scale=10 -iterations=1 -filter=lexer 2>&1 \
+// RUN:   | FileCheck -check-prefix=TABLE %s
+
+// CHECK: {
+// CHECK-NEXT: "benchmarks": [
+// CHECK-NEXT: { "name": "lexer-raw-tokens", "items": {{[0-9]+}}, "iterations": 1, "min_seconds": {{[0-9.]+}}, "median_seconds": {{[0-9.]+}}, "max_seconds": {{[0-9.]+}} },
+// CHECK-NEXT: { "name": "sourcemanager-getfileid", "items": 100,
+// CHECK-NEXT: { "name": "format-reformat",
+// CHECK-NEXT: { "name": "astmatchers-match",
+// CHECK-NOT: ast-file-load
+// CHECK: ]
+// CHECK-NEXT: }
+
+// TABLE: benchmark
+// TABLE-NEXT: lexer-raw-tokens
+// TABLE-NOT: format-reformat
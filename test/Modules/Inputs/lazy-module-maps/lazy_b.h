@@ -0,0 +1 @@
+void lazy_b(void);
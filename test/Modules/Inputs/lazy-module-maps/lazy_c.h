@@ -0,0 +1 @@
+#include "lazy_c_1.h"
@@ -0,0 +1 @@
+void lazy_c(void);
@@ -0,0 +1,16 @@
+// REQUIRES: shell
+// RUN: rm -rf %t
+// RUN: mkdir -p %t/cache
+// RUN: echo '// A' > %t/A.h
+// RUN: echo 'module A { header "A.h" }' > %t/module.modulemap
+
+// Pretend that this shell is building module A, and give the lock up after
+// the compiler has started waiting for it. The module never appears, so the
+// import fails once the wait is over.
+// RUN: echo "`hostname` $$" > %t/cache/A.pcm.lock
+// RUN: sh -c '(sleep 2; rm -f %t/cache/A.pcm.lock) &'
+// RUN: %clang_cc1 -fmodules -fmodules-cache-path=%t/cache \
+// RUN:            -fdisable-module-hash -fsyntax-only %s -verify -I %t \
+// RUN:            -Wmodule-build
+
+@import A; // expected-remark{{for another process to build module 'A'}} expected-error{{could not build module 'A'}}
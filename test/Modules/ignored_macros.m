@@ -33,6 +33,12 @@
 // RUN: %clang_cc1 -fmodules-cache-path=%t.modules -DIGNORED=1 -fmodules-ignore-macro=IGNORED=1 -fmodules -I %S/Inputs -emit-pch -o %t.pch -x objective-c-header %s -verify
 // RUN: %clang_cc1 -fmodules-cache-path=%t.modules -DIGNORED=1 -fmodules -I %S/Inputs -include-pch %t.pch -fmodules-ignore-macro=IGNORED=1 -DNO_IGNORED_ANYWHERE -fmodules-ignore-macro=NO_IGNORED_ANYWHERE %s -verify
 
+// Sixth trial: pass the same macros in a different order, and repeat one.
+// Both invocations should use the same module.
+// RUN: rm -rf %t.modules
+// RUN: %clang_cc1 -fmodules-cache-path=%t.modules -DA=1 -DB=2 -fmodules -I %S/Inputs -emit-pch -o %t.pch -x objective-c-header %s -verify
+// RUN: %clang_cc1 -fmodules-cache-path=%t.modules -DB=2 -DA=1 -DB=2 -fmodules -I %S/Inputs -include-pch %t.pch %s -verify
+
 // expected-no-diagnostics
 
 #ifndef HEADER
@@ -0,0 +1,15 @@
+// RUN: rm -rf %t
+// RUN: %clang_cc1 -fmodules -fmodules-cache-path=%t -fmodules-lazy-module-maps -I %S/Inputs/lazy-module-maps-broken %s -verify
+// RUN: not %clang_cc1 -fmodules -fmodules-cache-path=%t -I %S/Inputs/lazy-module-maps-broken %s 2>&1 | FileCheck %s
+// expected-no-diagnostics
+
+// The body of LazyBroken is never needed, so with lazy module maps it is
+// never parsed and its error is not reported. Loading the module map
+// eagerly reports it.
+// CHECK: module.map:6:3: error: expected umbrella, header, submodule, or module export
+
+@import LazyGood;
+
+void test() {
+  lazy_good();
+}
@@ -0,0 +1,19 @@
+// RUN: rm -rf %t
+// RUN: %clang_cc1 -fmodules -fmodules-cache-path=%t -fmodules-lazy-module-maps -I %S/Inputs/lazy-module-maps %s -verify
+// RUN: %clang_cc1 -fmodules -fmodules-cache-path=%t -I %S/Inputs/lazy-module-maps %s -verify
+// expected-no-diagnostics
+
+// Found by name.
+@import LazyA;
+
+// Found through one of its headers.
+#include "lazy_b_sub.h"
+
+// Found through its umbrella header's directory.
+#include "lazy_c_1.h"
+
+void test() {
+  lazy_a();
+  lazy_b_sub();
+  lazy_c();
+}
@@ -0,0 +1,6 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c -emit-llvm %s -o -
+
+void sum(int *s, int v) {
+#pragma omp atomic // expected-error {{cannot compile this 'omp atomic' directive yet}}
+  *s += v;
+}
@@ -0,0 +1,12 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o - | FileCheck %s
+// expected-no-diagnostics
+
+// CHECK-DAG: [[EXPLICIT_BARRIER_LOC:@.+]] = {{.+}} %ident_t { i32 0, i32 34, i32 0, i32 0, i8*
+
+// CHECK-LABEL: @main
+int main() {
+// CHECK: [[GTID:%.+]] = call i32 @__kmpc_global_thread_num(%ident_t* {{@.+}})
+// CHECK: call void @__kmpc_barrier(%ident_t* [[EXPLICIT_BARRIER_LOC]], i32 [[GTID]])
+#pragma omp barrier
+  return 0;
+}
@@ -0,0 +1,26 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o - | FileCheck %s
+// expected-no-diagnostics
+
+// CHECK-DAG: [[UNNAMED_LOCK:@.+gomp_critical_user_.var]] = common global [8 x i32] zeroinitializer
+// CHECK-DAG: [[THE_NAME_LOCK:@.+gomp_critical_user_the_name.var]] = common global [8 x i32] zeroinitializer
+
+void foo();
+
+// CHECK-LABEL: @main
+int main() {
+// CHECK:       [[GTID:%.+]] = call i32 @__kmpc_global_thread_num(%ident_t* [[LOC:@.+]])
+// CHECK:       call void @__kmpc_critical(%ident_t* [[LOC]], i32 [[GTID]], [8 x i32]* [[UNNAMED_LOCK]])
+// CHECK-NEXT:  call void {{.*}}foo
+// CHECK-NEXT:  call void @__kmpc_end_critical(%ident_t* [[LOC]], i32 [[GTID]], [8 x i32]* [[UNNAMED_LOCK]])
+#pragma omp critical
+  foo();
+// CHECK:       call void @__kmpc_critical(%ident_t* [[LOC]], i32 [[GTID]], [8 x i32]* [[THE_NAME_LOCK]])
+// CHECK-NEXT:  call void {{.*}}foo
+// CHECK-NEXT:  call void @__kmpc_end_critical(%ident_t* [[LOC]], i32 [[GTID]], [8 x i32]* [[THE_NAME_LOCK]])
+#pragma omp critical(the_name)
+  foo();
+// CHECK:       call void @__kmpc_critical(%ident_t* [[LOC]], i32 [[GTID]], [8 x i32]* [[THE_NAME_LOCK]])
+#pragma omp critical(the_name)
+  foo();
+  return 0;
+}
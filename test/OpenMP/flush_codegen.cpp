@@ -0,0 +1,13 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o - | FileCheck %s
+// expected-no-diagnostics
+
+int a;
+
+// CHECK-LABEL: @main
+int main() {
+// CHECK: fence seq_cst
+#pragma omp flush
+// CHECK: fence seq_cst
+#pragma omp flush(a)
+  return a;
+}
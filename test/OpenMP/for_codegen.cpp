@@ -0,0 +1,13 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o -
+
+void without_schedule_clause(float *a, int n) {
+#pragma omp for // expected-error {{cannot compile this 'omp for' directive yet}}
+  for (int i = 0; i < n; ++i)
+    a[i] = 0;
+}
+
+void parallel_for(float *a, int n) {
+#pragma omp parallel for // expected-error {{cannot compile this 'omp parallel for' directive yet}}
+  for (int i = 0; i < n; ++i)
+    a[i] = 0;
+}
@@ -0,0 +1,20 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o - | FileCheck %s
+// expected-no-diagnostics
+
+void foo();
+
+// CHECK-LABEL: @main
+int main() {
+// CHECK:       [[GTID:%.+]] = call i32 @__kmpc_global_thread_num(%ident_t* [[LOC:@.+]])
+// CHECK:       [[RES:%.+]] = call i32 @__kmpc_master(%ident_t* [[LOC]], i32 [[GTID]])
+// CHECK-NEXT:  [[IS_MASTER:%.+]] = icmp ne i32 [[RES]], 0
+// CHECK-NEXT:  br i1 [[IS_MASTER]], label {{%?}}[[THEN:.+]], label {{%?}}[[EXIT:.+]]
+// CHECK:       [[THEN]]
+// CHECK-NEXT:  call void {{.*}}foo
+// CHECK-NEXT:  call void @__kmpc_end_master(%ident_t* [[LOC]], i32 [[GTID]])
+// CHECK-NEXT:  br label {{%?}}[[EXIT]]
+// CHECK:       [[EXIT]]
+#pragma omp master
+  foo();
+  return 0;
+}
@@ -0,0 +1,56 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o - | FileCheck %s
+// expected-no-diagnostics
+
+void foo();
+void bar();
+
+// CHECK-LABEL: @main
+int main() {
+// CHECK:       [[GTID:%.+]] = call i32 @__kmpc_global_thread_num(%ident_t* [[LOC:@.+]])
+// CHECK:       call void @__kmpc_dispatch_init_4(%ident_t* [[LOC]], i32 [[GTID]], i32 35, i32 0, i32 1, i32 1, i32 1)
+// CHECK:       [[DISPATCH:.+]]:
+// CHECK-NEXT:  [[HAS_WORK:%.+]] = call i32 @__kmpc_dispatch_next_4(%ident_t* [[LOC]], i32 [[GTID]], i32* {{%.+}}, i32* [[LB:%.+]], i32* [[UB:%.+]], i32* {{%.+}})
+// CHECK:       icmp ne i32 [[HAS_WORK]], 0
+// CHECK:       icmp sle i32
+// CHECK:       switch i32 {{%.+}}, label {{%?}}[[INC:.+]] [
+// CHECK-NEXT:    i32 0, label {{%?}}[[CASE0:.+]]
+// CHECK-NEXT:    i32 1, label {{%?}}[[CASE1:.+]]
+// CHECK-NEXT:  ]
+// CHECK:       [[CASE0]]
+// CHECK-NEXT:  call void {{.*}}foo
+// CHECK:       [[CASE1]]
+// CHECK-NEXT:  call void {{.*}}bar
+// CHECK:       call void @__kmpc_barrier(%ident_t* {{@.+}}, i32 [[GTID]])
+#pragma omp sections
+  {
+    foo();
+#pragma omp section
+    bar();
+  }
+// CHECK:       call void @__kmpc_dispatch_init_4(
+// CHECK:       call i32 @__kmpc_dispatch_next_4(
+// CHECK-NOT:   call void @__kmpc_barrier(
+// CHECK:       ret
+#pragma omp sections nowait
+  {
+#pragma omp section
+    foo();
+  }
+  return 0;
+}
+
+// CHECK-LABEL: define {{.*}}parallel_sections
+void parallel_sections() {
+// CHECK:       call void {{.*}}@__kmpc_fork_call(
+#pragma omp parallel sections
+  {
+    foo();
+#pragma omp section
+    bar();
+  }
+}
+
+// CHECK:       define internal void @__captured_stmt
+// CHECK:       call void @__kmpc_dispatch_init_4(
+// CHECK:       call i32 @__kmpc_dispatch_next_4(
+// CHECK:       call void @__kmpc_barrier(
@@ -0,0 +1,24 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o -
+
+void foo();
+
+void sections_private(int x) {
+#pragma omp sections private(x) // expected-error {{cannot compile this 'omp sections' directive with this clause yet}}
+  {
+    foo();
+  }
+}
+
+void parallel_sections_num_threads() {
+#pragma omp parallel sections num_threads(2) // expected-error {{cannot compile this 'omp parallel sections' directive with this clause yet}}
+  {
+    foo();
+  }
+}
+
+void parallel_sections_private(int x) {
+#pragma omp parallel sections private(x) // expected-error {{cannot compile this 'omp parallel sections' directive with this clause yet}}
+  {
+    foo();
+  }
+}
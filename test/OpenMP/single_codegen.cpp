@@ -0,0 +1,27 @@
+// RUN: %clang_cc1 -verify -fopenmp=libiomp5 -x c++ -emit-llvm %s -o - | FileCheck %s
+// expected-no-diagnostics
+
+void foo();
+
+// CHECK-LABEL: @main
+int main() {
+// CHECK:       [[GTID:%.+]] = call i32 @__kmpc_global_thread_num(%ident_t* [[LOC:@.+]])
+// CHECK:       [[RES:%.+]] = call i32 @__kmpc_single(%ident_t* [[LOC]], i32 [[GTID]])
+// CHECK-NEXT:  [[IS_SINGLE:%.+]] = icmp ne i32 [[RES]], 0
+// CHECK-NEXT:  br i1 [[IS_SINGLE]], label {{%?}}[[THEN:.+]], label {{%?}}[[EXIT:.+]]
+// CHECK:       [[THEN]]
+// CHECK-NEXT:  call void {{.*}}foo
+// CHECK-NEXT:  call void @__kmpc_end_single(%ident_t* [[LOC]], i32 [[GTID]])
+// CHECK-NEXT:  br label {{%?}}[[EXIT]]
+// CHECK:       [[EXIT]]
+// CHECK-NEXT:  call void @__kmpc_barrier(%ident_t* {{@.+}}, i32 [[GTID]])
+#pragma omp single
+  foo();
+// CHECK:       call i32 @__kmpc_single(
+// CHECK:       call void @__kmpc_end_single(
+// CHECK-NOT:   call void @__kmpc_barrier(
+// CHECK:       ret
+#pragma omp single nowait
+  foo();
+  return 0;
+}
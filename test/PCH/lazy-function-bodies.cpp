@@ -0,0 +1,13 @@
+// Test that inline function bodies in a PCH are only loaded when used.
+
+// RUN: %clang_cc1 -x c++-header -emit-pch -o %t %s
+// RUN: %clang_cc1 -include-pch %t -emit-llvm -o /dev/null -print-stats -DMAIN %s 2>&1 | FileCheck %s
+
+// CHECK: 1/2 function bodies read
+
+#ifndef MAIN
+inline int used() { return 1; }
+inline int unused() { return 2; }
+#else
+int main() { return used(); }
+#endif
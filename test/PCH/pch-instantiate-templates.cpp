@@ -0,0 +1,36 @@
+// Without -fpch-instantiate-templates, instantiations needed by the header
+// are left to each translation unit that includes the PCH.
+// RUN: %clang_cc1 -x c++-header -emit-pch -DBAD -o %t.bad.pch %s 2>&1 \
+// RUN:   | FileCheck -allow-empty -check-prefix=CHECK-DEFERRED %s
+// RUN: not %clang_cc1 -include-pch %t.bad.pch -DBAD -fsyntax-only %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=CHECK-BAD %s
+// CHECK-DEFERRED-NOT: error:
+
+// With it, they are performed when the PCH is built.
+// RUN: not %clang_cc1 -x c++-header -emit-pch -fpch-instantiate-templates \
+// RUN:   -DBAD -o %t.bad.pch %s 2>&1 | FileCheck -check-prefix=CHECK-BAD %s
+
+// The instantiated definition is reused from the PCH.
+// RUN: %clang_cc1 -x c++-header -emit-pch -fpch-instantiate-templates \
+// RUN:   -o %t.pch %s
+// RUN: %clang_cc1 -include-pch %t.pch -triple x86_64-unknown-unknown \
+// RUN:   -emit-llvm -o - %s | FileCheck %s
+
+#ifndef HEADER
+#define HEADER
+
+template <typename T> T twice(T t) { return t + t; }
+inline int useTwice() { return twice(21); }
+
+#ifdef BAD
+template <typename T> int member(T t) { return t.value; }
+// CHECK-BAD: error: member reference base type 'int' is not a structure or union
+inline int useMember() { return member(0); }
+#endif
+
+#else
+
+int main() { return useTwice(); }
+// CHECK: define linkonce_odr i32 @_Z5twiceIiET_S0_(
+
+#endif
@@ -0,0 +1,9 @@
+// RUN: %clang_cc1 -emit-pch -o %t.pch %S/Inputs/chain-decls1.h
+// RUN: %clang_cc1 -include-pch %t.pch -fsyntax-only -ftime-report %s 2>&1 \
+// RUN:   | FileCheck %s
+
+// CHECK: Clang front-end time report
+// CHECK-DAG: Clang front-end timer
+// CHECK-DAG: AST file loading
+
+int x;
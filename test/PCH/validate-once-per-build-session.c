@@ -0,0 +1,18 @@
+// RUN: rm -rf %t
+// RUN: mkdir -p %t
+// RUN: echo 'void meow(void);' > %t/foo.h
+// RUN: %clang_cc1 -x c-header -emit-pch -o %t/foo.pch %t/foo.h
+
+// Change the header after the precompiled header was built.
+// RUN: echo 'void meow(void); void purr(void);' > %t/foo.h
+
+// A PCH built during the current build session is not revalidated.
+// RUN: %clang_cc1 -include-pch %t/foo.pch -fsyntax-only -fbuild-session-timestamp=1390000000 -fmodules-validate-once-per-build-session %s
+
+// Otherwise, the change is noticed.
+// RUN: not %clang_cc1 -include-pch %t/foo.pch -fsyntax-only %s 2>&1 | FileCheck %s
+// RUN: not %clang_cc1 -include-pch %t/foo.pch -fsyntax-only -fbuild-session-timestamp=4102444800 -fmodules-validate-once-per-build-session %s 2>&1 | FileCheck %s
+
+// CHECK: has been modified since the precompiled header
+
+void f(void) { meow(); }
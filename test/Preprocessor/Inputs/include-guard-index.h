@@ -0,0 +1,4 @@
+#ifndef INCLUDE_GUARD_INDEX_H
+#define INCLUDE_GUARD_INDEX_H
+int guarded_declaration;
+#endif
@@ -0,0 +1 @@
+int shadowed_quote;
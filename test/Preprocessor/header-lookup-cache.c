@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -E -iquote %S/Inputs/lookup-cache/quote \
+// RUN:   -I %S/Inputs/lookup-cache/angled %s | FileCheck %s
+
+// A quoted lookup starts before the angled directories.  Its result can be
+// reused by an angled lookup only if it was found in an angled directory.
+
+// CHECK: int only_angled;
+#include "only-angled.h"
+// CHECK: int only_angled;
+#include <only-angled.h>
+
+// CHECK: int shadowed_quote;
+#include "shadowed.h"
+// CHECK: int shadowed_angled;
+#include <shadowed.h>
+// CHECK: int shadowed_quote;
+#include "shadowed.h"
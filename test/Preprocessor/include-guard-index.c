@@ -0,0 +1,36 @@
+// RUN: rm -f %t.idx
+// RUN: %clang_cc1 -E -include-guard-index %t.idx -I %S/Inputs %s | FileCheck -check-prefix=FIRST %s
+// RUN: FileCheck -check-prefix=INDEX %s < %t.idx
+
+// Without the index, the header has to be entered to find out that defining
+// its guard macro makes it empty.
+// RUN: %clang_cc1 -E -DINCLUDE_GUARD_INDEX_H -I %S/Inputs %s | FileCheck -check-prefix=ENTERED %s
+
+// With the index, it is skipped without being entered.
+// RUN: %clang_cc1 -E -DINCLUDE_GUARD_INDEX_H -include-guard-index %t.idx -I %S/Inputs %s | FileCheck -check-prefix=SKIPPED %s
+
+// A header skipped through the index is still a dependency.
+// RUN: %clang_cc1 -E -DINCLUDE_GUARD_INDEX_H -include-guard-index %t.idx -I %S/Inputs %s \
+// RUN:   -MT out.o -dependency-file %t.d -dependency-hash-file %t.hash -o /dev/null
+// RUN: FileCheck -check-prefix=DEPS %s < %t.d
+// RUN: FileCheck -check-prefix=HASH %s < %t.hash
+
+#include "include-guard-index.h"
+#include "include-guard-index.h"
+
+// FIRST: int guarded_declaration;
+// FIRST-NOT: int guarded_declaration;
+
+// INDEX: CLANG-INCLUDE-GUARD-INDEX-1
+// INDEX: INCLUDE_GUARD_INDEX_H {{.*}}include-guard-index.h
+
+// ENTERED: include-guard-index.h" 1
+// ENTERED-NOT: guarded_declaration
+
+// SKIPPED-NOT: include-guard-index.h" 1
+// SKIPPED-NOT: guarded_declaration
+
+// DEPS: out.o:
+// DEPS: include-guard-index.h
+
+// HASH: - input {{.*}}include-guard-index.h
@@ -0,0 +1,16 @@
+// RUN: %clang_cc1 -E %s | FileCheck -strict-whitespace %s
+
+// Arguments used several times, with and without needing pre-expansion.
+#define ONE 1
+#define ID(x) x
+#define TWICE(a, b) a b a b
+#define PASTE(a, b) a ## b a b
+
+// CHECK: 1 2 1 2
+TWICE(ONE, 2)
+// CHECK: x y x y
+TWICE(x, ID(y))
+// CHECK: ONEONE 1 1
+PASTE(ONE, ONE)
+// CHECK: 1 y 1 y
+ID(TWICE(ID(ONE), y))
@@ -1,4 +1,7 @@
 // RUN: %clang_cc1 -fsyntax-only -detailed-preprocessing-record %s
+// RUN: %clang_cc1 -fsyntax-only -detailed-preprocessing-record -detailed-preprocessing-record-no-expansions %s
+// RUN: c-index-test -test-load-source all %s | FileCheck -check-prefix=RECORD %s
+// RUN: c-index-test -test-load-source all %s -Xclang -detailed-preprocessing-record-no-expansions | FileCheck -check-prefix=NO-EXPANSIONS %s
 
 // http://llvm.org/PR11120
 
@@ -32,3 +35,15 @@ FM3(
 #define M3 int x2
 )
 M3;
+
+// RECORD-DAG: macro definition=STRINGIZE
+// RECORD-DAG: macro expansion=STRINGIZE
+// RECORD-DAG: macro expansion=CAKE
+// RECORD-DAG: macro expansion=FM2
+// RECORD-DAG: macro expansion=M3
+
+// NO-EXPANSIONS-NOT: macro expansion=
+// NO-EXPANSIONS: inclusion directive=pp-record.h
+// NO-EXPANSIONS-NOT: macro expansion=
+// NO-EXPANSIONS: macro definition=M3
+// NO-EXPANSIONS-NOT: macro expansion=
@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -E -trigraphs %s | FileCheck -strict-whitespace %s
+
+// Punctuators keep their digraph spelling; trigraphs and escaped newlines
+// are cleaned.
+#define PASTE(a, b) a ## b
+
+// CHECK: a[0] <: b :> <% %>
+a[0] <: b :> <% %>
+// CHECK: x ->* y ... z
+x ->* y ... z
+// CHECK: c # d
+c ??= d
+// CHECK: e <<= f
+e <\
+<= f
+// CHECK: g += h
+g PASTE(+, =) h
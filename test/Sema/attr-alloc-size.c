@@ -0,0 +1,16 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+typedef __SIZE_TYPE__ size_t;
+
+void *my_malloc(size_t) __attribute__((alloc_size(1)));
+void *my_calloc(size_t, size_t) __attribute__((alloc_size(1, 2)));
+void *my_realloc(void *, int) __attribute__((alloc_size(2)));
+
+void *no_args(size_t) __attribute__((alloc_size)); // expected-error {{'alloc_size' attribute takes at least 1 argument}}
+void *too_many(size_t, size_t) __attribute__((alloc_size(1, 2, 3))); // expected-error {{'alloc_size' attribute takes no more than 2 arguments}}
+void *out_of_range(size_t) __attribute__((alloc_size(2))); // expected-error {{'alloc_size' attribute parameter 1 is out of bounds}}
+void *zero(size_t) __attribute__((alloc_size(0))); // expected-error {{'alloc_size' attribute parameter 1 is out of bounds}}
+void *not_constant(size_t n) __attribute__((alloc_size(n))); // expected-error {{'alloc_size' attribute requires parameter 1 to be an integer constant}}
+void *pointer_param(void *) __attribute__((alloc_size(1))); // expected-error {{'alloc_size' attribute argument may only refer to a function parameter of integer type}}
+int not_pointer(size_t) __attribute__((alloc_size(1))); // expected-warning {{'alloc_size' attribute only applies to return values that are pointers}}
+int var __attribute__((alloc_size(1))); // expected-warning {{'alloc_size' attribute only applies to functions}}
@@ -0,0 +1,8 @@
+// RUN: %clang_cc1 -fsyntax-only -fblocks -verify %s
+
+void f0(int *p __attribute__((noescape)));
+void f1(void (^b)(void) __attribute__((noescape)));
+void f2(int i __attribute__((noescape))); // expected-warning {{'noescape' attribute only applies to pointer arguments}}
+
+int g0 __attribute__((noescape)); // expected-warning {{'noescape' attribute only applies to parameters}}
+void f3(void) __attribute__((noescape)); // expected-warning {{'noescape' attribute only applies to parameters}}
@@ -0,0 +1,9 @@
+// RUN: %clang_cc1 -fsyntax-only -fspell-checking-limit 1 -verify %s
+
+int foobar; // expected-note{{'foobar' declared here}}
+int barbaz;
+
+void f() {
+  foobaz = 1; // expected-error{{use of undeclared identifier 'foobaz'; did you mean 'foobar'?}}
+  barbax = 2; // expected-error{{use of undeclared identifier 'barbax'}}
+}
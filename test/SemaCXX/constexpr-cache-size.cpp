@@ -0,0 +1,14 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s -fconstexpr-cache-size 16 -print-stats 2>&1 | FileCheck %s
+// expected-no-diagnostics
+
+constexpr unsigned hash(unsigned n) {
+  return n == 0 ? 5381 : hash(n - 1) * 33 + n;
+}
+
+// The first evaluation populates the cache; the rest reuse it.
+static_assert(hash(10) == hash(10), "");
+constexpr unsigned A = hash(10);
+constexpr unsigned B = hash(10);
+static_assert(A == B, "");
+
+// CHECK: constexpr calls found in the result cache
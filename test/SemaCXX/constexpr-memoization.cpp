@@ -0,0 +1,18 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s -fconstexpr-steps 1000
+
+// Repeated calls with the same integer arguments are only evaluated once per
+// constant expression, so this takes far fewer than 1000 steps.
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+static_assert(fib(90) == 2880067194370816120ULL, "");
+
+// Calls which fail are not remembered, and are diagnosed each time.
+constexpr int check(int n) {
+  return n > 0 ? n : throw 0; // expected-note {{subexpression}}
+}
+constexpr int twice(int n) {
+  return check(n) + check(n); // expected-note {{in call to 'check(0)'}}
+}
+static_assert(twice(1) == 2, "");
+static_assert(twice(0) == 0, ""); // expected-error {{constant expression}} expected-note {{in call to 'twice(0)'}}
@@ -0,0 +1,29 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -fsyntax-only -skip-vtable-definitions -DSKIP -verify %s
+// RUN: not %clang_cc1 -emit-llvm-only -skip-vtable-definitions %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=CODEGEN %s
+// RUN: not %clang_cc1 -emit-pch -skip-vtable-definitions -o %t %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=CODEGEN %s
+// CODEGEN: invalid argument '-skip-vtable-definitions' only allowed with '-fsyntax-only'
+
+#ifdef SKIP
+// expected-no-diagnostics
+#endif
+
+template <typename T> struct Base {
+  virtual void f() {
+    T::error;
+#ifndef SKIP
+    // expected-error@-2 {{type 'int' cannot be used prior to '::' because it has no members}}
+#endif
+  }
+};
+
+struct Derived : Base<int> {};
+
+void use() {
+  Derived d;
+#ifndef SKIP
+  // expected-note@-2 {{in instantiation of member function 'Base<int>::f' requested here}}
+#endif
+}
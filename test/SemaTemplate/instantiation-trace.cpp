@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -fsyntax-only -ftemplate-instantiation-trace=%t.json %s
+// RUN: FileCheck %s < %t.json
+
+namespace N {
+  template <typename T> struct S { T member; };
+}
+template <typename T> T f(T t) { return t; }
+
+N::S<int> s;
+int i = f(0);
+
+// CHECK: {"traceEvents": [
+// CHECK-DAG: "name": "TemplateInstantiation", "args": {"detail": "N::S<int>", "ast-bytes":
+// CHECK-DAG: "name": "DeducedTemplateArgumentSubstitution", "args": {"detail": "f"
+// CHECK-DAG: "name": "TemplateInstantiation", "args": {"detail": "f<int>", "ast-bytes":
+// CHECK-DAG: "name": "PerformPendingInstantiations", "args": {"detail": "", "ast-bytes":
+// CHECK: ]}
@@ -0,0 +1,319 @@
+//===-- clang-benchmarks/ClangBenchmarks.cpp - Frontend benchmarks --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Micro-benchmarks for hot paths of the Clang frontend.
+///
+/// Each benchmark runs on generated input whose size is controlled with
+/// -scale, and is timed over -iterations runs. The results can be printed as
+/// JSON, so that they can be recorded and compared across revisions.
+///
+//===----------------------------------------------------------------------===//
+
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Format/Format.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace clang;
+using namespace clang::ast_matchers;
+using namespace llvm;
+
+static cl::list<std::string>
+Filters("filter", cl::desc("Only run the benchmarks whose name contains this "
+                           "string (can be repeated)"),
+        cl::ZeroOrMore);
+
+static cl::opt<unsigned>
+Iterations("iterations", cl::desc("Number of timed runs of each benchmark"),
+           cl::init(5));
+
+static cl::opt<unsigned>
+Scale("scale", cl::desc("Size of the generated inputs"), cl::init(1000));
+
+static cl::opt<std::string>
+ASTFile("ast-file", cl::desc("AST file to load for the ast-file-load "
+                             "benchmark; without it, that benchmark is "
+                             "skipped"));
+
+static cl::opt<bool>
+JSONOutput("json", cl::desc("Print the results as JSON"));
+
+/// \brief Generate \p NumFunctions function definitions, written without any
+/// whitespace that the formatter would add.
+static std::string generateSource(unsigned NumFunctions) {
+  std::string Code;
+  raw_string_ostream OS(Code);
+  OS << "int function0(int a,int b);\n";
+  for (unsigned I = 0; I != NumFunctions; ++I)
+    OS << "int function" << I << "(int a,int b){int result=a*" << I
+       << "+b;if(result>0x" << I << "){return function"
+       << (I ? I - 1 : 0) << "(result,a);}return result;}\n";
+  return OS.str();
+}
+
+namespace {
+
+class Benchmark {
+public:
+  virtual ~Benchmark() {}
+
+  virtual const char *getName() const = 0;
+
+  /// \brief Prepare the benchmark's input, outside of the timed runs.
+  ///
+  /// \returns false if the benchmark can't be run.
+  virtual bool setUp() { return true; }
+
+  /// \brief Run the benchmark once.
+  ///
+  /// \returns the number of items (tokens, lookups, matches...) processed.
+  virtual unsigned run() = 0;
+};
+
+/// \brief Raw-lex a large buffer.
+class LexerBenchmark : public Benchmark {
+  std::string Code;
+
+public:
+  const char *getName() const override { return "lexer-raw-tokens"; }
+
+  bool setUp() override {
+    Code = generateSource(Scale);
+    return true;
+  }
+
+  unsigned run() override {
+    LangOptions LangOpts;
+    LangOpts.CPlusPlus = true;
+    const char *Begin = Code.c_str();
+    Lexer Lex(SourceLocation(), LangOpts, Begin, Begin, Begin + Code.size());
+    unsigned NumTokens = 0;
+    Token Tok;
+    do {
+      Lex.LexFromRawLexer(Tok);
+      ++NumTokens;
+    } while (Tok.isNot(tok::eof));
+    return NumTokens;
+  }
+};
+
+/// \brief Map locations in many files back to their FileIDs.
+class GetFileIDBenchmark : public Benchmark {
+  FileSystemOptions FileMgrOpts;
+  FileManager FileMgr;
+  IntrusiveRefCntPtr<DiagnosticIDs> DiagID;
+  DiagnosticsEngine Diags;
+  SourceManager SourceMgr;
+  std::vector<SourceLocation> Locs;
+
+public:
+  GetFileIDBenchmark()
+    : FileMgr(FileMgrOpts), DiagID(new DiagnosticIDs()),
+      Diags(DiagID, new DiagnosticOptions, new IgnoringDiagConsumer()),
+      SourceMgr(Diags, FileMgr) {}
+
+  const char *getName() const override { return "sourcemanager-getfileid"; }
+
+  bool setUp() override {
+    for (unsigned I = 0; I != Scale; ++I) {
+      std::string Name = ("file" + Twine(I) + ".h").str();
+      FileID FID = SourceMgr.createFileID(
+          MemoryBuffer::getMemBufferCopy("int x;\n", Name));
+      Locs.push_back(SourceMgr.getLocForStartOfFile(FID).getLocWithOffset(4));
+    }
+
+    // Shuffle the locations so that the lookups aren't all answered by the
+    // SourceManager's cache of the last FileID found.
+    unsigned Seed = 1;
+    for (unsigned I = Locs.size(); I > 1; --I) {
+      Seed = Seed * 1103515245 + 12345;
+      std::swap(Locs[I - 1], Locs[Seed % I]);
+    }
+    return true;
+  }
+
+  unsigned run() override {
+    unsigned NumLookups = 0;
+    for (unsigned Round = 0; Round != 10; ++Round)
+      for (SourceLocation Loc : Locs)
+        if (!SourceMgr.getFileID(Loc).isInvalid())
+          ++NumLookups;
+    return NumLookups;
+  }
+};
+
+/// \brief Reformat a large, unformatted buffer.
+class FormatBenchmark : public Benchmark {
+  std::string Code;
+
+public:
+  const char *getName() const override { return "format-reformat"; }
+
+  bool setUp() override {
+    Code = generateSource(Scale);
+    return true;
+  }
+
+  unsigned run() override {
+    std::vector<tooling::Range> Ranges(1, tooling::Range(0, Code.size()));
+    return format::reformat(format::getLLVMStyle(), Code, Ranges).size();
+  }
+};
+
+/// \brief Run a few AST matchers over a generated translation unit.
+class MatcherBenchmark : public Benchmark {
+  class CountMatches : public MatchFinder::MatchCallback {
+  public:
+    unsigned Count;
+    CountMatches() : Count(0) {}
+    void run(const MatchFinder::MatchResult &Result) override { ++Count; }
+  };
+
+  std::unique_ptr<ASTUnit> AST;
+
+public:
+  const char *getName() const override { return "astmatchers-match"; }
+
+  bool setUp() override {
+    AST = tooling::buildASTFromCode(generateSource(Scale));
+    return AST != nullptr;
+  }
+
+  unsigned run() override {
+    CountMatches Callback;
+    MatchFinder Finder;
+    Finder.addMatcher(callExpr(callee(functionDecl())).bind("call"),
+                      &Callback);
+    Finder.addMatcher(binaryOperator(hasOperatorName(">"),
+                                     hasLHS(declRefExpr())),
+                      &Callback);
+    Finder.addMatcher(functionDecl(isDefinition(), parameterCountIs(2)),
+                      &Callback);
+    Finder.matchAST(AST->getASTContext());
+    return Callback.Count;
+  }
+};
+
+/// \brief Load an existing AST file, such as a PCH.
+class ASTFileLoadBenchmark : public Benchmark {
+public:
+  const char *getName() const override { return "ast-file-load"; }
+
+  bool setUp() override { return !ASTFile.empty(); }
+
+  unsigned run() override {
+    IntrusiveRefCntPtr<DiagnosticsEngine> Diags =
+        CompilerInstance::createDiagnostics(new DiagnosticOptions());
+    std::unique_ptr<ASTUnit> Unit(
+        ASTUnit::LoadFromASTFile(ASTFile, Diags, FileSystemOptions()));
+    return Unit ? 1 : 0;
+  }
+};
+
+struct BenchmarkResult {
+  std::string Name;
+  unsigned Items;
+  std::vector<double> Times;
+};
+
+} // end anonymous namespace
+
+static bool isSelected(StringRef Name) {
+  if (Filters.empty())
+    return true;
+  for (const std::string &Filter : Filters)
+    if (Name.find(Filter) != StringRef::npos)
+      return true;
+  return false;
+}
+
+static void printResults(ArrayRef<BenchmarkResult> Results) {
+  raw_ostream &OS = outs();
+  if (!JSONOutput) {
+    OS << format("%-28s", "benchmark") << format(" %10s", "items")
+       << format(" %12s", "min (s)") << format(" %12s", "median (s)")
+       << format(" %12s", "max (s)") << "\n";
+    for (const BenchmarkResult &R : Results)
+      OS << format("%-28s", R.Name.c_str()) << format(" %10u", R.Items)
+         << format(" %12.6f", R.Times.front())
+         << format(" %12.6f", R.Times[R.Times.size() / 2])
+         << format(" %12.6f", R.Times.back()) << "\n";
+    return;
+  }
+
+  OS << "{\n  \"benchmarks\": [";
+  for (unsigned I = 0, E = Results.size(); I != E; ++I) {
+    const BenchmarkResult &R = Results[I];
+    OS << (I ? ",\n" : "\n");
+    OS << "    { \"name\": \"" << R.Name << "\", \"items\": " << R.Items
+       << ", \"iterations\": " << R.Times.size()
+       << format(", \"min_seconds\": %.6f", R.Times.front())
+       << format(", \"median_seconds\": %.6f", R.Times[R.Times.size() / 2])
+       << format(", \"max_seconds\": %.6f }", R.Times.back());
+  }
+  OS << "\n  ]\n}\n";
+}
+
+int main(int argc, const char **argv) {
+  sys::PrintStackTraceOnErrorSignal();
+  cl::ParseCommandLineOptions(argc, argv,
+                              "Micro-benchmarks for the Clang frontend\n");
+  if (!Iterations)
+    Iterations = 1;
+
+  std::vector<std::unique_ptr<Benchmark>> Benchmarks;
+  Benchmarks.emplace_back(new LexerBenchmark());
+  Benchmarks.emplace_back(new GetFileIDBenchmark());
+  Benchmarks.emplace_back(new FormatBenchmark());
+  Benchmarks.emplace_back(new MatcherBenchmark());
+  Benchmarks.emplace_back(new ASTFileLoadBenchmark());
+
+  std::vector<BenchmarkResult> Results;
+  for (const auto &B : Benchmarks) {
+    if (!isSelected(B->getName()))
+      continue;
+    if (!B->setUp()) {
+      errs() << "skipping " << B->getName() << "\n";
+      continue;
+    }
+
+    BenchmarkResult Result;
+    Result.Name = B->getName();
+    Result.Items = 0;
+    for (unsigned I = 0; I != Iterations; ++I) {
+      TimeRecord Start = TimeRecord::getCurrentTime(/*Start=*/true);
+      Result.Items = B->run();
+      TimeRecord End = TimeRecord::getCurrentTime(/*Start=*/false);
+      Result.Times.push_back(End.getWallTime() - Start.getWallTime());
+    }
+    std::sort(Result.Times.begin(), Result.Times.end());
+    Results.push_back(Result);
+  }
+
+  printResults(Results);
+  return 0;
+}
@@ -24,6 +24,7 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Signals.h"
 
 using namespace llvm;
@@ -202,6 +203,23 @@ static void outputReplacementXML(StringRef Text) {
   llvm::outs() << Text.substr(From);
 }
 
+// Returns the style for FileName. The style only depends on the directory the
+// file is in and on the language, which getStyle() derives from the extension,
+// so share it between files that agree on both instead of looking for and
+// parsing the configuration file again.
+static const FormatStyle &getCachedStyle(StringRef FileName) {
+  static llvm::StringMap<FormatStyle> StyleCache;
+  std::string Key = llvm::sys::path::parent_path(FileName).str();
+  Key += '\0';
+  Key += llvm::sys::path::extension(FileName);
+  llvm::StringMap<FormatStyle>::iterator I = StyleCache.find(Key);
+  if (I != StyleCache.end())
+    return I->getValue();
+  FormatStyle &Result = StyleCache[Key];
+  Result = getStyle(Style, FileName, FallbackStyle);
+  return Result;
+}
+
 // Returns true on error.
 static bool format(StringRef FileName) {
   FileManager Files((FileSystemOptions()));
@@ -223,8 +241,8 @@ static bool format(StringRef FileName) {
   if (fillRanges(Sources, ID, Code.get(), Ranges))
     return true;
 
-  FormatStyle FormatStyle = getStyle(
-      Style, (FileName == "-") ? AssumeFilename : FileName, FallbackStyle);
+  const FormatStyle &FormatStyle =
+      getCachedStyle((FileName == "-") ? AssumeFilename : FileName);
   Lexer Lex(ID, Sources.getBuffer(ID), Sources,
             getFormattingLangOpts(FormatStyle.Standard));
   tooling::Replacements Replaces = reformat(FormatStyle, Lex, Sources, Ranges);
@@ -241,18 +259,16 @@ static bool format(StringRef FileName) {
       llvm::outs() << "</replacement>\n";
     }
     llvm::outs() << "</replacements>\n";
-  } else {
+  } else if (Inplace) {
     Rewriter Rewrite(Sources, LangOptions());
     tooling::applyAllReplacements(Replaces, Rewrite);
-    if (Inplace) {
-      if (Rewrite.overwriteChangedFiles())
-        return true;
-    } else {
-      if (Cursor.getNumOccurrences() != 0)
-        outs() << "{ \"Cursor\": "
-               << tooling::shiftedCodePosition(Replaces, Cursor) << " }\n";
-      Rewrite.getEditBuffer(ID).write(outs());
-    }
+    if (Rewrite.overwriteChangedFiles())
+      return true;
+  } else {
+    if (Cursor.getNumOccurrences() != 0)
+      outs() << "{ \"Cursor\": "
+             << tooling::shiftedCodePosition(Replaces, Cursor) << " }\n";
+    outs() << tooling::applyAllReplacements(Code->getBuffer(), Replaces);
   }
   return false;
 }
@@ -27,6 +27,7 @@
 #include "llvm/LinkAllPasses.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptTable.h"
+#include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Signals.h"
@@ -41,6 +42,10 @@ using namespace llvm::opt;
 // Main driver
 //===----------------------------------------------------------------------===//
 
+/// The exit status that a fatal error requested while cc1_main_in_process was
+/// running, or 0 if there was none.
+static int FatalErrorRetCode = 0;
+
 static void LLVMErrorHandler(void *UserData, const std::string &Message,
                              bool GenCrashDiag) {
   DiagnosticsEngine &Diags = *static_cast<DiagnosticsEngine*>(UserData);
@@ -54,7 +59,16 @@ static void LLVMErrorHandler(void *UserData, const std::string &Message,
   // We cannot recover from llvm errors.  When reporting a fatal error, exit
   // with status 70 to generate crash diagnostics.  For BSD systems this is
   // defined as an internal software error.  Otherwise, exit with status 1.
-  exit(GenCrashDiag ? 70 : 1);
+  int RetCode = GenCrashDiag ? 70 : 1;
+
+  // When running inside the driver process, unwind back to the driver
+  // instead, so that it can clean up and report the failure.
+  if (llvm::CrashRecoveryContext *CRC =
+          llvm::CrashRecoveryContext::GetCurrent()) {
+    FatalErrorRetCode = RetCode;
+    CRC->HandleCrash();
+  }
+  exit(RetCode);
 }
 
 #ifdef LINK_POLLY_INTO_TOOLS
@@ -109,6 +123,13 @@ int cc1_main(const char **ArgBegin, const char **ArgEnd,
     return 1;
 
   // Execute the frontend actions.
+  //
+  // FIXME: Each invocation starts from scratch. Keeping a FileManager, loaded
+  // PCH/module files and target info alive across invocations would need a
+  // server process, plus a way to tell that stat results and ASTReader state
+  // from an earlier request are still valid. -disable-free and the lack of
+  // policing of global state (LLVM options, statistics) also assume one
+  // compilation per process.
   Success = ExecuteCompilerInvocation(Clang.get());
 
   // If any timers were active but haven't been destroyed yet, print their
@@ -134,3 +155,20 @@ int cc1_main(const char **ArgBegin, const char **ArgEnd,
 
   return !Success;
 }
+
+int cc1_main_in_process(const char **ArgBegin, const char **ArgEnd,
+                        const char *Argv0, void *MainAddr) {
+  llvm::CrashRecoveryContext::Enable();
+  llvm::CrashRecoveryContext CRC;
+  int Res = 1;
+  FatalErrorRetCode = 0;
+  if (CRC.RunSafely([&] { Res = cc1_main(ArgBegin, ArgEnd, Argv0, MainAddr); }))
+    return Res;
+
+  // The error handler refers to the abandoned compiler instance.
+  llvm::remove_fatal_error_handler();
+
+  // A crash is reported the same way a crashed subprocess would be, so that
+  // the driver still generates crash diagnostics for it.
+  return FatalErrorRetCode ? FatalErrorRetCode : -2;
+}
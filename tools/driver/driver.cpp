@@ -192,6 +192,16 @@ extern int cc1_main(const char **ArgBegin, const char **ArgEnd,
 extern int cc1as_main(const char **ArgBegin, const char **ArgEnd,
                       const char *Argv0, void *MainAddr);
 
+/// Like cc1_main, but returns to the caller on crashes and fatal errors.
+extern int cc1_main_in_process(const char **ArgBegin, const char **ArgEnd,
+                               const char *Argv0, void *MainAddr);
+
+/// Run a -cc1 job in the driver process, for -fintegrated-cc1.
+static int ExecuteCC1Tool(ArrayRef<const char *> Argv) {
+  return cc1_main_in_process(Argv.data() + 2, Argv.data() + Argv.size(),
+                             Argv[0], (void*) (intptr_t) GetExecutablePath);
+}
+
 static void ParseProgName(SmallVectorImpl<const char *> &ArgVector,
                           std::set<std::string> &SavedStrings,
                           Driver &TheDriver)
@@ -411,6 +421,8 @@ int main(int argc_, const char **argv_) {
   if (TheDriver.CCLogDiagnostics)
     TheDriver.CCLogDiagnosticsFilename = ::getenv("CC_LOG_DIAGNOSTICS_FILE");
 
+  TheDriver.CC1Main = &ExecuteCC1Tool;
+
   std::unique_ptr<Compilation> C(TheDriver.BuildCompilation(argv));
   int Res = 0;
   SmallVector<std::pair<int, const Command *>, 4> FailingCommands;
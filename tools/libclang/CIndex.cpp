@@ -61,6 +61,10 @@
 #include <pthread.h>
 #endif
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 using namespace clang;
 using namespace clang::cxcursor;
 using namespace clang::cxtu;
@@ -609,6 +613,12 @@ Optional<bool> CursorVisitor::shouldVisitCursor(CXCursor Cursor) {
 }
 
 bool CursorVisitor::VisitDeclContext(DeclContext *DC) {
+  // FIXME: With a region of interest, every member that ends before the
+  // region is still walked and compared here, so finding a cursor in a large
+  // class or namespace is linear in its size.  ASTUnit's FileDecls only index
+  // top-level decls; an index of nested decls (and statements) by file offset
+  // would let clang_getCursor and region visits seek directly to the first
+  // overlapping child instead.
   DeclContext::decl_iterator I = DC->decls_begin(), E = DC->decls_end();
 
   // FIXME: Eventually remove.  This part of a hack to support proper
@@ -3104,6 +3114,15 @@ void clang_disposeTranslationUnit(CXTranslationUnit CTUnit) {
     disposeOverridenCXCursorsPool(CTUnit->OverridenCursorsPool);
     delete CTUnit->CommentToXML;
     delete CTUnit;
+
+    // Long-running clients that create and dispose of many translation units
+    // can ask for the memory just freed to be handed back to the system, so
+    // that resident size does not keep the high-water mark of the largest AST.
+    if (getenv("LIBCLANG_TRIM_MEMORY")) {
+#ifdef __GLIBC__
+      malloc_trim(0);
+#endif
+    }
   }
 }
 
@@ -5367,6 +5386,10 @@ class AnnotateTokensWorker {
   SourceManager &SrcMgr;
   bool HasContextSensitiveKeywords;
 
+  /// \brief The raw encodings of the first and last locations of the file
+  /// that contains the tokens.
+  unsigned TokFileBegin, TokFileEnd;
+
   struct PostChildrenInfo {
     CXCursor Cursor;
     SourceRange CursorRange;
@@ -5396,6 +5419,8 @@ class AnnotateTokensWorker {
     return SourceLocation::getFromRawEncoding(getTok(tokI).int_data[3]);
   }
 
+  RangeComparisonResult compareTokenLoc(SourceLocation TokLoc,
+                                        SourceRange R) const;
   void annotateAndAdvanceTokens(CXCursor, RangeComparisonResult, SourceRange);
   bool annotateAndAdvanceFunctionMacroTokens(CXCursor, RangeComparisonResult,
                                              SourceRange);
@@ -5413,7 +5438,13 @@ public:
                   /*VisitDeclsOnly=*/false,
                   AnnotateTokensPostChildrenVisitor),
       SrcMgr(cxtu::getASTUnit(TU)->getSourceManager()),
-      HasContextSensitiveKeywords(false) { }
+      HasContextSensitiveKeywords(false), TokFileBegin(0), TokFileEnd(0) {
+    if (NumTokens) {
+      FileID FID = SrcMgr.getFileID(GetTokenLoc(0));
+      TokFileBegin = SrcMgr.getLocForStartOfFile(FID).getRawEncoding();
+      TokFileEnd = SrcMgr.getLocForEndOfFile(FID).getRawEncoding();
+    }
+  }
 
   void VisitChildren(CXCursor C) { AnnotateVis.VisitChildren(C); }
   enum CXChildVisitResult Visit(CXCursor cursor, CXCursor parent);
@@ -5438,6 +5469,31 @@ void AnnotateTokensWorker::AnnotateTokens() {
   AnnotateVis.visitFileRegion();
 }
 
+/// \brief Determine where a token location falls relative to a source range.
+///
+/// All tokens come from a single file, and most cursor ranges do too, so
+/// compare the raw offsets directly when both ends of the range are file
+/// locations inside the token file and only fall back to
+/// \c SourceManager::isBeforeInTranslationUnit otherwise.
+RangeComparisonResult
+AnnotateTokensWorker::compareTokenLoc(SourceLocation TokLoc,
+                                      SourceRange R) const {
+  unsigned Tok = TokLoc.getRawEncoding();
+  unsigned Begin = R.getBegin().getRawEncoding();
+  unsigned End = R.getEnd().getRawEncoding();
+  if (TokLoc.isFileID() && R.getBegin().isFileID() && R.getEnd().isFileID() &&
+      Tok >= TokFileBegin && Tok <= TokFileEnd &&
+      Begin >= TokFileBegin && Begin <= TokFileEnd &&
+      End >= TokFileBegin && End <= TokFileEnd) {
+    if (Tok < Begin)
+      return RangeBefore;
+    if (Tok > End)
+      return RangeAfter;
+    return RangeOverlap;
+  }
+  return LocationCompare(SrcMgr, TokLoc, R);
+}
+
 static inline void updateCursorAnnotation(CXCursor &Cursor,
                                           const CXCursor &updateC) {
   if (clang_isInvalid(updateC.kind) || !clang_isInvalid(Cursor.kind))
@@ -5461,7 +5517,7 @@ void AnnotateTokensWorker::annotateAndAdvanceTokens(CXCursor updateC,
         return;
 
     SourceLocation TokLoc = GetTokenLoc(I);
-    if (LocationCompare(SrcMgr, TokLoc, range) == compResult) {
+    if (compareTokenLoc(TokLoc, range) == compResult) {
       updateCursorAnnotation(Cursors[I], updateC);
       AdvanceToken();
       continue;
@@ -5495,7 +5551,7 @@ bool AnnotateTokensWorker::annotateAndAdvanceFunctionMacroTokens(
     SourceLocation TokLoc = getFunctionMacroTokenLoc(I);
     if (TokLoc.isFileID())
       continue; // not macro arg token, it's parens or comma.
-    if (LocationCompare(SrcMgr, TokLoc, range) == compResult) {
+    if (compareTokenLoc(TokLoc, range) == compResult) {
       if (clang_isInvalid(clang_getCursorKind(Cursors[I])))
         Cursors[I] = updateC;
     } else
@@ -5574,7 +5630,7 @@ AnnotateTokensWorker::Visit(CXCursor cursor, CXCursor parent) {
     while (MoreTokens()) {
       const unsigned I = NextToken();
       SourceLocation TokLoc = GetTokenLoc(I);
-      switch (LocationCompare(SrcMgr, TokLoc, cursorRange)) {
+      switch (compareTokenLoc(TokLoc, cursorRange)) {
       case RangeBefore:
         AdvanceToken();
         continue;
@@ -5589,7 +5645,7 @@ AnnotateTokensWorker::Visit(CXCursor cursor, CXCursor parent) {
     while (MoreTokens()) {
       const unsigned I = NextToken();
       SourceLocation TokLoc = GetTokenLoc(I);
-      switch (LocationCompare(SrcMgr, TokLoc, cursorRange)) {
+      switch (compareTokenLoc(TokLoc, cursorRange)) {
       case RangeBefore:
         llvm_unreachable("Infeasible");
       case RangeAfter:
@@ -6716,6 +6772,11 @@ const char *clang_getTUResourceUsageName(CXTUResourceUsageKind kind) {
   return str;
 }
 
+// FIXME: This only reports memory; nothing lets a client give it back short of
+// disposing the translation unit.  Dropping the ASTContext while keeping the
+// preamble and remapped buffers, and re-parsing lazily on the next query,
+// would need every CXCursor/CXType handed out for the TU to be invalidated,
+// since they point directly into the AST.
 CXTUResourceUsage clang_getCXTUResourceUsage(CXTranslationUnit TU) {
   if (isNotUsableTU(TU)) {
     LOG_BAD_TU(TU);
@@ -540,6 +540,13 @@ namespace {
                                     CodeCompletionResult *Results,
                                     unsigned NumResults) override {
       StoredResults.reserve(StoredResults.size() + NumResults);
+      // FIXME: Sema hands us lightweight results; this is where every one of
+      // them gets a full completion string, whether or not the client ever
+      // looks at it. Sema can't filter by the typed prefix, because clients
+      // complete at the start of the identifier, and CXCompletionString is
+      // handed out as a pointer to the built string. Building these lazily
+      // would need the results to keep the Sema and AST alive until the
+      // client asks.
       for (unsigned I = 0; I != NumResults; ++I) {
         CodeCompletionString *StoredCompletion        
           = Results[I].CreateCodeCompletionString(S, getAllocator(),
@@ -32,6 +32,14 @@ namespace clang {
   class Token;
   class IdentifierInfo;
 
+/// \brief The state behind a CXIndex.
+///
+/// A CIndexer is shared by every translation unit created from its CXIndex.
+/// It is only read while parsing, so translation units from the same index
+/// may be parsed, reparsed and queried on different threads concurrently, as
+/// long as no thread uses a given CXTranslationUnit while another does and
+/// the options are not changed with clang_CXIndex_setGlobalOptions while any
+/// of them is in use.
 class CIndexer {
   bool OnlyLocalDecls;
   bool DisplayDiagnostics;
@@ -75,6 +83,11 @@ public:
   /// \brief Execution the given code "safely", using crash recovery or safety
   /// threads when possible.
   ///
+  /// FIXME: Each call with a non-zero stack size spawns and joins a fresh
+  /// thread.  A per-CIndexer pool of safety threads with preallocated stacks
+  /// would avoid that for clients that reparse many files, but
+  /// CrashRecoveryContext can only run code on a thread it creates itself.
+  ///
   /// \return False if a crash was detected.
   bool RunSafely(llvm::CrashRecoveryContext &CRC,
                  void (*Fn)(void*), void *UserData, unsigned Size = 0);
@@ -27,6 +27,7 @@
 #include "clang/Lex/PPConditionalDirectiveRecord.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/SemaConsumer.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Mutex.h"
@@ -128,13 +129,9 @@ namespace llvm {
     }
 
     static unsigned getHashValue(const PPRegion &S) {
-      llvm::FoldingSetNodeID ID;
       const llvm::sys::fs::UniqueID &UniqueID = S.getUniqueID();
-      ID.AddInteger(UniqueID.getFile());
-      ID.AddInteger(UniqueID.getDevice());
-      ID.AddInteger(S.getOffset());
-      ID.AddInteger(S.getModTime());
-      return ID.ComputeHash();
+      return llvm::hash_combine(UniqueID.getFile(), UniqueID.getDevice(),
+                                S.getOffset(), S.getModTime());
     }
 
     static bool isEqual(const PPRegion &LHS, const PPRegion &RHS) {
@@ -155,9 +152,9 @@ public:
     //llvm::errs() << "RegionData: " << Skipped.size() << " - " << Skipped.getMemorySize() << "\n";
   }
 
-  void copyTo(PPRegionSetTy &Set) {
+  bool isParsed(const PPRegion &Region) {
     llvm::MutexGuard MG(Mux);
-    Set = ParsedRegions;
+    return ParsedRegions.count(Region);
   }
 
   void update(ArrayRef<PPRegion> Regions) {
@@ -171,7 +168,6 @@ class TUSkipBodyControl {
   PPConditionalDirectiveRecord &PPRec;
   Preprocessor &PP;
 
-  PPRegionSetTy ParsedRegions;
   SmallVector<PPRegion, 32> NewParsedRegions;
   PPRegion LastRegion;
   bool LastIsParsed;
@@ -180,9 +176,7 @@ public:
   TUSkipBodyControl(SessionSkipBodyData &sessionData,
                     PPConditionalDirectiveRecord &ppRec,
                     Preprocessor &pp)
-    : SessionData(sessionData), PPRec(ppRec), PP(pp) {
-    SessionData.copyTo(ParsedRegions);
-  }
+    : SessionData(sessionData), PPRec(ppRec), PP(pp) {}
 
   bool isParsed(SourceLocation Loc, FileID FID, const FileEntry *FE) {
     PPRegion region = getRegion(Loc, FID, FE);
@@ -194,7 +188,7 @@ public:
       return LastIsParsed;
 
     LastRegion = region;
-    LastIsParsed = ParsedRegions.count(region);
+    LastIsParsed = SessionData.isParsed(region);
     if (!LastIsParsed)
       NewParsedRegions.push_back(region);
     return LastIsParsed;
@@ -270,6 +270,14 @@ public:
   }
 };
 
+/// FIXME: Every entity and reference is reported through its own
+/// IndexerCallbacks call, with names, USRs and attribute lists materialized
+/// in StrScratch.  Clients behind an FFI layer pay a marshalling cost per
+/// callback.  A batch mode would need a new public entry point in Index.h.
+/// It could append fixed-size records carrying the USR hash
+/// (index::generateUSRHashForDecl), kind, location and role to a
+/// client-provided buffer, bypassing EntityInfo and the scratch strings
+/// entirely.
 class IndexingContext {
   ASTContext *Ctx;
   CXClientData ClientData;
@@ -13,8 +13,10 @@
 
 #include "clang/AST/ASTContext.h"
 #include "MatchVerifier.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
 #include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Frontend/ASTUnit.h"
 #include "clang/Tooling/Tooling.h"
 #include "gtest/gtest.h"
 
@@ -67,5 +69,25 @@ TEST(GetParents, ReturnsMultipleParentsInTemplateInstantiations) {
                 hasAncestor(recordDecl(unless(isTemplateInstantiation())))))));
 }
 
+TEST(GetParents, PrecomputedForConcurrentReads) {
+  std::unique_ptr<ASTUnit> AST = tooling::buildASTFromCode(
+      "struct S { int x; };"
+      "template<typename T> struct C { T t; };"
+      "C<S> c;");
+  ASSERT_TRUE(AST.get());
+  ASTContext &Ctx = AST->getASTContext();
+  Ctx.prepareForConcurrentReads();
+
+  auto Results =
+      match(decl(forEachDescendant(fieldDecl(hasName("x")).bind("x"))),
+            *Ctx.getTranslationUnitDecl(), Ctx);
+  ASSERT_EQ(1u, Results.size());
+  const FieldDecl *X = Results[0].getNodeAs<FieldDecl>("x");
+  ArrayRef<ast_type_traits::DynTypedNode> Parents = Ctx.getParents(*X);
+  ASSERT_EQ(1u, Parents.size());
+  EXPECT_TRUE(Parents[0].get<RecordDecl>() != nullptr);
+  EXPECT_EQ(4, Ctx.getASTRecordLayout(X->getParent()).getSize().getQuantity());
+}
+
 } // end namespace ast_matchers
 } // end namespace clang
@@ -2260,6 +2260,8 @@ TEST(Matcher, HasNameSupportsNamespaces) {
               recordDecl(hasName("a+b::C"))));
   EXPECT_TRUE(notMatches("namespace a { namespace b { class AC; } }",
               recordDecl(hasName("C"))));
+  EXPECT_TRUE(notMatches("namespace a { namespace ab { class C; } }",
+              recordDecl(hasName("b::C"))));
 }
 
 TEST(Matcher, HasNameSupportsOuterClasses) {
@@ -10,8 +10,10 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/FileSystemOptions.h"
 #include "clang/Basic/FileSystemStatCache.h"
+#include "clang/Basic/VirtualFileSystem.h"
 #include "gtest/gtest.h"
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Support/FileSystem.h"
 
 using namespace llvm;
 using namespace clang;
@@ -63,6 +65,27 @@ public:
   }
 };
 
+// Reports a single VFS-mapped directory the way the end of the stat cache
+// chain does: a lookup for a file fails when the path is a directory.
+class DirectoryOnlyStatCache : public FileSystemStatCache {
+  std::string DirPath;
+
+public:
+  explicit DirectoryOnlyStatCache(StringRef DirPath) : DirPath(DirPath) {}
+
+  LookupResult getStat(const char *Path, FileData &Data, bool isFile,
+                       std::unique_ptr<vfs::File> *F,
+                       vfs::FileSystem &FS) override {
+    if (isFile || DirPath != Path)
+      return CacheMissing;
+    Data.Name = Path;
+    Data.UniqueID = llvm::sys::fs::UniqueID(1, 7);
+    Data.IsDirectory = true;
+    Data.IsVFSMapped = true;
+    return CacheExists;
+  }
+};
+
 // The test fixture.
 class FileManagerTest : public ::testing::Test {
  protected:
@@ -236,6 +259,89 @@ TEST_F(FileManagerTest, getFileReturnsSameFileEntryForAliasedVirtualFiles) {
   EXPECT_EQ(manager.getFile("abc/foo.cpp"), manager.getFile("abc/bar.cpp"));
 }
 
+// A PersistentStatCache remembers both hits and misses across a save/load
+// round trip, but only for the epoch it was saved with.
+TEST_F(FileManagerTest, persistentStatCacheRoundTrip) {
+  SmallString<128> CachePath;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("stat-cache", "txt",
+                                                  CachePath));
+
+  {
+    FakeStatCache *statCache = new FakeStatCache;
+    statCache->InjectDirectory("/abc", 41);
+    statCache->InjectFile("/abc/foo.cpp", 42);
+    PersistentStatCache *persistentCache =
+        PersistentStatCache::load(CachePath, "epoch-1");
+    EXPECT_EQ(0U, persistentCache->size());
+    persistentCache->setNextStatCache(statCache);
+
+    FileManager firstManager(options);
+    firstManager.addStatCache(persistentCache);
+    EXPECT_NE(nullptr, firstManager.getFile("/abc/foo.cpp"));
+    EXPECT_EQ(nullptr, firstManager.getFile("/abc/missing.h"));
+    EXPECT_TRUE(persistentCache->isDirty());
+
+    std::string ErrorStr;
+    EXPECT_FALSE(persistentCache->save(CachePath, ErrorStr));
+  }
+
+  // Nothing exists any more, but the saved results are used.
+  FileManager secondManager(options);
+  PersistentStatCache *persistentCache =
+      PersistentStatCache::load(CachePath, "epoch-1");
+  persistentCache->setNextStatCache(new FakeStatCache);
+  secondManager.addStatCache(persistentCache);
+  const FileEntry *file = secondManager.getFile("/abc/foo.cpp");
+  ASSERT_NE(nullptr, file);
+  EXPECT_EQ(llvm::sys::fs::UniqueID(1, 42), file->getUniqueID());
+  EXPECT_EQ(nullptr, secondManager.getFile("/abc/missing.h"));
+  EXPECT_FALSE(persistentCache->isDirty());
+
+  // A different epoch invalidates everything.
+  std::unique_ptr<PersistentStatCache> staleCache(
+      PersistentStatCache::load(CachePath, "epoch-2"));
+  EXPECT_EQ(0U, staleCache->size());
+
+  llvm::sys::fs::remove(CachePath.str());
+}
+
+// A failed file lookup of a directory must not hide the directory from later
+// directory lookups, and the VFS mapping of an entry survives a save/load.
+TEST_F(FileManagerTest, persistentStatCacheKeepsEntryKinds) {
+  SmallString<128> CachePath;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("stat-cache", "txt",
+                                                  CachePath));
+  IntrusiveRefCntPtr<vfs::FileSystem> FS = vfs::getRealFileSystem();
+  FileData Data;
+
+  {
+    std::unique_ptr<PersistentStatCache> persistentCache(
+        PersistentStatCache::load(CachePath, "epoch-1"));
+    persistentCache->setNextStatCache(new DirectoryOnlyStatCache("/dir"));
+    EXPECT_TRUE(FileSystemStatCache::get("/dir", Data, /*isFile=*/true,
+                                         nullptr, persistentCache.get(), *FS));
+    EXPECT_FALSE(FileSystemStatCache::get("/dir", Data, /*isFile=*/false,
+                                          nullptr, persistentCache.get(), *FS));
+
+    std::string ErrorStr;
+    EXPECT_FALSE(persistentCache->save(CachePath, ErrorStr));
+  }
+
+  std::unique_ptr<PersistentStatCache> persistentCache(
+      PersistentStatCache::load(CachePath, "epoch-1"));
+  persistentCache->setNextStatCache(new FakeStatCache);
+  EXPECT_TRUE(FileSystemStatCache::get("/dir", Data, /*isFile=*/true, nullptr,
+                                       persistentCache.get(), *FS));
+  Data = FileData();
+  EXPECT_FALSE(FileSystemStatCache::get("/dir", Data, /*isFile=*/false,
+                                        nullptr, persistentCache.get(), *FS));
+  EXPECT_TRUE(Data.IsDirectory);
+  EXPECT_TRUE(Data.IsVFSMapped);
+  EXPECT_FALSE(persistentCache->isDirty());
+
+  llvm::sys::fs::remove(CachePath.str());
+}
+
 #endif  // !LLVM_ON_WIN32
 
 } // anonymous namespace
@@ -171,6 +171,73 @@ TEST_F(SourceManagerTest, getColumnNumber) {
   EXPECT_EQ(1U, SourceMgr.getColumnNumber(MainFileID, 0, nullptr));
 }
 
+TEST_F(SourceManagerTest, getLineNumberWithMixedLineEndings) {
+  // Lines of varying length, so that line endings land at every position in
+  // a 16 byte chunk, followed by some DOS and old Mac line endings.
+  std::string Source;
+  std::vector<unsigned> LineStarts;
+  for (unsigned I = 0; I != 100; ++I) {
+    LineStarts.push_back(Source.size());
+    Source += std::string(I % 23, 'x');
+    Source += '\n';
+  }
+  const char *Endings[] = { "\r\n", "\n\r", "\r", "\n", "\r\n" };
+  for (unsigned I = 0; I != 100; ++I) {
+    LineStarts.push_back(Source.size());
+    Source += std::string(I % 17, 'y');
+    Source += Endings[I % 5];
+  }
+  LineStarts.push_back(Source.size());
+  Source += "z";
+
+  MemoryBuffer *Buf = MemoryBuffer::getMemBuffer(Source);
+  FileID MainFileID = SourceMgr.createFileID(Buf);
+  SourceMgr.setMainFileID(MainFileID);
+
+  for (unsigned I = 0, E = LineStarts.size(); I != E; ++I) {
+    bool Invalid = false;
+    EXPECT_EQ(I + 1, SourceMgr.getLineNumber(MainFileID, LineStarts[I],
+                                             &Invalid));
+    EXPECT_FALSE(Invalid);
+    EXPECT_EQ(1U, SourceMgr.getColumnNumber(MainFileID, LineStarts[I]));
+  }
+}
+
+TEST_F(SourceManagerTest, getFileIDWithManyExpansions) {
+  MemoryBuffer *Buf = MemoryBuffer::getMemBuffer("int x;\n");
+  FileID MainFileID = SourceMgr.createFileID(Buf);
+  SourceMgr.setMainFileID(MainFileID);
+  SourceLocation FileLoc = SourceMgr.getLocForStartOfFile(MainFileID);
+
+  // Interleave many macro expansions with a few files so that lookups have
+  // to fall back to the binary search.
+  std::vector<SourceLocation> ExpansionLocs;
+  std::vector<FileID> FileIDs;
+  for (unsigned I = 0; I != 2000; ++I) {
+    ExpansionLocs.push_back(SourceMgr.createExpansionLoc(
+        FileLoc, FileLoc, FileLoc, /*TokLength=*/I % 7 + 1));
+    if (I % 500 == 0)
+      FileIDs.push_back(SourceMgr.createFileID(
+          MemoryBuffer::getMemBuffer("int y;\n"), SourceLocation(),
+          SrcMgr::C_User));
+  }
+
+  // Look them up back to front to defeat the linear scan.
+  for (unsigned I = ExpansionLocs.size(); I != 0; --I) {
+    SourceLocation Loc = ExpansionLocs[I - 1];
+    FileID FID = SourceMgr.getFileID(Loc);
+    EXPECT_TRUE(SourceMgr.getSLocEntry(FID).isExpansion());
+    EXPECT_EQ(Loc.getOffset(), SourceMgr.getSLocEntry(FID).getOffset());
+    EXPECT_EQ(FID, SourceMgr.getFileID(Loc.getLocWithOffset((I - 1) % 7)));
+  }
+
+  for (unsigned I = 0, E = FileIDs.size(); I != E; ++I) {
+    SourceLocation Loc = SourceMgr.getLocForStartOfFile(FileIDs[I]);
+    EXPECT_EQ(FileIDs[I], SourceMgr.getFileID(Loc.getLocWithOffset(3)));
+  }
+  EXPECT_EQ(MainFileID, SourceMgr.getFileID(FileLoc.getLocWithOffset(2)));
+}
+
 #if defined(LLVM_ON_UNIX)
 
 TEST_F(SourceManagerTest, getMacroArgExpandedLocation) {
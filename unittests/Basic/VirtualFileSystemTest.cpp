@@ -354,6 +354,41 @@ TEST(VirtualFileSystemTest, BasicRealFSRecursiveIteration) {
   EXPECT_EQ(1, Counts[3]); // d
 }
 
+TEST(VirtualFileSystemTest, CachingFSSharesContents) {
+  ScopedDir TestDirectory("virtual-file-system-test", /*Unique*/true);
+  SmallString<128> FilePath(TestDirectory.Path);
+  llvm::sys::path::append(FilePath, "header.h");
+  {
+    std::string Err;
+    raw_fd_ostream OS(FilePath.c_str(), Err, llvm::sys::fs::F_Text);
+    ASSERT_TRUE(Err.empty());
+    OS << "int x;\n";
+  }
+
+  IntrusiveRefCntPtr<vfs::CachingFileSystem> FS(
+      new vfs::CachingFileSystem(vfs::getRealFileSystem()));
+
+  std::unique_ptr<MemoryBuffer> First, Second, Volatile;
+  ASSERT_FALSE(FS->getBufferForFile(FilePath.str(), First));
+  ASSERT_FALSE(FS->getBufferForFile(FilePath.str(), Second));
+  ASSERT_FALSE(FS->getBufferForFile(FilePath.str(), Volatile, -1,
+                                    /*RequiresNullTerminator=*/true,
+                                    /*IsVolatile=*/true));
+  EXPECT_EQ("int x;\n", First->getBuffer());
+  EXPECT_EQ(First->getBufferStart(), Second->getBufferStart());
+  EXPECT_NE(First->getBufferStart(), Volatile->getBufferStart());
+  EXPECT_EQ(1U, FS->getNumCachedFiles());
+  EXPECT_EQ(1U, FS->getNumMisses());
+  EXPECT_EQ(1U, FS->getNumHits());
+
+  First.reset();
+  Second.reset();
+  Volatile.reset();
+  FS->clearCache();
+  EXPECT_EQ(0U, FS->getNumCachedFiles());
+  EXPECT_FALSE(llvm::sys::fs::remove(FilePath.str()));
+}
+
 template <typename T, size_t N>
 std::vector<StringRef> makeStringRefVector(const T (&Arr)[N]) {
   std::vector<StringRef> Vec;
@@ -649,6 +684,41 @@ TEST_F(VFSFromYAMLTest, CaseInsensitive) {
   EXPECT_EQ(0, NumDiagnostics);
 }
 
+TEST_F(VFSFromYAMLTest, DuplicateDirectoryNames) {
+  IntrusiveRefCntPtr<DummyFileSystem> Lower(new DummyFileSystem());
+  Lower->addRegularFile("//root/foo/a");
+  Lower->addRegularFile("//root/foo/b");
+  IntrusiveRefCntPtr<vfs::FileSystem> FS =
+      getFromYAMLString("{ 'roots': [\n"
+                        "{\n"
+                        "  'type': 'directory',\n"
+                        "  'name': '//root/',\n"
+                        "  'contents': [\n"
+                        "    { 'type': 'directory', 'name': 'dir',\n"
+                        "      'contents': [ { 'type': 'file', 'name': 'a',\n"
+                        "        'external-contents': '//root/foo/a' } ] },\n"
+                        "    { 'type': 'directory', 'name': 'dir',\n"
+                        "      'contents': [ { 'type': 'file', 'name': 'b',\n"
+                        "        'external-contents': '//root/foo/b' } ] }\n"
+                        "  ]\n"
+                        "}]}",
+                        Lower);
+  ASSERT_TRUE(FS.get() != nullptr);
+
+  // Both same-named directories are searched, in order.
+  ErrorOr<vfs::Status> S = FS->status("//root/dir/a");
+  ASSERT_FALSE(S.getError());
+  EXPECT_EQ("//root/foo/a", S->getName());
+  S = FS->status("//root/dir/b");
+  ASSERT_FALSE(S.getError());
+  EXPECT_EQ("//root/foo/b", S->getName());
+  S = FS->status("//root/./dir/b");
+  ASSERT_FALSE(S.getError());
+  EXPECT_EQ(FS->status("//root/dir/c").getError(),
+            llvm::errc::no_such_file_or_directory);
+  EXPECT_EQ(0, NumDiagnostics);
+}
+
 TEST_F(VFSFromYAMLTest, CaseSensitive) {
   IntrusiveRefCntPtr<DummyFileSystem> Lower(new DummyFileSystem());
   Lower->addRegularFile("//root/foo/bar/a");
@@ -100,4 +100,44 @@ TEST(ASTFrontendAction, IncrementalParsing) {
   EXPECT_EQ("x", test_action.decl_names[1]);
 }
 
+/// Parse \p Code as C++, with or without optimization, and return the names
+/// of the declarations in it.
+std::vector<std::string> parseWithOptimize(const char *Code,
+                                           bool Optimize) {
+  CompilerInvocation *invocation = new CompilerInvocation;
+  invocation->getPreprocessorOpts().addRemappedFile(
+    "test.cc", MemoryBuffer::getMemBuffer(Code));
+  invocation->getFrontendOpts().Inputs.push_back(FrontendInputFile("test.cc",
+                                                                   IK_CXX));
+  invocation->getFrontendOpts().ProgramAction = frontend::ParseSyntaxOnly;
+  invocation->getTargetOpts().Triple = "i386-unknown-linux-gnu";
+  invocation->getLangOpts()->Optimize = Optimize;
+  CompilerInstance compiler;
+  compiler.setInvocation(invocation);
+  compiler.createDiagnostics();
+
+  TestASTFrontendAction test_action;
+  EXPECT_TRUE(compiler.ExecuteAction(test_action));
+  return test_action.decl_names;
+}
+
+TEST(ASTFrontendAction, BuiltinPredefinesFollowOptions) {
+  // The builtin predefines are cached per process; invocations with different
+  // options must still see their own.
+  const char *Code = "#ifdef __OPTIMIZE__\n"
+                     "int optimized;\n"
+                     "#else\n"
+                     "int unoptimized;\n"
+                     "#endif\n";
+  for (unsigned Round = 0; Round != 2; ++Round) {
+    std::vector<std::string> Names = parseWithOptimize(Code, false);
+    ASSERT_EQ(1U, Names.size());
+    EXPECT_EQ("unoptimized", Names[0]);
+
+    Names = parseWithOptimize(Code, true);
+    ASSERT_EQ(1U, Names.size());
+    EXPECT_EQ("optimized", Names[0]);
+  }
+}
+
 } // anonymous namespace
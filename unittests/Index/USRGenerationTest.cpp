@@ -0,0 +1,79 @@
+//===- unittests/Index/USRGenerationTest.cpp - USR generation tests -------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Index/USRGeneration.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MD5.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+using namespace clang::ast_matchers;
+
+namespace {
+
+/// \brief Find the declarations of the function named \p Name.
+SmallVector<const FunctionDecl *, 2> findFunctions(ASTContext &Context,
+                                                  StringRef Name) {
+  SmallVector<BoundNodes, 1> Results =
+      match(decl(forEachDescendant(functionDecl(hasName(Name)).bind("fn"))),
+            *Context.getTranslationUnitDecl(), Context);
+  SmallVector<const FunctionDecl *, 2> Decls;
+  for (unsigned I = 0, E = Results.size(); I != E; ++I)
+    Decls.push_back(Results[I].getNodeAs<FunctionDecl>("fn"));
+  return Decls;
+}
+
+TEST(USRGeneration, HashIsLowHalfOfMD5) {
+  std::unique_ptr<ASTUnit> AST =
+      tooling::buildASTFromCode("namespace ns { int f(int); }");
+  ASSERT_TRUE(AST.get());
+  SmallVector<const FunctionDecl *, 2> Decls =
+      findFunctions(AST->getASTContext(), "ns::f");
+  ASSERT_EQ(1U, Decls.size());
+
+  SmallString<128> USR;
+  ASSERT_FALSE(index::generateUSRForDecl(Decls[0], USR));
+  llvm::MD5 MD5;
+  MD5.update(USR.str());
+  llvm::MD5::MD5Result Result;
+  MD5.final(Result);
+  using namespace llvm::support;
+  uint64_t Expected = endian::read<uint64_t, little, unaligned>(Result);
+
+  uint64_t Hash;
+  ASSERT_FALSE(index::generateUSRHashForDecl(Decls[0], Hash));
+  EXPECT_EQ(Expected, Hash);
+}
+
+TEST(USRGeneration, HashIsSharedByRedeclarations) {
+  std::unique_ptr<ASTUnit> AST = tooling::buildASTFromCode(
+      "int f(int); int f(int x) { return x; } int g(int);");
+  ASSERT_TRUE(AST.get());
+  SmallVector<const FunctionDecl *, 2> Fs =
+      findFunctions(AST->getASTContext(), "f");
+  SmallVector<const FunctionDecl *, 2> Gs =
+      findFunctions(AST->getASTContext(), "g");
+  ASSERT_EQ(2U, Fs.size());
+  ASSERT_EQ(1U, Gs.size());
+
+  uint64_t FirstHash, SecondHash, OtherHash;
+  ASSERT_FALSE(index::generateUSRHashForDecl(Fs[0], FirstHash));
+  ASSERT_FALSE(index::generateUSRHashForDecl(Fs[1], SecondHash));
+  ASSERT_FALSE(index::generateUSRHashForDecl(Gs[0], OtherHash));
+  EXPECT_EQ(FirstHash, SecondHash);
+  EXPECT_NE(FirstHash, OtherHash);
+}
+
+} // end anonymous namespace
@@ -359,4 +359,25 @@ TEST_F(LexerTest, LexAPI) {
   EXPECT_EQ("N", Lexer::getImmediateMacroName(idLoc4, SourceMgr, LangOpts));
 }
 
+TEST_F(LexerTest, LongIdentifiersAndWhitespace) {
+  std::vector<tok::TokenKind> ExpectedTokens;
+  ExpectedTokens.push_back(tok::identifier);
+  ExpectedTokens.push_back(tok::identifier);
+  ExpectedTokens.push_back(tok::semi);
+
+  std::vector<Token> toks =
+      CheckLex("abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789"
+               "                                   \t\t\t\t\t\t\t\t\t"
+               "identifier_with_an_escaped_\\\nnewline"
+               "\n                                        ;",
+               ExpectedTokens);
+
+  EXPECT_EQ(64U, toks[0].getLength());
+  EXPECT_EQ(36U, toks[1].getLength());
+  EXPECT_TRUE(toks[1].hasLeadingSpace());
+  EXPECT_TRUE(toks[1].needsCleaning());
+  EXPECT_TRUE(toks[2].isAtStartOfLine());
+  EXPECT_TRUE(toks[2].hasLeadingSpace());
+}
+
 } // anonymous namespace
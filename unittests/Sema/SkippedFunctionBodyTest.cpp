@@ -0,0 +1,104 @@
+//=== unittests/Sema/SkippedFunctionBodyTest.cpp - On-demand body parsing ===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/AST/Stmt.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/FrontendAction.h"
+#include "clang/Sema/Sema.h"
+#include "clang/Sema/SemaConsumer.h"
+#include "clang/Tooling/Tooling.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+
+namespace {
+
+// \brief Asks Sema for the bodies of the functions named "wanted" as they are
+// handed to the consumer, and records which functions end up with a body.
+//
+// The results are written to vectors owned by the test, since the consumer
+// is destroyed along with the compiler instance when the tool finishes.
+class BodyRequester : public SemaConsumer {
+  Sema *S;
+  std::vector<bool> &Requested;
+  std::vector<std::string> &WithBody;
+
+public:
+  BodyRequester(std::vector<bool> &Requested,
+                std::vector<std::string> &WithBody)
+      : S(nullptr), Requested(Requested), WithBody(WithBody) {}
+
+  virtual void InitializeSema(Sema &Actions) { S = &Actions; }
+  virtual void ForgetSema() { S = nullptr; }
+
+  virtual bool HandleTopLevelDecl(DeclGroupRef DG) {
+    for (DeclGroupRef::iterator I = DG.begin(), E = DG.end(); I != E; ++I)
+      visit(*I);
+    return true;
+  }
+
+  void visit(Decl *D) {
+    if (NamespaceDecl *NS = dyn_cast<NamespaceDecl>(D)) {
+      for (auto *Child : NS->decls())
+        visit(Child);
+      return;
+    }
+    FunctionDecl *FD = dyn_cast<FunctionDecl>(D);
+    if (!FD || (!FD->isThisDeclarationADefinition() && !FD->hasSkippedBody()))
+      return;
+    if (FD->getName() == "wanted")
+      Requested.push_back(S->ParseSkippedFunctionBody(FD));
+    if (FD->hasBody())
+      WithBody.push_back(FD->getQualifiedNameAsString());
+  }
+};
+
+class SkipBodiesAction : public ASTFrontendAction {
+  std::vector<bool> &Requested;
+  std::vector<std::string> &WithBody;
+
+public:
+  SkipBodiesAction(std::vector<bool> &Requested,
+                   std::vector<std::string> &WithBody)
+      : Requested(Requested), WithBody(WithBody) {}
+
+protected:
+  virtual ASTConsumer *CreateASTConsumer(CompilerInstance &CI, StringRef) {
+    return new BodyRequester(Requested, WithBody);
+  }
+
+  virtual void ExecuteAction() {
+    CompilerInstance &CI = getCompilerInstance();
+    CI.getFrontendOpts().SkipFunctionBodies = true;
+    if (!CI.hasSema())
+      CI.createSema(getTranslationUnitKind(), nullptr);
+    CI.getSema().RetainSkippedFunctionBodies = true;
+    ASTFrontendAction::ExecuteAction();
+  }
+};
+
+TEST(SkippedFunctionBody, ParsedOnDemand) {
+  std::vector<bool> Requested;
+  std::vector<std::string> WithBody;
+  bool Ran = tooling::runToolOnCode(new SkipBodiesAction(Requested, WithBody),
+      "int skipped() { return 1; }\n"
+      "namespace N { int helper(int x) { return x; }\n"
+      "              int wanted(int y) { return helper(y) + 2; } }\n"
+      "int after() { return N::wanted(3); }\n");
+  ASSERT_TRUE(Ran);
+
+  ASSERT_EQ(1u, Requested.size());
+  EXPECT_TRUE(Requested[0]);
+  ASSERT_EQ(1u, WithBody.size());
+  EXPECT_EQ("N::wanted", WithBody[0]);
+}
+
+} // anonymous namespace
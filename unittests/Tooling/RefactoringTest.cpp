@@ -166,6 +166,20 @@ TEST_F(ReplacementTest, ApplyAllFailsIfOneApplyFails) {
   EXPECT_EQ("z", Context.getRewrittenText(IDz));
 }
 
+TEST(ApplyAllReplacementsTest, AppliesToString) {
+  Replacements Replaces;
+  Replaces.insert(Replacement("", 0, 0, "// "));
+  Replaces.insert(Replacement("", 4, 3, " "));
+  Replaces.insert(Replacement("", 9, 0, "\n"));
+  EXPECT_EQ("//  int i;\n", applyAllReplacements(" int   i;", Replaces));
+}
+
+TEST(ApplyAllReplacementsTest, FailsForReplacementsPastTheEnd) {
+  Replacements Replaces;
+  Replaces.insert(Replacement("", 2, 3, "a"));
+  EXPECT_EQ("", applyAllReplacements("0123", Replaces));
+}
+
 TEST(ShiftedCodePositionTest, FindsNewCodePosition) {
   Replacements Replaces;
   Replaces.insert(Replacement("", 0, 1, ""));
@@ -34,4 +34,18 @@ TEST(Rewriter, ContinuesOverwritingFilesOnError) {
             Context.getFileContentFromDisk("working.cpp")); 
 }
 
+TEST(Rewriter, RemovesLineIfEmpty) {
+  RewriterTestContext Context;
+  FileID ID = Context.createInMemoryFile(
+      "input.cpp", "line1\n  int x;\nline3\n  int y;\n");
+  Rewriter::RewriteOptions Opts;
+  Opts.RemoveLineIfEmpty = true;
+  // Split the rope into several pieces before removing.
+  Context.Rewrite.InsertText(Context.getLocation(ID, 1, 1), "// ");
+  Context.Rewrite.InsertText(Context.getLocation(ID, 2, 3), "  ");
+  Context.Rewrite.RemoveText(Context.getLocation(ID, 2, 3), 6, Opts);
+  Context.Rewrite.RemoveText(Context.getLocation(ID, 4, 7), 1, Opts);
+  EXPECT_EQ("// line1\nline3\n  int ;\n", Context.getRewrittenText(ID));
+}
+
 } // end namespace clang